@@ -0,0 +1,63 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+
+namespace mxml {
+namespace benchmarks {
+
+struct Benchmark {
+    const char* name;
+    std::function<void ()> body;
+};
+
+inline std::vector<Benchmark>& registry() {
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+struct Registrar {
+    Registrar(const char* name, std::function<void ()> body) {
+        registry().push_back(Benchmark{name, body});
+    }
+};
+
+/**
+ Run `f` the given number of times and print the average time per iteration.
+ */
+inline void measure(const std::string& label, std::size_t iterations, const std::function<void ()>& f) {
+    f(); // Warm up
+
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; i += 1)
+        f();
+    const auto end = std::chrono::steady_clock::now();
+
+    const auto total = std::chrono::duration<double, std::micro>(end - start).count();
+    std::printf("  %-40s %12.2f us\n", label.c_str(), total / iterations);
+}
+
+/**
+ Prevent the compiler from optimizing away a computed value.
+ */
+template <typename T>
+inline void keep(const T& value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+} // namespace benchmarks
+} // namespace mxml
+
+#define MXML_BENCHMARK(name) \
+    static void name(); \
+    static mxml::benchmarks::Registrar name##Registrar(#name, &name); \
+    static void name()
@@ -0,0 +1,98 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Benchmark.h"
+
+#include <mxml/EventFactory.h>
+#include <mxml/Parse.h>
+#include <mxml/ScoreProperties.h>
+#include <mxml/parsing/PartScanner.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+using namespace mxml;
+using namespace mxml::benchmarks;
+
+static const char* kMoonlightFileName = "moonlight.xml";
+
+MXML_BENCHMARK(buildEvents) {
+    auto score = parseFile(kMoonlightFileName);
+    ScoreProperties properties(*score);
+
+    std::size_t eventCount = 0;
+    measure("EventFactory::build", 100, [&]() {
+        EventFactory factory(*score, properties);
+        auto events = factory.build();
+        eventCount = events->events().size();
+        keep(events);
+    });
+    std::printf("  %zu events\n", eventCount);
+
+    measure("EventFactory::buildCursor and walk", 100, [&]() {
+        EventFactory factory(*score, properties);
+        auto cursor = factory.buildCursor();
+        double wallTime = 0;
+        for (; !cursor->atEnd(); cursor->next())
+            wallTime = cursor->event().wallTime();
+        keep(wallTime);
+    });
+}
+
+MXML_BENCHMARK(assembleEvents) {
+    auto score = parseFile(kMoonlightFileName);
+    ScoreProperties properties(*score);
+    EventFactory factory(*score, properties);
+    auto events = factory.build();
+
+    measure("EventSequence::addEvent", 100, [&]() {
+        EventSequence sequence(properties);
+        for (auto& event : events->events())
+            sequence.addEvent(event);
+        keep(sequence);
+    });
+    measure("EventSequence::Builder", 100, [&]() {
+        EventSequence::Builder builder(properties);
+        builder.reserve(events->events().size());
+        for (auto& event : events->events())
+            builder.add(event);
+        auto sequence = builder.finish();
+        keep(sequence);
+    });
+}
+
+MXML_BENCHMARK(buildEventsParallel) {
+    // Orchestral sized score made of copies of the moonlight part
+    std::ifstream is(kMoonlightFileName);
+    std::stringstream ss;
+    ss << is.rdbuf();
+    const auto contents = ss.str();
+    parsing::PartScanner scanner;
+    if (!scanner.scan(contents.data(), contents.size()) || scanner.parts().empty())
+        return;
+
+    const auto& range = scanner.parts().front();
+    auto xml = contents.substr(0, range.begin);
+    for (int index = 0; index < 32; index += 1)
+        xml += contents.substr(range.begin, range.end - range.begin);
+    xml += contents.substr(range.end);
+
+    auto score = parseBuffer(xml.data(), xml.size(), kMoonlightFileName);
+    ScoreProperties properties(*score);
+
+    measure("32 parts, 1 thread", 10, [&]() {
+        EventFactory factory(*score, properties);
+        auto events = factory.build();
+        keep(events);
+    });
+    measure("32 parts, 4 threads", 10, [&]() {
+        EventFactory factory(*score, properties);
+        factory.setThreads(4);
+        auto events = factory.build();
+        keep(events);
+    });
+}
@@ -0,0 +1,114 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Benchmark.h"
+
+#include <lxml/lxml.h>
+#include <mxml/EventFactory.h>
+#include <mxml/ScoreProperties.h>
+#include <mxml/SpanFactory.h>
+#include <mxml/dom/Backup.h>
+#include <mxml/dom/Forward.h>
+#include <mxml/parsing/ScoreHandler.h>
+
+#include <fstream>
+
+using namespace mxml;
+using namespace mxml::benchmarks;
+
+static const char* kMoonlightFileName = "moonlight.xml";
+
+namespace {
+
+struct Counts {
+    std::size_t attributes = 0;
+    std::size_t barlines = 0;
+    std::size_t chords = 0;
+    std::size_t directions = 0;
+    std::size_t notes = 0;
+    std::size_t other = 0;
+};
+
+std::unique_ptr<dom::Score> loadScore(const char* fileName) {
+    parsing::ScoreHandler handler;
+    std::ifstream is(fileName);
+    lxml::parse(is, fileName, handler);
+    return handler.result();
+}
+
+Counts countWithDynamicCast(const dom::Score& score) {
+    Counts counts;
+    for (auto& part : score.parts()) {
+        for (auto& measure : part->measures()) {
+            for (auto& node : measure->nodes()) {
+                if (dynamic_cast<const dom::Attributes*>(node.get()))
+                    counts.attributes += 1;
+                else if (dynamic_cast<const dom::Barline*>(node.get()))
+                    counts.barlines += 1;
+                else if (dynamic_cast<const dom::Direction*>(node.get()))
+                    counts.directions += 1;
+                else if (dynamic_cast<const dom::Chord*>(node.get()))
+                    counts.chords += 1;
+                else if (dynamic_cast<const dom::Note*>(node.get()))
+                    counts.notes += 1;
+                else
+                    counts.other += 1;
+            }
+        }
+    }
+    return counts;
+}
+
+Counts countWithKind(const dom::Score& score) {
+    Counts counts;
+    for (auto& part : score.parts()) {
+        for (auto& measure : part->measures()) {
+            for (auto& node : measure->nodes()) {
+                switch (node->kind()) {
+                    case dom::Node::Kind::Attributes: counts.attributes += 1; break;
+                    case dom::Node::Kind::Barline: counts.barlines += 1; break;
+                    case dom::Node::Kind::Direction: counts.directions += 1; break;
+                    case dom::Node::Kind::Chord: counts.chords += 1; break;
+                    case dom::Node::Kind::Note: counts.notes += 1; break;
+                    default: counts.other += 1; break;
+                }
+            }
+        }
+    }
+    return counts;
+}
+
+} // namespace
+
+MXML_BENCHMARK(nodeDispatch) {
+    auto score = loadScore(kMoonlightFileName);
+    auto counts = countWithKind(*score);
+    std::printf("  %zu chords, %zu notes, %zu other nodes\n", counts.chords, counts.notes, counts.other);
+
+    measure("dynamic_cast dispatch", 1000, [&]() {
+        auto counts = countWithDynamicCast(*score);
+        keep(counts.other);
+    });
+    measure("kind() dispatch", 1000, [&]() {
+        auto counts = countWithKind(*score);
+        keep(counts.other);
+    });
+
+    auto properties = std::unique_ptr<ScoreProperties>();
+    measure("ScoreProperties", 100, [&]() {
+        properties.reset(new ScoreProperties(*score, ScoreProperties::LayoutType::Scroll));
+    });
+    measure("EventFactory::build", 100, [&]() {
+        EventFactory factory(*score, *properties);
+        auto events = factory.build();
+        keep(events);
+    });
+    measure("SpanFactory::build", 100, [&]() {
+        SpanFactory factory(*score, *properties);
+        auto spans = factory.build();
+        keep(spans);
+    });
+}
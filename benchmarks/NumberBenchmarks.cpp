@@ -0,0 +1,67 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Benchmark.h"
+
+#include <lxml/DoubleHandler.h>
+#include <lxml/IntegerHandler.h>
+#include <mxml/parsing/Numbers.h>
+
+#include <string>
+#include <vector>
+
+using namespace mxml;
+using namespace mxml::benchmarks;
+
+namespace {
+
+// Values as they show up in positions, tempos and durations
+const std::vector<std::string> kDoubles = {
+    "0", "-32.5", "112.73", "-94.21", "6.5", "80", "4", "18.03", "1205.14", "-0.5", "0.2", "93.13"
+};
+const std::vector<std::string> kIntegers = {
+    "1", "2", "4", "8", "12", "16", "24", "256", "-1", "3", "6", "9"
+};
+
+const std::size_t kRepetitions = 10000;
+
+} // namespace
+
+MXML_BENCHMARK(parseNumbers) {
+    measure("lxml parseDouble", 100, [] {
+        double sum = 0;
+        for (std::size_t i = 0; i < kRepetitions; i += 1) {
+            for (auto& string : kDoubles)
+                sum += lxml::DoubleHandler::parseDouble(string);
+        }
+        keep(sum);
+    });
+    measure("mxml parseDouble", 100, [] {
+        double sum = 0;
+        for (std::size_t i = 0; i < kRepetitions; i += 1) {
+            for (auto& string : kDoubles)
+                sum += parsing::parseDouble(string);
+        }
+        keep(sum);
+    });
+
+    measure("lxml parseInteger", 100, [] {
+        long sum = 0;
+        for (std::size_t i = 0; i < kRepetitions; i += 1) {
+            for (auto& string : kIntegers)
+                sum += lxml::IntegerHandler::parseInteger(string);
+        }
+        keep(sum);
+    });
+    measure("mxml parseInteger", 100, [] {
+        long sum = 0;
+        for (std::size_t i = 0; i < kRepetitions; i += 1) {
+            for (auto& string : kIntegers)
+                sum += parsing::parseInteger(string);
+        }
+        keep(sum);
+    });
+}
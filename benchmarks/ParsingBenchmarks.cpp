@@ -0,0 +1,210 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Benchmark.h"
+
+#include <lxml/lxml.h>
+#include <mxml/Parse.h>
+#include <mxml/ScoreSnapshot.h>
+#include <mxml/parsing/PartScanner.h>
+#include <mxml/parsing/ScoreHandler.h>
+#include <mxml/parsing/Tags.h>
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+using namespace mxml;
+using namespace mxml::benchmarks;
+
+static const char* kMoonlightFileName = "moonlight.xml";
+
+namespace {
+
+std::string readFile(const char* fileName) {
+    std::ifstream is(fileName);
+    std::stringstream ss;
+    ss << is.rdbuf();
+    return ss.str();
+}
+
+} // namespace
+
+MXML_BENCHMARK(parseArena) {
+    const auto contents = readFile(kMoonlightFileName);
+
+    measure("parse, heap nodes", 50, [&]() {
+        parsing::ScoreHandler handler;
+        std::istringstream is(contents);
+        lxml::parse(is, kMoonlightFileName, handler);
+        auto score = handler.result();
+        keep(score);
+    });
+    measure("parse, arena nodes", 50, [&]() {
+        parsing::ScoreHandler handler;
+        handler.setUseArena(true);
+        std::istringstream is(contents);
+        lxml::parse(is, kMoonlightFileName, handler);
+        auto score = handler.result();
+        keep(score);
+    });
+}
+
+MXML_BENCHMARK(parseMappedFile) {
+    measure("ifstream + lxml::parse", 50, [&]() {
+        parsing::ScoreHandler handler;
+        std::ifstream is(kMoonlightFileName);
+        lxml::parse(is, kMoonlightFileName, handler);
+        auto score = handler.result();
+        keep(score);
+    });
+    measure("parseFile", 50, [&]() {
+        auto score = parseFile(kMoonlightFileName);
+        keep(score);
+    });
+}
+
+MXML_BENCHMARK(parseTags) {
+    // Element names in the order a measure handler typically sees them
+    static const char* names[] = {"note", "pitch", "step", "octave", "duration", "voice", "type", "stem", "staff",
+        "notations", "direction", "direction-type", "dynamics", "backup", "forward", "barline", "print", "attributes"};
+    static const char* measureTags[] = {"note", "backup", "forward", "attributes", "direction", "print", "barline"};
+
+    measure("strcmp chain", 20000, [&]() {
+        std::size_t matches = 0;
+        for (auto name : names) {
+            for (auto tag : measureTags) {
+                if (std::strcmp(name, tag) == 0) {
+                    matches += 1;
+                    break;
+                }
+            }
+        }
+        keep(matches);
+    });
+    measure("tagFromName", 20000, [&]() {
+        std::size_t matches = 0;
+        for (auto name : names) {
+            switch (parsing::tagFromName(name)) {
+                case parsing::Tag::Note:
+                case parsing::Tag::Backup:
+                case parsing::Tag::Forward:
+                case parsing::Tag::Attributes:
+                case parsing::Tag::Direction:
+                case parsing::Tag::Print:
+                case parsing::Tag::Barline:
+                    matches += 1;
+                    break;
+                default:
+                    break;
+            }
+        }
+        keep(matches);
+    });
+}
+
+MXML_BENCHMARK(parseParallel) {
+    // Orchestral sized score made of copies of the moonlight part
+    const auto contents = readFile(kMoonlightFileName);
+    parsing::PartScanner scanner;
+    if (!scanner.scan(contents.data(), contents.size()) || scanner.parts().empty())
+        return;
+
+    const auto& range = scanner.parts().front();
+    const auto part = contents.substr(range.begin, range.end - range.begin);
+    auto score = contents.substr(0, range.begin);
+    for (int index = 0; index < 32; index += 1)
+        score += part;
+    score += contents.substr(range.end);
+
+    ParseOptions options;
+    measure("32 parts, 1 thread", 5, [&]() {
+        auto result = parseBuffer(score.data(), score.size(), kMoonlightFileName, options);
+        keep(result);
+    });
+    options.threads = 4;
+    measure("32 parts, 4 threads", 5, [&]() {
+        auto result = parseBuffer(score.data(), score.size(), kMoonlightFileName, options);
+        keep(result);
+    });
+}
+
+MXML_BENCHMARK(streamMeasures) {
+    const auto contents = readFile(kMoonlightFileName);
+
+    double firstMeasure = 0;
+    std::size_t runs = 0;
+    ParseOptions options;
+    measure("parse with measure sink", 20, [&]() {
+        const auto start = std::chrono::steady_clock::now();
+        bool first = true;
+        options.measureSink = [&](std::size_t partIndex, const dom::Measure& measure, const parsing::MeasureAttributes& attributes) {
+            if (!first)
+                return;
+            first = false;
+            firstMeasure += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+            runs += 1;
+        };
+        auto score = parseBuffer(contents.data(), contents.size(), kMoonlightFileName, options);
+        keep(score);
+    });
+    std::printf("  %-40s %12.2f us\n", "first measure available", firstMeasure / runs);
+}
+
+MXML_BENCHMARK(parseCompressedFile) {
+    measure("moonlight.xml", 20, [&]() {
+        auto score = parseFile(kMoonlightFileName);
+        keep(score);
+    });
+    measure("moonlight.mxl", 20, [&]() {
+        auto score = parseFile("moonlight.mxl");
+        keep(score);
+    });
+}
+
+MXML_BENCHMARK(loadSnapshot) {
+    const auto contents = readFile(kMoonlightFileName);
+    std::ostringstream os;
+    writeSnapshot(*parseFile(kMoonlightFileName), os);
+    const auto snapshot = os.str();
+
+    measure("parse MusicXML", 50, [&]() {
+        auto score = parseBuffer(contents.data(), contents.size(), kMoonlightFileName);
+        keep(score);
+    });
+    measure("load snapshot", 50, [&]() {
+        auto score = readSnapshot(snapshot.data(), snapshot.size());
+        keep(score);
+    });
+    measure("load snapshot, arena nodes", 50, [&]() {
+        auto score = readSnapshot(snapshot.data(), snapshot.size(), true);
+        keep(score);
+    });
+}
+
+MXML_BENCHMARK(parseProfiles) {
+    const auto contents = readFile(kMoonlightFileName);
+    const std::pair<const char*, parsing::Profile> profiles[] = {
+        {"full", parsing::Profile::Full},
+        {"playback", parsing::Profile::Playback},
+        {"layout", parsing::Profile::Layout},
+    };
+
+    for (auto& profile : profiles) {
+        ParseOptions options;
+        options.useArena = true;
+        options.profile = profile.second;
+
+        auto score = parseBuffer(contents.data(), contents.size(), kMoonlightFileName, options);
+        std::printf("  %-40s %12zu bytes\n", profile.first, score->arena()->size());
+
+        measure(profile.first, 50, [&]() {
+            auto score = parseBuffer(contents.data(), contents.size(), kMoonlightFileName, options);
+            keep(score);
+        });
+    }
+}
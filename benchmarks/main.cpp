@@ -0,0 +1,29 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Benchmark.h"
+
+#include <cstring>
+
+using namespace mxml::benchmarks;
+
+/**
+ Runs all benchmarks, or only the ones whose names are given as arguments. Run from tests/resources so that the score
+ files can be found.
+ */
+int main(int argc, const char* argv[]) {
+    for (auto& benchmark : registry()) {
+        bool selected = argc < 2;
+        for (int i = 1; i < argc; i += 1)
+            selected = selected || std::strcmp(argv[i], benchmark.name) == 0;
+        if (!selected)
+            continue;
+
+        std::printf("%s\n", benchmark.name);
+        benchmark.body();
+    }
+    return 0;
+}
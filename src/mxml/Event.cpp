@@ -6,6 +6,9 @@
 
 #include "Event.h"
 
+#include <algorithm>
+#include <cassert>
+
 namespace mxml {
 
 Event::Event(const dom::Score& score)
@@ -24,11 +27,91 @@ Event::Event(const dom::Score& score, std::size_t measureIndex, dom::time_t meas
   _beatMark()
 {}
 
+namespace {
+
+/**
+ Append notes to the end of an event's range in a pool, moving the range to the end of the pool if something else was
+ appended after it. The notes may come from the same pool.
+ */
+void append(std::vector<const dom::Note*>& pool, std::uint32_t& begin, std::uint32_t& count, NoteRange notes) {
+    if (notes.empty())
+        return;
+
+    const auto data = pool.data();
+    const bool aliased = notes.begin() >= data && notes.end() <= data + pool.size();
+    const auto notesBegin = aliased ? static_cast<std::size_t>(notes.begin() - data) : 0;
+    const bool atEnd = begin + count == pool.size();
+
+    // Indices stay valid across a reallocation, pointers into the pool don't
+    const auto size = pool.size() + (atEnd ? 0 : count) + notes.size();
+    if (size > pool.capacity())
+        pool.reserve(std::max(size, 2 * pool.capacity()));
+    if (!atEnd) {
+        const auto oldBegin = begin;
+        begin = static_cast<std::uint32_t>(pool.size());
+        for (std::uint32_t i = 0; i < count; i += 1)
+            pool.push_back(pool[oldBegin + i]);
+    }
+    for (std::size_t i = 0; i < notes.size(); i += 1)
+        pool.push_back(aliased ? pool[notesBegin + i] : notes[i]);
+    count += static_cast<std::uint32_t>(notes.size());
+}
+
+} // namespace
+
+bool NoteRange::operator==(const NoteRange& rhs) const {
+    return size() == rhs.size() && std::equal(_begin, _end, rhs._begin);
+}
+
+void Event::setNotes(EventNotes& notes) {
+    if (_notes == &notes)
+        return;
+
+    const auto onNotes = this->onNotes();
+    const auto offNotes = this->offNotes();
+    _notes = &notes;
+    _onBegin = static_cast<std::uint32_t>(notes.onNotes.size());
+    _onCount = 0;
+    _offBegin = static_cast<std::uint32_t>(notes.offNotes.size());
+    _offCount = 0;
+    addOnNotes(onNotes);
+    addOffNotes(offNotes);
+}
+
+void Event::addOnNote(const dom::Note& note) {
+    const dom::Note* pointer = &note;
+    addOnNotes(NoteRange(&pointer, &pointer + 1));
+}
+
+void Event::addOffNote(const dom::Note& note) {
+    const dom::Note* pointer = &note;
+    addOffNotes(NoteRange(&pointer, &pointer + 1));
+}
+
+void Event::addOnNotes(NoteRange notes) {
+    assert(_notes);
+    append(_notes->onNotes, _onBegin, _onCount, notes);
+}
+
+void Event::addOffNotes(NoteRange notes) {
+    assert(_notes);
+    append(_notes->offNotes, _offBegin, _offCount, notes);
+}
+
+void Event::merge(const Event& event) {
+    _measureIndex = event._measureIndex;
+    _measureTime = event._measureTime;
+    _beatMark = _beatMark || event._beatMark;
+    addOnNotes(event.onNotes());
+    addOffNotes(event.offNotes());
+}
+
 dom::time_t Event::maxDuration() const {
-    auto it = std::max_element(_onNotes.begin(), _onNotes.end(), [](const dom::Note* n1, const dom::Note* n2) {
+    const auto notes = onNotes();
+    auto it = std::max_element(notes.begin(), notes.end(), [](const dom::Note* n1, const dom::Note* n2) {
         return n1->duration() < n2->duration();
     });
-    if (it == _onNotes.end())
+    if (it == notes.end())
         return 0;
     return (*it)->duration();
 }
@@ -8,6 +8,9 @@
 #include <mxml/dom/Note.h>
 #include <mxml/dom/Score.h>
 
+#include <cstdint>
+#include <vector>
+
 namespace mxml {
 
 struct MeasureLocation {
@@ -25,12 +28,72 @@ struct MeasureLocation {
     }
 };
 
+/**
+ Read-only view of a contiguous range of notes.
+ */
+class NoteRange {
+public:
+    using const_iterator = const dom::Note* const*;
+
+public:
+    NoteRange() : _begin(), _end() {}
+    NoteRange(const_iterator begin, const_iterator end) : _begin(begin), _end(end) {}
+
+    const_iterator begin() const {
+        return _begin;
+    }
+    const_iterator end() const {
+        return _end;
+    }
+
+    std::size_t size() const {
+        return static_cast<std::size_t>(_end - _begin);
+    }
+    bool empty() const {
+        return _begin == _end;
+    }
+
+    const dom::Note* front() const {
+        return *_begin;
+    }
+    const dom::Note* back() const {
+        return *(_end - 1);
+    }
+    const dom::Note* operator[](std::size_t index) const {
+        return _begin[index];
+    }
+
+    bool operator==(const NoteRange& rhs) const;
+    bool operator!=(const NoteRange& rhs) const {
+        return !operator==(rhs);
+    }
+
+private:
+    const_iterator _begin;
+    const_iterator _end;
+};
+
+/**
+ Note pools shared by many events, every event refers to a contiguous range of on notes and one of off notes.
+ */
+struct EventNotes {
+    std::vector<const dom::Note*> onNotes;
+    std::vector<const dom::Note*> offNotes;
+};
+
+/**
+ A point in time where notes start or stop. An event doesn't own its notes, they live in the EventNotes pools of the
+ sequence or factory that made the event, which have to outlive it. Copying an event doesn't copy its notes.
+ */
 class Event {
 public:
     Event() = default;
     explicit Event(const dom::Score& score);
     Event(const dom::Score& score, std::size_t measureIndex, dom::time_t measureTime, dom::time_t absoluteTime);
     Event(const Event& event) = default;
+    Event(Event&& event) = default;
+    Event& operator=(const Event& event) = default;
+    Event& operator=(Event&& event) = default;
     
     const dom::Score& score() const {
         return *_score;
@@ -90,24 +153,46 @@ public:
 
     dom::time_t maxDuration() const;
 
-    const std::vector<const dom::Note*>& onNotes() const {
-        return _onNotes;
+    NoteRange onNotes() const {
+        return range(_notes ? &_notes->onNotes : nullptr, _onBegin, _onCount);
     }
-    std::vector<const dom::Note*>& onNotes() {
-        return _onNotes;
+    NoteRange offNotes() const {
+        return range(_notes ? &_notes->offNotes : nullptr, _offBegin, _offCount);
     }
-    const std::vector<const dom::Note*>& offNotes() const {
-        return _offNotes;
-    }
-    std::vector<const dom::Note*>& offNotes() {
-        return _offNotes;
+
+    /**
+     Get the pools the notes of this event are stored in, if any.
+     */
+    EventNotes* notes() const {
+        return _notes;
     }
-    
-    void addOnNote(const dom::Note& note) {
-        _onNotes.push_back(&note);
+
+    /**
+     Store the notes of this event in the given pools, copying them there if they were stored elsewhere. An event
+     needs pools before notes can be added to it.
+     */
+    void setNotes(EventNotes& notes);
+
+    /**
+     Add notes at the end of the event's ranges. This is a plain append when the event was the last one to add notes to
+     its pools, otherwise its range is moved to the end of the pool first.
+     */
+    void addOnNote(const dom::Note& note);
+    void addOffNote(const dom::Note& note);
+    void addOnNotes(NoteRange notes);
+    void addOffNotes(NoteRange notes);
+
+    /**
+     Merge an event happening at the same time into this one. The measure location of the other event is kept, beat
+     marks are combined and its notes are added after the notes of this event.
+     */
+    void merge(const Event& event);
+
+    void clearOnNotes() {
+        _onCount = 0;
     }
-    void addOffNote(const dom::Note& note) {
-        _offNotes.push_back(&note);
+    void clearOffNotes() {
+        _offCount = 0;
     }
     
     bool operator<(const Event& rhs) const {
@@ -124,9 +209,19 @@ private:
 
     double _wallTime;
     double _wallTimeDuration;
-    
-    std::vector<const dom::Note*> _onNotes;
-    std::vector<const dom::Note*> _offNotes;
+
+    EventNotes* _notes = nullptr;
+    std::uint32_t _onBegin = 0;
+    std::uint32_t _onCount = 0;
+    std::uint32_t _offBegin = 0;
+    std::uint32_t _offCount = 0;
+
+private:
+    static NoteRange range(const std::vector<const dom::Note*>* pool, std::uint32_t begin, std::uint32_t count) {
+        if (!pool || count == 0)
+            return NoteRange();
+        return NoteRange(pool->data() + begin, pool->data() + begin + count);
+    }
 };
 
 } // namespace mxml
@@ -0,0 +1,181 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "EventCursor.h"
+
+
+namespace mxml {
+
+EventCursor::EventCursor(const ScoreProperties& scoreProperties, std::size_t startMeasureIndex, std::size_t endMeasureIndex, dom::time_t startTime,
+                         std::vector<Event> events, std::vector<std::size_t> measureEvents, std::unique_ptr<EventNotes> notes)
+: _scoreProperties(scoreProperties),
+  _startMeasureIndex(startMeasureIndex),
+  _endMeasureIndex(endMeasureIndex),
+  _startTime(startTime),
+  _events(std::move(events)),
+  _measureEvents(std::move(measureEvents)),
+  _notes(std::move(notes))
+{
+    reset();
+}
+
+void EventCursor::reset() {
+    _measureIndex = _startMeasureIndex;
+    _loopCounts.clear();
+    _jumpStates.clear();
+    _inMeasure = false;
+    _measureDuration = 0;
+    _measureStartTime = 0;
+    _time = 0;
+    _eventIndex = 0;
+    _eventEnd = 0;
+
+    _wallTimeTime = _startTime;
+    _wallTime = 0.0;
+    _atEnd = false;
+
+    _hasPending = nextMeasureEvent(_pending);
+    next();
+}
+
+void EventCursor::next() {
+    if (!_hasPending) {
+        _atEnd = true;
+        return;
+    }
+
+    _event = _pending;
+    _hasPending = nextMeasureEvent(_pending);
+    if (_hasPending && _pending.absoluteTime() == _event.absoluteTime()) {
+        _mergedNotes.onNotes.clear();
+        _mergedNotes.offNotes.clear();
+        _event.setNotes(_mergedNotes);
+        while (_hasPending && _pending.absoluteTime() == _event.absoluteTime()) {
+            _event.merge(_pending);
+            _hasPending = nextMeasureEvent(_pending);
+        }
+    }
+
+    const double tempo = _scoreProperties.tempo(_event.measureIndex(), _event.measureTime());
+    const auto divisionsPerBeat = _scoreProperties.divisionsPerBeat(_event.measureIndex());
+    const auto divisionDuration = 60.0 / (divisionsPerBeat * tempo); // In seconds
+
+    _wallTime += divisionDuration * static_cast<double>(_event.absoluteTime() - _wallTimeTime);
+    _wallTimeTime = _event.absoluteTime();
+
+    _event.setWallTime(_wallTime);
+    _event.setWallTimeDuration(_event.maxDuration() * divisionDuration);
+}
+
+void EventCursor::seek(dom::time_t time) {
+    if (_atEnd || _event.absoluteTime() > time)
+        reset();
+    while (!_atEnd && _event.absoluteTime() < time)
+        next();
+}
+
+void EventCursor::seekWallTime(double wallTime) {
+    if (_atEnd || _event.wallTime() > wallTime)
+        reset();
+    while (!_atEnd && _event.wallTime() < wallTime)
+        next();
+}
+
+bool EventCursor::nextMeasureEvent(Event& event) {
+    while (true) {
+        while (_eventIndex != _eventEnd) {
+            auto& source = _events[_eventIndex];
+            _eventIndex += 1;
+            if (source.measureTime() < 0 || source.measureTime() > _measureDuration)
+                continue;
+
+            _time = _measureStartTime + source.measureTime();
+            event = source;
+            event.setAbsoluteTime(_time);
+            return true;
+        }
+
+        if (_inMeasure) {
+            _inMeasure = false;
+            _measureIndex += 1;
+            if (_time > _measureStartTime + _measureDuration)
+                _time = _measureStartTime + _measureDuration;
+            _measureStartTime = _time;
+        }
+
+        if (!enterMeasure())
+            return false;
+    }
+}
+
+bool EventCursor::enterMeasure() {
+    // Iterate until we equal the measure count for loops
+    // that 'end' past the last measure
+    while (_measureIndex <= _endMeasureIndex) {
+        bool skipped = false;
+
+        auto prevLoop = _scoreProperties.loop(_measureIndex - 1);
+        if (prevLoop && prevLoop->end() == _measureIndex) {
+            auto& loopInteration = _loopCounts[*prevLoop];
+
+            if (loopInteration < prevLoop->count()) {
+                _measureIndex = prevLoop->begin();
+                skipped = true;
+            }
+
+            loopInteration += 1;
+        }
+
+        auto loop = _scoreProperties.loop(_measureIndex);
+        if (!skipped && loop) {
+            auto& loopInteration = _loopCounts[*loop];
+
+            if (loop->isSkipped(loopInteration, _measureIndex)) {
+                _measureIndex += 1;
+                skipped = true;
+            }
+        }
+
+        auto jumps = _scoreProperties.jumps(_measureIndex);
+        for (auto& jump : jumps) {
+            auto& state = _jumpStates[jump];
+            if (jump.forward()) {
+                if (state == kActive) {
+                    _measureIndex = jump.to;
+                    skipped = true;
+                    state = kPerformed;
+                } else {
+                    state = kFlagged;
+                }
+            } else if (!jump.forward()) {
+                if (state == kUnencountered) {
+                    _measureIndex = jump.to;
+                    skipped = true;
+                    for (auto& pair : _jumpStates) {
+                        if (pair.second == kFlagged)
+                            pair.second = kActive;
+                    }
+                }
+                state = kPerformed;
+            }
+        }
+
+        if (!skipped) {
+            _inMeasure = true;
+            _measureDuration = _scoreProperties.divisionsPerMeasure(_measureIndex);
+            _eventIndex = 0;
+            _eventEnd = 0;
+            if (_measureIndex >= _startMeasureIndex && _measureIndex < _endMeasureIndex) {
+                _eventIndex = _measureEvents[_measureIndex - _startMeasureIndex];
+                _eventEnd = _measureEvents[_measureIndex - _startMeasureIndex + 1];
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace mxml
@@ -0,0 +1,112 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+#include "Event.h"
+#include "Jump.h"
+#include "Loop.h"
+#include "ScoreProperties.h"
+
+#include <map>
+#include <memory>
+#include <vector>
+
+
+namespace mxml {
+
+/**
+ Walks the events of a performance in playing order without unrolling it. The cursor keeps the events of every measure
+ once and follows loops and jumps as it goes, computing absolute and wall times along the way, so its memory depends on
+ the size of the score instead of the length of the performance. Use EventFactory::buildCursor to create one.
+ */
+class EventCursor {
+public:
+    /**
+     Whether the cursor went past the last event.
+     */
+    bool atEnd() const {
+        return _atEnd;
+    }
+
+    /**
+     The current event. The reference and the notes of the event are only valid until the cursor moves.
+     */
+    const Event& event() const {
+        return _event;
+    }
+
+    /**
+     Move to the next event.
+     */
+    void next();
+
+    /**
+     Move back to the first event.
+     */
+    void reset();
+
+    /**
+     Move to the first event at or after the given absolute time. Seeking backwards starts over from the beginning.
+     */
+    void seek(dom::time_t time);
+
+    /**
+     Move to the first event at or after the given wall time in seconds. Seeking backwards starts over from the beginning.
+     */
+    void seekWallTime(double wallTime);
+
+private:
+    EventCursor(const ScoreProperties& scoreProperties, std::size_t startMeasureIndex, std::size_t endMeasureIndex, dom::time_t startTime,
+                std::vector<Event> events, std::vector<std::size_t> measureEvents, std::unique_ptr<EventNotes> notes);
+
+    /**
+     Produce the next measure event in playing order with its absolute time set, without merging events at the same time.
+     */
+    bool nextMeasureEvent(Event& event);
+
+    /**
+     Follow loops and jumps to the next measure to play and start on its events.
+     */
+    bool enterMeasure();
+
+private:
+    enum JumpState { kUnencountered, kFlagged, kActive, kPerformed };
+
+    const ScoreProperties& _scoreProperties;
+    std::size_t _startMeasureIndex;
+    std::size_t _endMeasureIndex;
+    dom::time_t _startTime;
+
+    // Sorted by measure location, the events of a measure start at the index for that measure
+    std::vector<Event> _events;
+    std::vector<std::size_t> _measureEvents;
+    std::unique_ptr<EventNotes> _notes;
+
+    // Loop and jump state
+    std::size_t _measureIndex;
+    std::map<Loop, std::size_t> _loopCounts;
+    std::map<Jump, JumpState> _jumpStates;
+    bool _inMeasure;
+    dom::time_t _measureDuration;
+    dom::time_t _measureStartTime;
+    dom::time_t _time;
+    std::size_t _eventIndex;
+    std::size_t _eventEnd;
+
+    // The next measure event, it gets merged into the current event if they happen at the same time
+    Event _pending;
+    bool _hasPending;
+
+    Event _event;
+    EventNotes _mergedNotes;
+    bool _atEnd;
+    dom::time_t _wallTimeTime;
+    double _wallTime;
+
+    friend class EventFactory;
+};
+
+} // namespace mxml
@@ -15,12 +15,43 @@
 #include <mxml/dom/TimedNode.h>
 #include <mxml/dom/Types.h>
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <system_error>
+#include <thread>
+
 namespace mxml {
 
 using namespace dom;
 
+namespace {
+
+/**
+ Run the work on the given number of threads, including the calling thread, and wait for all of them to finish.
+ */
+template <typename Work>
+void runWorkers(std::size_t threads, Work work) {
+    std::vector<std::thread> workers;
+    for (std::size_t worker = 1; worker < threads; worker += 1) {
+        try {
+            workers.emplace_back(work);
+        } catch (const std::system_error&) {
+            // Fewer workers only make it slower
+            break;
+        }
+    }
+    work();
+    for (auto& worker : workers)
+        worker.join();
+}
+
+} // namespace
+
 EventFactory::EventFactory(const dom::Score& score, const ScoreProperties& scoreProperties)
-: _score(score),
+: _threads(1),
+  _score(score),
   _scoreProperties(scoreProperties),
   _startTime(),
   _time(0)
@@ -31,32 +62,51 @@ std::unique_ptr<EventSequence> EventFactory::build() {
 }
 
 std::unique_ptr<EventSequence> EventFactory::build(dom::time_t startTime, std::size_t startMeasureIndex, std::size_t endMeasureIndex) {
+    auto cursor = buildCursor(startTime, startMeasureIndex, endMeasureIndex);
+    return unroll(*cursor);
+}
+
+std::unique_ptr<EventCursor> EventFactory::buildCursor() {
+    return buildCursor(0, 0, _score.parts().at(0)->measures().size());
+}
+
+std::unique_ptr<EventCursor> EventFactory::buildCursor(dom::time_t startTime, std::size_t startMeasureIndex, std::size_t endMeasureIndex) {
     _startTime = startTime;
     _startMeasureIndex = startMeasureIndex;
     _endMeasureIndex = endMeasureIndex;
-
-    for (auto& part : _score.parts()) {
-        _part = part.get();
-        _measureStartTime = 0;
-        _time = _startTime;
-        for (std::size_t measureIndex = _startMeasureIndex; measureIndex < _endMeasureIndex; measureIndex += 1) {
-            const Measure& measure = *part->measures().at(measureIndex);
-            processMeasure(measure);
-        }
+    _records.clear();
+    _lastTimes.assign(_endMeasureIndex - _startMeasureIndex, 0);
+
+    const auto threads = _threads != 0 ? _threads : std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    if (threads > 1 && _score.parts().size() > 1) {
+        processPartsParallel(threads);
+    } else {
+        for (auto& part : _score.parts())
+            processPart(*part);
+        addBeatMarks();
+        sortRecords();
     }
+    buildEvents();
 
-    setBeatMarks();
-    auto eventSequence = unroll();
-    fillWallTimes(*eventSequence);
+    // The cursor takes over the measure events
+    return std::unique_ptr<EventCursor>(new EventCursor(_scoreProperties, _startMeasureIndex, _endMeasureIndex, _startTime,
+                                                        std::move(_events), std::move(_measureEvents), std::move(_notes)));
+}
 
-    return eventSequence;
+void EventFactory::processPart(const dom::Part& part) {
+    _part = &part;
+    _measureStartTime = 0;
+    _time = _startTime;
+    for (std::size_t measureIndex = _startMeasureIndex; measureIndex < _endMeasureIndex; measureIndex += 1) {
+        const Measure& measure = *part.measures().at(measureIndex);
+        processMeasure(measure);
+    }
 }
 
 void EventFactory::processMeasure(const dom::Measure& measure) {
     for (auto& node : measure.nodes()) {
-        if (const TimedNode* timedNode = dynamic_cast<const TimedNode*>(node.get())) {
-            processTimedNode(*timedNode);
-        }
+        if (node->isTimed())
+            processTimedNode(static_cast<const TimedNode&>(*node));
     }
 
     auto nextTime = _measureStartTime + _scoreProperties.divisionsPerMeasure(measure.index());
@@ -66,16 +116,23 @@ void EventFactory::processMeasure(const dom::Measure& measure) {
 }
 
 void EventFactory::processTimedNode(const TimedNode& node) {
-    if (auto chord = dynamic_cast<const Chord*>(&node)) {
-        processChord(*chord);
-        _time += node.duration();
-    } else if (auto note = dynamic_cast<const Note*>(&node)) {
-        addNote(*note);
-        _time += node.duration();
-    } else if (dynamic_cast<const Forward*>(&node)) {
-        _time += node.duration();
-    } else if (dynamic_cast<const Backup*>(&node)) {
-        _time -= node.duration();
+    switch (node.kind()) {
+        case Node::Kind::Chord:
+            processChord(static_cast<const Chord&>(node));
+            _time += node.duration();
+            break;
+        case Node::Kind::Note:
+            addNote(static_cast<const Note&>(node));
+            _time += node.duration();
+            break;
+        case Node::Kind::Forward:
+            _time += node.duration();
+            break;
+        case Node::Kind::Backup:
+            _time -= node.duration();
+            break;
+        default:
+            break;
     }
 }
 
@@ -87,156 +144,216 @@ void EventFactory::processChord(const Chord& chord) {
 void EventFactory::addNote(const Note& note) {
     auto measureIndex = note.measure()->index();
 
-    auto& onEvent = event(measureIndex, note.start(), _time);
+    // Tied notes still get events where they start and stop, only without the note
     if (!isTieStop(note))
-        onEvent.addOnNote(note);
+        addRecord(measureIndex, note.start(), Record::Kind::On, &note);
+    else
+        addRecord(measureIndex, note.start(), Record::Kind::Empty, nullptr);
 
-    auto& offEvent = event(measureIndex, note.start() + note.duration(), _time + note.duration());
     if (!isTieStart(note))
-        offEvent.addOffNote(note);
+        addRecord(measureIndex, note.start() + note.duration(), Record::Kind::Off, &note);
+    else
+        addRecord(measureIndex, note.start() + note.duration(), Record::Kind::Empty, nullptr);
 }
 
-Event& EventFactory::event(std::size_t measureIndex, dom::time_t measureTime, dom::time_t absoluteTime) {
-    auto it = _events.find(std::make_pair(measureIndex, measureTime));
-    if (it != _events.end())
-        return it->second;
-
-    auto event = Event{_score};
-    event.setMeasureIndex(measureIndex);
-    event.setMeasureTime(measureTime);
-    event.setAbsoluteTime(absoluteTime);
-    it = _events.insert(std::make_pair(std::make_pair(measureIndex, measureTime), event)).first;
-    return it->second;
+void EventFactory::addRecord(std::size_t measureIndex, dom::time_t measureTime, Record::Kind kind, const dom::Note* note) {
+    _records.push_back(Record{measureIndex, measureTime, kind, note});
+
+    auto& lastTime = _lastTimes[measureIndex - _startMeasureIndex];
+    if (measureTime > lastTime)
+        lastTime = measureTime;
 }
 
-void EventFactory::setBeatMarks() {
-    dom::time_t absoluteTime = 0;
+void EventFactory::addBeatMarks() {
     for (std::size_t measureIndex = _startMeasureIndex; measureIndex < _endMeasureIndex; measureIndex += 1) {
         auto divisionsPerBeat = _scoreProperties.divisionsPerBeat(measureIndex);
-
-        dom::time_t lastTime = 0;
-        auto begin = _events.lower_bound({measureIndex, 0});
-        for (auto it = begin; it != _events.end(); ++it) {
-            auto index = it->first.first;
-            auto time = it->first.second;
-            if (index != measureIndex)
-                break;
-            if (time > lastTime)
-                lastTime = time;
-        }
-
-        for (dom::time_t time = 0; time < lastTime; time += divisionsPerBeat) {
-            auto& e = event(measureIndex, time, absoluteTime);
-            e.setBeatMark(true);
-            absoluteTime += divisionsPerBeat;
-        }
+        auto lastTime = _lastTimes[measureIndex - _startMeasureIndex];
+        for (dom::time_t time = 0; time < lastTime; time += divisionsPerBeat)
+            _records.push_back(Record{measureIndex, time, Record::Kind::Beat, nullptr});
     }
 }
 
-std::unique_ptr<EventSequence> EventFactory::unroll() {
-    auto eventSequence = std::unique_ptr<EventSequence>(new EventSequence(_scoreProperties));
-
-    std::size_t measureIndex = _startMeasureIndex;
-    dom::time_t measureStartTime = 0;
-    dom::time_t time = 0;
-
-    std::map<Loop, std::size_t> loopCounts;
-    
-    enum JumpState { kUnencountered, kFlagged, kActive, kPerformed };
-    std::map<Jump, JumpState> jumpStates;
-
-    // Iterate until we equal the measure count for loops
-    // that 'end' past the last measure
-    while (measureIndex <= _endMeasureIndex) {
-        bool skipped = false;
-
-        auto prevLoop = _scoreProperties.loop(measureIndex - 1);
-        if (prevLoop && prevLoop->end() == measureIndex) {
-            auto& loopInteration = loopCounts[*prevLoop];
-
-            if (loopInteration < prevLoop->count()) {
-                measureIndex = prevLoop->begin();
-                skipped = true;
+void EventFactory::processPartsParallel(std::size_t threads) {
+    const auto& parts = _score.parts();
+    const auto measureCount = _endMeasureIndex - _startMeasureIndex;
+    threads = std::min(threads, parts.size());
+
+    // Every part gets its own sorted records, the beat marks go in the last list because they are added after all parts
+    std::vector<std::vector<Record>> partRecords(parts.size() + 1);
+    std::vector<std::vector<std::size_t>> partMeasureRecords(parts.size() + 1);
+    std::vector<std::vector<dom::time_t>> partLastTimes(parts.size());
+    std::vector<std::exception_ptr> errors(parts.size());
+    std::atomic<std::size_t> next(0);
+
+    runWorkers(threads, [&]() {
+        EventFactory factory(_score, _scoreProperties);
+        factory._startTime = _startTime;
+        factory._startMeasureIndex = _startMeasureIndex;
+        factory._endMeasureIndex = _endMeasureIndex;
+        for (auto index = next++; index < parts.size(); index = next++) {
+            try {
+                factory._records.clear();
+                factory._lastTimes.assign(measureCount, 0);
+                factory.processPart(*parts[index]);
+                factory.sortRecords();
+                partRecords[index].swap(factory._records);
+                partMeasureRecords[index].swap(factory._measureRecords);
+                partLastTimes[index].swap(factory._lastTimes);
+            } catch (...) {
+                errors[index] = std::current_exception();
             }
-
-            loopInteration += 1;
         }
+    });
 
-        auto loop = _scoreProperties.loop(measureIndex);
-        if (!skipped && loop) {
-            auto& loopInteration = loopCounts[*loop];
+    for (auto& error : errors) {
+        if (error)
+            std::rethrow_exception(error);
+    }
 
-            if (loop->isSkipped(loopInteration, measureIndex)) {
-                measureIndex += 1;
-                skipped = true;
-            }
+    for (auto& lastTimes : partLastTimes) {
+        for (std::size_t i = 0; i < measureCount; i += 1)
+            _lastTimes[i] = std::max(_lastTimes[i], lastTimes[i]);
+    }
+    _records.clear();
+    addBeatMarks();
+    sortRecords();
+    partRecords.back().swap(_records);
+    partMeasureRecords.back().swap(_measureRecords);
+
+    // The merged records of a measure start after the records of the previous measures in every list
+    _measureRecords.assign(measureCount + 1, 0);
+    for (auto& measureRecords : partMeasureRecords) {
+        for (std::size_t i = 0; i <= measureCount; i += 1)
+            _measureRecords[i] += measureRecords[i];
+    }
+    _records.resize(_measureRecords[measureCount]);
+
+    // K-way merge of every measure, records at the same time come out in list order like in a stable sort
+    struct Head {
+        dom::time_t measureTime;
+        std::size_t list;
+        std::size_t index;
+
+        bool operator>(const Head& rhs) const {
+            if (measureTime != rhs.measureTime)
+                return measureTime > rhs.measureTime;
+            return list > rhs.list;
         }
-
-        auto jumps = _scoreProperties.jumps(measureIndex);
-        for (auto& jump : jumps) {
-            auto& state = jumpStates[jump];
-            if (jump.forward()) {
-                if (state == kActive) {
-                    measureIndex = jump.to;
-                    skipped = true;
-                    state = kPerformed;
-                } else {
-                    state = kFlagged;
+    };
+
+    const std::size_t kMeasuresPerTask = 16;
+    next = 0;
+    runWorkers(threads, [&]() {
+        std::vector<Head> heads;
+        for (auto begin = next.fetch_add(kMeasuresPerTask); begin < measureCount; begin = next.fetch_add(kMeasuresPerTask)) {
+            const auto end = std::min(begin + kMeasuresPerTask, measureCount);
+            for (auto measure = begin; measure < end; measure += 1) {
+                heads.clear();
+                for (std::size_t list = 0; list < partRecords.size(); list += 1) {
+                    const auto index = partMeasureRecords[list][measure];
+                    if (index != partMeasureRecords[list][measure + 1])
+                        heads.push_back(Head{partRecords[list][index].measureTime, list, index});
                 }
-            } else if (!jump.forward()) {
-                if (state == kUnencountered) {
-                    measureIndex = jump.to;
-                    skipped = true;
-                    for (auto& pair : jumpStates) {
-                        if (pair.second == kFlagged)
-                            pair.second = kActive;
+
+                auto output = _records.begin() + _measureRecords[measure];
+                std::make_heap(heads.begin(), heads.end(), std::greater<Head>());
+                while (!heads.empty()) {
+                    std::pop_heap(heads.begin(), heads.end(), std::greater<Head>());
+                    auto& head = heads.back();
+                    *output++ = partRecords[head.list][head.index];
+
+                    head.index += 1;
+                    if (head.index == partMeasureRecords[head.list][measure + 1]) {
+                        heads.pop_back();
+                    } else {
+                        head.measureTime = partRecords[head.list][head.index].measureTime;
+                        std::push_heap(heads.begin(), heads.end(), std::greater<Head>());
                     }
                 }
-                state = kPerformed;
             }
         }
+    });
+}
 
-        if (!skipped) {
-            auto measureDuration = _scoreProperties.divisionsPerMeasure(measureIndex);
-            auto first = _events.lower_bound(std::make_pair(measureIndex, 0));
-            auto second = _events.upper_bound(std::make_pair(measureIndex, measureDuration));
-            for (auto it = first; it != second; ++it) {
-                auto event = it->second;
-                time = measureStartTime + event.measureTime();
-                event.setAbsoluteTime(time);
-                eventSequence->addEvent(event);
-            }
-            
-            measureIndex += 1;
-            if (time > measureStartTime + measureDuration)
-                time = measureStartTime + measureDuration;
-            measureStartTime = time;
-        }
+void EventFactory::sortRecords() {
+    const auto measureCount = _endMeasureIndex - _startMeasureIndex;
+
+    // Counting sort by measure keeps the document order within each measure
+    _measureRecords.assign(measureCount + 1, 0);
+    for (auto& record : _records)
+        _measureRecords[record.measureIndex - _startMeasureIndex + 1] += 1;
+    for (std::size_t i = 0; i < measureCount; i += 1)
+        _measureRecords[i + 1] += _measureRecords[i];
+
+    std::vector<Record> sorted(_records.size());
+    auto next = _measureRecords;
+    for (auto& record : _records)
+        sorted[next[record.measureIndex - _startMeasureIndex]++] = record;
+
+    for (std::size_t i = 0; i < measureCount; i += 1) {
+        std::stable_sort(sorted.begin() + _measureRecords[i], sorted.begin() + _measureRecords[i + 1], [](const Record& lhs, const Record& rhs) {
+            return lhs.measureTime < rhs.measureTime;
+        });
     }
-
-    return eventSequence;
+    _records.swap(sorted);
 }
 
-void EventFactory::fillWallTimes(EventSequence& eventSequence) {
-    double tempo = 60.0;
-    int divisions = 1;
-    dom::time_t time = _startTime;
-    double wallTime = 0.0;
-
-    for (auto& event : eventSequence.events()) {
-        divisions = _scoreProperties.divisions(event.measureIndex());
-        tempo = _scoreProperties.tempo(event.measureIndex(), event.measureTime());
+void EventFactory::buildEvents() {
+    const auto measureCount = _endMeasureIndex - _startMeasureIndex;
 
-        const auto divisionsPerBeat = _scoreProperties.divisionsPerBeat(event.measureIndex());
-        const auto divisionDuration = 60.0 / (divisionsPerBeat * tempo); // In seconds
-
-        wallTime += divisionDuration * static_cast<double>(event.absoluteTime() - time);
-        time = event.absoluteTime();
+    std::size_t onCount = 0;
+    std::size_t offCount = 0;
+    for (auto& record : _records) {
+        onCount += record.kind == Record::Kind::On;
+        offCount += record.kind == Record::Kind::Off;
+    }
 
-        event.setWallTime(wallTime);
-        event.setWallTimeDuration(event.maxDuration() * divisionDuration);
+    _events.clear();
+    _notes.reset(new EventNotes());
+    _notes->onNotes.reserve(onCount);
+    _notes->offNotes.reserve(offCount);
+    _measureEvents.assign(measureCount + 1, 0);
+
+    std::size_t measure = 0;
+    const auto end = _records.end();
+    for (auto run = _records.begin(); run != end; ) {
+        const auto measureIndex = run->measureIndex;
+        const auto measureTime = run->measureTime;
+        for (; measure <= measureIndex - _startMeasureIndex; measure += 1)
+            _measureEvents[measure] = _events.size();
+
+        _events.emplace_back(_score, measureIndex, measureTime, 0);
+        auto& event = _events.back();
+        event.setNotes(*_notes);
+        for (; run != end && run->measureIndex == measureIndex && run->measureTime == measureTime; ++run) {
+            switch (run->kind) {
+                case Record::Kind::On:
+                    event.addOnNote(*run->note);
+                    break;
+                case Record::Kind::Off:
+                    event.addOffNote(*run->note);
+                    break;
+                case Record::Kind::Beat:
+                    event.setBeatMark(true);
+                    break;
+                case Record::Kind::Empty:
+                    break;
+            }
+        }
     }
+    for (; measure <= measureCount; measure += 1)
+        _measureEvents[measure] = _events.size();
+    _records.clear();
+}
 
+std::unique_ptr<EventSequence> EventFactory::unroll(EventCursor& cursor) {
+    // The cursor yields events in increasing absolute time with their wall times filled
+    EventSequence::Builder builder(_scoreProperties);
+    builder.reserve(cursor._events.size());
+    builder.reserveNotes(cursor._notes->onNotes.size(), cursor._notes->offNotes.size());
+    for (; !cursor.atEnd(); cursor.next())
+        builder.add(cursor.event());
+    return builder.finish();
 }
 
 bool EventFactory::isTieStart(const mxml::dom::Note& note) {
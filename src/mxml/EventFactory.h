@@ -5,10 +5,10 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #pragma once
+#include "EventCursor.h"
 #include "EventSequence.h"
 #include "ScoreProperties.h"
 
-#include <map>
 #include <memory>
 #include <vector>
 
@@ -24,13 +24,52 @@ namespace dom {
 }
 
 class EventFactory {
+private:
+    /**
+     Something happening at a measure location. Records are collected in document order and sorted once all the parts
+     are processed, records at the same location end up in the same event.
+     */
+    struct Record {
+        enum class Kind {
+            On,
+            Off,
+            Beat,
+            Empty
+        };
+
+        std::size_t measureIndex;
+        dom::time_t measureTime;
+        Kind kind;
+        const dom::Note* note;
+    };
+
 public:
     explicit EventFactory(const dom::Score& score, const ScoreProperties& scoreProperties);
 
+    /**
+     Number of threads used to collect the events of the parts. With more than one thread every part is processed on its
+     own and the results are merged, the events are the same as with a single thread. Use 0 for one thread per hardware
+     core. Defaults to 1.
+     */
+    std::size_t threads() const {
+        return _threads;
+    }
+    void setThreads(std::size_t threads) {
+        _threads = threads;
+    }
+
     std::unique_ptr<EventSequence> build();
     std::unique_ptr<EventSequence> build(dom::time_t startTime, std::size_t startMeasureIndex, std::size_t endMeasureIndex);
+
+    /**
+     Build a cursor that walks the performance without unrolling it, for scores where the unrolled sequence gets too
+     large. Walking the cursor yields the same events as the sequence returned by build.
+     */
+    std::unique_ptr<EventCursor> buildCursor();
+    std::unique_ptr<EventCursor> buildCursor(dom::time_t startTime, std::size_t startMeasureIndex, std::size_t endMeasureIndex);
     
 private:
+    void processPart(const dom::Part& part);
     void processMeasure(const dom::Measure& measure);
     void processBarline(const dom::Barline& node);
     void processTimedNode(const dom::TimedNode& node);
@@ -38,30 +77,41 @@ private:
     void addNote(const dom::Note& note);
 
     /**
-     Return the event in the current measure for the given measure time and absolute time, creates a new event if
-     necessary.
+     Record a note starting or stopping at the given measure time, or any other reason for an event to exist there.
      */
-    Event& event(std::size_t measureIndex, dom::time_t measureTime, dom::time_t absoluteTime);
+    void addRecord(std::size_t measureIndex, dom::time_t measureTime, Record::Kind kind, const dom::Note* note);
 
     /**
-     Fill in beat mark events for every measure according to the time signature.
+     Add beat mark records for every measure according to the time signature.
      */
-    void setBeatMarks();
+    void addBeatMarks();
 
     /**
-     Unroll all loops and jumps to create a linear event sequence.
+     Process the parts on separate threads, then merge the sorted records of every part and the beat marks. The merged
+     records are in the same order sortRecords would put them in.
+     */
+    void processPartsParallel(std::size_t threads);
+
+    /**
+     Sort the records by measure location, records at the same location stay in the order they were added.
+     */
+    void sortRecords();
+
+    /**
+     Turn each run of sorted records with the same location into one event.
      */
-    std::unique_ptr<EventSequence> unroll();
+    void buildEvents();
 
     /**
-     Fill the event wall times in seconds from the tempo values.
+     Unroll all loops and jumps to create a linear event sequence.
      */
-    void fillWallTimes(EventSequence& eventSequence);
+    std::unique_ptr<EventSequence> unroll(EventCursor& cursor);
 
     bool isTieStart(const mxml::dom::Note& note);
     bool isTieStop(const mxml::dom::Note& note);
 
 private:
+    std::size_t _threads;
     std::size_t _startMeasureIndex;
     std::size_t _endMeasureIndex;
 
@@ -73,8 +123,16 @@ private:
     dom::time_t _measureStartTime;
     dom::time_t _time;
 
-    using MapKeyType = std::pair<std::size_t, dom::time_t>;
-    std::map<MapKeyType, Event> _events;
+    std::vector<Record> _records;
+    std::vector<dom::time_t> _lastTimes;
+
+    // Once the records are sorted, the records of a measure start at the index for that measure
+    std::vector<std::size_t> _measureRecords;
+
+    // Sorted by measure location, the events of a measure start at the index for that measure
+    std::vector<Event> _events;
+    std::vector<std::size_t> _measureEvents;
+    std::unique_ptr<EventNotes> _notes;
 };
 
 } // namespace mxml
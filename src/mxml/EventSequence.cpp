@@ -11,30 +11,48 @@
 
 namespace mxml {
 
-EventSequence::EventSequence(const ScoreProperties& scoreProperties) : _scoreProperties(scoreProperties) {
+EventSequence::EventSequence(const ScoreProperties& scoreProperties) : _scoreProperties(scoreProperties), _notes(new EventNotes()) {
     
 }
 
 Event& EventSequence::addEvent(const Event& event) {
     auto it = std::lower_bound(_events.begin(), _events.end(), event);
     if (it != _events.end() && it->absoluteTime() == event.absoluteTime()) {
-        auto& oldEvent = *it;
-
         // Event already exists, merge
-        oldEvent.setMeasureIndex(event.measureIndex());
-        oldEvent.setMeasureTime(event.measureTime());
-        oldEvent.setBeatMark(oldEvent.isBeatMark() || event.isBeatMark());
-        oldEvent.onNotes().insert(oldEvent.onNotes().end(), event.onNotes().begin(), event.onNotes().end());
-        oldEvent.offNotes().insert(oldEvent.offNotes().end(), event.offNotes().begin(), event.offNotes().end());
-
-        return oldEvent;
+        it->merge(event);
+        return *it;
     } else {
-        return *_events.insert(it, event);
+        auto& inserted = *_events.insert(it, event);
+        inserted.setNotes(*_notes);
+        return inserted;
+    }
+}
+
+EventSequence::Builder::Builder(const ScoreProperties& scoreProperties) : _sequence(new EventSequence(scoreProperties)) {
+}
+
+Event& EventSequence::Builder::add(Event&& event) {
+    auto& events = _sequence->_events;
+    if (events.empty() || events.back().absoluteTime() < event.absoluteTime()) {
+        events.push_back(std::move(event));
+        events.back().setNotes(*_sequence->_notes);
+        return events.back();
+    }
+    if (events.back().absoluteTime() == event.absoluteTime()) {
+        events.back().merge(event);
+        return events.back();
     }
+    return _sequence->addEvent(event);
+}
+
+std::unique_ptr<EventSequence> EventSequence::Builder::finish() {
+    return std::move(_sequence);
 }
 
 void EventSequence::clear() {
     _events.clear();
+    _notes->onNotes.clear();
+    _notes->offNotes.clear();
 }
 
 dom::time_t EventSequence::startTime() const {
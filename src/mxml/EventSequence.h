@@ -9,6 +9,7 @@
 #include <mxml/dom/Sound.h>
 #include <mxml/ScoreProperties.h>
 
+#include <memory>
 #include <set>
 #include <vector>
 
@@ -18,10 +19,45 @@ class EventSequence {
 public:
     using ConstIterator = std::vector<Event>::const_iterator;
     using Iterator = std::vector<Event>::iterator;
-    
+
+    /**
+     Builds a sequence from events added in nondecreasing absolute time. Events with the same absolute time as the last
+     one are merged into it in place, every other event is appended, so building a sequence of N events is O(N). An event
+     earlier than the last one is still accepted but inserted like addEvent does.
+     */
+    class Builder {
+    public:
+        explicit Builder(const ScoreProperties& scoreProperties);
+
+        void reserve(std::size_t count) {
+            _sequence->_events.reserve(count);
+        }
+        void reserveNotes(std::size_t onCount, std::size_t offCount) {
+            _sequence->_notes->onNotes.reserve(onCount);
+            _sequence->_notes->offNotes.reserve(offCount);
+        }
+
+        Event& add(Event&& event);
+        Event& add(const Event& event) {
+            return add(Event(event));
+        }
+
+        /**
+         Return the built sequence, the builder can't be used afterwards.
+         */
+        std::unique_ptr<EventSequence> finish();
+
+    private:
+        std::unique_ptr<EventSequence> _sequence;
+    };
+
 public:
     EventSequence(const ScoreProperties& scoreProperties);
-    
+
+    /**
+     Add an event at its absolute time, merging it with an existing event at the same time. Use a Builder to add many
+     events in order. The event's notes are copied to the sequence's note pools.
+     */
     Event& addEvent(const Event& event);
     void clear();
 
@@ -89,6 +125,7 @@ public:
 private:
     const ScoreProperties& _scoreProperties;
     std::vector<Event> _events;
+    std::unique_ptr<EventNotes> _notes;
 
     friend class EventFactory;
 };
@@ -19,9 +19,8 @@ std::vector<Jump> JumpFactory::build() {
         std::size_t measureIndex = 0;
         for (auto& measure : part->measures()) {
             for (auto& node : measure->nodes()) {
-                if (auto direction = dynamic_cast<const dom::Direction*>(node.get())) {
-                    process(measureIndex, *direction);
-                }
+                if (node->kind() == dom::Node::Kind::Direction)
+                    process(measureIndex, static_cast<const dom::Direction&>(*node));
             }
             measureIndex += 1;
         }
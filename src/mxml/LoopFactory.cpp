@@ -25,8 +25,8 @@ std::vector<Loop> LoopFactory::build() {
         for (auto& measure : part->measures()) {
             assert(measure->index() == measureIndex);
             for (auto& node : measure->nodes()) {
-                if (const dom::Barline* barline = dynamic_cast<const dom::Barline*>(node.get()))
-                    process(measureIndex, *barline);
+                if (node->kind() == dom::Node::Kind::Barline)
+                    process(measureIndex, static_cast<const dom::Barline&>(*node));
             }
             measureIndex += 1;
         }
@@ -0,0 +1,54 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "MappedFile.h"
+
+#include <cerrno>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace mxml {
+
+MappedFile::MappedFile(const std::string& path) : _data(nullptr), _size(0) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::system_error(errno, std::generic_category(), path);
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        auto error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), path);
+    }
+
+    // Empty files can't be mapped, they are represented by an empty range
+    _size = static_cast<std::size_t>(info.st_size);
+    if (_size > 0) {
+        auto data = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            auto error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), path);
+        }
+        ::madvise(data, _size, MADV_SEQUENTIAL);
+        _data = static_cast<const char*>(data);
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    ::close(fd);
+}
+
+MappedFile::~MappedFile() {
+    if (_data)
+        ::munmap(const_cast<char*>(_data), _size);
+}
+
+} // namespace mxml
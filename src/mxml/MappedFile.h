@@ -0,0 +1,37 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+#include <cstddef>
+#include <string>
+
+
+namespace mxml {
+
+/**
+ Read-only memory mapping of a whole file. Throws std::system_error if the file cannot be opened or mapped.
+ */
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const {
+        return _data;
+    }
+    std::size_t size() const {
+        return _size;
+    }
+
+private:
+    const char* _data;
+    std::size_t _size;
+};
+
+} // namespace mxml
@@ -10,63 +10,27 @@ namespace mxml {
 
 PageMetrics::PageMetrics(const dom::Score& score, const ScoreProperties& scoreProperties, std::size_t systemIndex, std::size_t partIndex)
 : Metrics(score, scoreProperties, partIndex),
-  _systemIndex(systemIndex)
+  _systemIndex(systemIndex),
+  _systemDistance(80),
+  _staffDistance(65)
 {
-}
-
-dom::tenths_t PageMetrics::systemDistance() const {
-    dom::tenths_t distance = 80;
-
-    // Get default system distance from the `defaults` element
+    // Get default distances from the `defaults` element
     auto& defaults = _score.defaults();
     if (defaults) {
         if (defaults->systemLayout) {
             auto& systemLayout = defaults->systemLayout.value();
             if (systemLayout.systemDistance)
-                distance = systemLayout.systemDistance;
-        }
-    }
-
-    for (auto& ref : _prints) {
-        if (ref.systemIndex < _systemIndex)
-            continue;
-        if (ref.systemIndex > _systemIndex)
-            break;
-
-        auto& print = *ref.print;
-        if (print.systemLayout) {
-            auto& systemLayout = print.systemLayout.value();
-            if (systemLayout.systemDistance)
-                distance = systemLayout.systemDistance;
+                _systemDistance = systemLayout.systemDistance;
         }
-    }
-
-    return distance;
-}
-
-dom::tenths_t PageMetrics::staffDistance() const {
-    dom::tenths_t distance = 65;
-
-    // Get default staff distance from the `defaults` element
-    auto& defaults = _score.defaults();
-    if (defaults) {
         if (defaults->staffDistance())
-            distance = defaults->staffDistance();
-    }
-
-    for (auto& ref : _prints) {
-        if (ref.systemIndex < _systemIndex)
-            continue;
-        if (ref.systemIndex > _systemIndex)
-            break;
-
-        auto& print = *ref.print;
-        if (print.staffDistance()) {
-            distance = print.staffDistance();
-        }
+            _staffDistance = defaults->staffDistance();
     }
 
-    return distance;
+    auto& printLayout = _scoreProperties.printLayout(partIndex, systemIndex);
+    if (printLayout.systemDistance)
+        _systemDistance = printLayout.systemDistance;
+    if (printLayout.staffDistance)
+        _staffDistance = printLayout.staffDistance;
 }
 
 }
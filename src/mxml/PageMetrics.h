@@ -10,6 +10,10 @@
 
 namespace mxml {
 
+/**
+ Metrics of a part in a single system of a page layout. The print layout of every system is collected by
+ ScoreProperties, so constructing page metrics does not walk the part.
+ */
 class PageMetrics : public Metrics {
 public:
     PageMetrics(const dom::Score& score, const ScoreProperties& scoreProperties, std::size_t systemIndex, std::size_t partIndex);
@@ -21,15 +25,21 @@ public:
     /**
      Get the vertical distance between the system and the previous system.
      */
-    dom::tenths_t systemDistance() const;
+    dom::tenths_t systemDistance() const {
+        return _systemDistance;
+    }
 
     /**
      Get the distance between the first and second staves.
      */
-    dom::tenths_t staffDistance() const;
+    dom::tenths_t staffDistance() const {
+        return _staffDistance;
+    }
 
 private:
     std::size_t _systemIndex;
+    dom::tenths_t _systemDistance;
+    dom::tenths_t _staffDistance;
 };
     
 } // namespace mxml
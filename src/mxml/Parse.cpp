@@ -0,0 +1,264 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Parse.h"
+#include "MappedFile.h"
+#include "ScoreSnapshot.h"
+#include "ZipArchive.h"
+
+#include <mxml/dom/Arena.h>
+#include <mxml/dom/InvalidDataError.h>
+#include <mxml/dom/StringTable.h>
+#include <mxml/parsing/ContainerHandler.h>
+#include <mxml/parsing/PartScanner.h>
+#include <mxml/parsing/ScoreHandler.h>
+#include <lxml/lxml.h>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <istream>
+#include <sstream>
+#include <streambuf>
+#include <system_error>
+#include <thread>
+
+
+namespace mxml {
+
+namespace {
+
+const char* kContainerPath = "META-INF/container.xml";
+
+bool endsWith(const std::string& string, const std::string& suffix) {
+    return string.size() >= suffix.size() && string.compare(string.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+/**
+ Input stream buffer over memory owned by someone else. The whole range is exposed as the get area so reads come
+ straight from the memory without an intermediate buffer.
+ */
+class MemoryBuffer : public std::streambuf {
+public:
+    MemoryBuffer(const char* data, std::size_t size) {
+        auto begin = const_cast<char*>(data);
+        setg(begin, begin, begin + size);
+    }
+
+protected:
+    pos_type seekoff(off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode which) {
+        if (!(which & std::ios_base::in))
+            return pos_type(off_type(-1));
+
+        char* position;
+        if (direction == std::ios_base::beg)
+            position = eback() + offset;
+        else if (direction == std::ios_base::cur)
+            position = gptr() + offset;
+        else
+            position = egptr() + offset;
+
+        if (position < eback() || position > egptr())
+            return pos_type(off_type(-1));
+
+        setg(eback(), position, egptr());
+        return pos_type(position - eback());
+    }
+
+    pos_type seekpos(pos_type position, std::ios_base::openmode which) {
+        return seekoff(off_type(position), std::ios_base::beg, which);
+    }
+};
+
+std::size_t threadCount(const ParseOptions& options) {
+    if (options.threads != 0)
+        return options.threads;
+    return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+}
+
+std::unique_ptr<dom::Score> parseSequential(const char* data, std::size_t size, const std::string& name, const ParseOptions& options) {
+    MemoryBuffer buffer(data, size);
+    std::istream is(&buffer);
+
+    parsing::ScoreHandler handler;
+    handler.setUseArena(options.useArena);
+    handler.setMeasureSink(options.measureSink);
+    handler.setProfile(options.profile);
+    lxml::parse(is, name, handler);
+    return handler.result();
+}
+
+/**
+ Parse the parts of a score-partwise document concurrently. Everything outside the parts is parsed first on the calling
+ thread, then the parts are handed out to the workers one at a time and attached to the score in document order.
+ */
+std::unique_ptr<dom::Score> parseParallel(const char* data, const std::string& name, const parsing::PartScanner& scanner, std::size_t threads, const ParseOptions& options) {
+    const auto skeleton = scanner.skeleton();
+    std::istringstream is(skeleton);
+    parsing::ScoreHandler handler;
+    handler.setUseArena(options.useArena);
+    handler.setProfile(options.profile);
+    lxml::parse(is, name, handler);
+    auto score = handler.result();
+
+    const auto& ranges = scanner.parts();
+    threads = std::min(threads, ranges.size());
+
+    // Arenas and string tables are not thread safe, every worker uses its own and the score takes them over at the end.
+    // They are declared before the parts so that the parts are destroyed first if anything fails.
+    std::vector<std::unique_ptr<dom::Arena>> arenas(threads);
+    if (options.useArena) {
+        for (auto& arena : arenas)
+            arena.reset(new dom::Arena());
+    }
+    std::vector<std::unique_ptr<dom::StringTable>> strings(threads);
+    for (auto& table : strings)
+        table.reset(new dom::StringTable());
+
+    std::vector<std::unique_ptr<dom::Part>> parts(ranges.size());
+    std::vector<std::exception_ptr> errors(ranges.size());
+    std::atomic<std::size_t> next(0);
+
+    auto work = [&](std::size_t worker) {
+        auto previousArena = dom::Arena::setCurrent(arenas[worker].get());
+        auto previousStrings = dom::StringTable::setCurrent(strings[worker].get());
+        parsing::PartHandler partHandler;
+        partHandler.setProfile(options.profile);
+        for (auto index = next++; index < ranges.size(); index = next++) {
+            try {
+                MemoryBuffer buffer(data + ranges[index].begin, ranges[index].end - ranges[index].begin);
+                std::istream is(&buffer);
+                lxml::parse(is, name, partHandler);
+                parts[index] = partHandler.result();
+            } catch (...) {
+                errors[index] = std::current_exception();
+            }
+        }
+        dom::StringTable::setCurrent(previousStrings);
+        dom::Arena::setCurrent(previousArena);
+    };
+
+    std::vector<std::thread> workers;
+    for (std::size_t worker = 1; worker < threads; worker += 1) {
+        try {
+            workers.emplace_back(work, worker);
+        } catch (const std::system_error&) {
+            // Fewer workers only make it slower
+            break;
+        }
+    }
+    work(0);
+    for (auto& worker : workers)
+        worker.join();
+
+    for (auto& error : errors) {
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    if (score->arena()) {
+        for (auto& arena : arenas)
+            score->arena()->absorb(*arena);
+    }
+    for (auto& table : strings)
+        score->strings()->absorb(*table);
+
+    for (std::size_t index = 0; index < parts.size(); index += 1) {
+        auto& part = parts[index];
+        part->setParent(score.get());
+        part->setIndex(index);
+        score->addPart(std::move(part));
+    }
+    return score;
+}
+
+/**
+ Find the MusicXML document in a compressed archive. The container file names it, archives without one use the first
+ MusicXML file outside of META-INF.
+ */
+const ZipArchive::Entry& rootFile(const ZipArchive& archive, const std::string& name) {
+    if (auto container = archive.find(kContainerPath)) {
+        auto buffer = archive.open(*container);
+        std::istream is(buffer.get());
+        is.exceptions(std::ios_base::badbit);
+
+        parsing::ContainerHandler handler;
+        lxml::parse(is, name + "/" + kContainerPath, handler);
+        auto path = handler.result();
+        if (auto entry = archive.find(path))
+            return *entry;
+        throw dom::InvalidDataError("Root file " + path + " not found in " + name);
+    }
+
+    for (auto& entry : archive.entries()) {
+        if (entry.name.compare(0, 9, "META-INF/") == 0)
+            continue;
+        if (endsWith(entry.name, ".xml") || endsWith(entry.name, ".musicxml"))
+            return entry;
+    }
+    throw dom::InvalidDataError("No MusicXML document in " + name);
+}
+
+/**
+ Parse a compressed MusicXML archive. The root file is inflated in chunks while the parser reads it, the decompressed
+ document is never held in memory as a whole.
+ */
+std::unique_ptr<dom::Score> parseArchive(const char* data, std::size_t size, const std::string& name, const ParseOptions& options) {
+    ZipArchive archive(data, size);
+    const auto& entry = rootFile(archive, name);
+
+    auto buffer = archive.open(entry);
+    std::istream is(buffer.get());
+    is.exceptions(std::ios_base::badbit);
+
+    parsing::ScoreHandler handler;
+    handler.setUseArena(options.useArena);
+    handler.setMeasureSink(options.measureSink);
+    handler.setProfile(options.profile);
+    lxml::parse(is, name + "/" + entry.name, handler);
+    return handler.result();
+}
+
+/**
+ Load a score snapshot. Measures are streamed after the whole score is loaded, in the same order as when parsing a
+ score-partwise document.
+ */
+std::unique_ptr<dom::Score> parseSnapshot(const char* data, std::size_t size, const ParseOptions& options) {
+    auto score = readSnapshot(data, size, options.useArena);
+    if (options.measureSink) {
+        parsing::MeasureAttributes attributes;
+        for (auto& part : score->parts()) {
+            attributes.reset();
+            for (auto& measure : part->measures())
+                parsing::streamMeasure(options.measureSink, part->index(), *measure, attributes);
+        }
+    }
+    return score;
+}
+
+} // namespace
+
+std::unique_ptr<dom::Score> parseFile(const std::string& path, const ParseOptions& options) {
+    MappedFile file(path);
+    return parseBuffer(file.data(), file.size(), path, options);
+}
+
+std::unique_ptr<dom::Score> parseBuffer(const char* data, std::size_t size, const std::string& name, const ParseOptions& options) {
+    if (ZipArchive::isArchive(data, size))
+        return parseArchive(data, size, name, options);
+    if (isSnapshot(data, size))
+        return parseSnapshot(data, size, options);
+
+    const auto threads = threadCount(options);
+    if (threads > 1 && !options.measureSink) {
+        parsing::PartScanner scanner;
+        if (scanner.scan(data, size) && scanner.parts().size() > 1)
+            return parseParallel(data, name, scanner, threads, options);
+    }
+    return parseSequential(data, size, name, options);
+}
+
+} // namespace mxml
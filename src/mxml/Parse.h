@@ -0,0 +1,59 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+#include <mxml/dom/Score.h>
+#include <mxml/parsing/MeasureSink.h>
+#include <mxml/parsing/Profile.h>
+
+#include <memory>
+#include <string>
+
+
+namespace mxml {
+
+struct ParseOptions {
+    ParseOptions() : useArena(false), threads(1), measureSink(), profile(parsing::Profile::Full) {}
+
+    /**
+     Allocate the nodes of the score from an arena owned by the score, see ScoreHandler::setUseArena.
+     */
+    bool useArena;
+
+    /**
+     Number of threads used to parse the parts of a score-partwise document. With more than one thread the document is
+     split at its parts, which are parsed concurrently, the resulting score is the same as with a single thread. Use 0 for
+     one thread per hardware core.
+     */
+    std::size_t threads;
+
+    /**
+     Stream measures to a callback while the document is being parsed, see parsing::MeasureSink. Streaming always
+     parses on the calling thread, in document order.
+     */
+    parsing::MeasureSink measureSink;
+
+    /**
+     Only build the parts of the score that a workload needs, see parsing::Profile. Score snapshots are loaded as they
+     were written.
+     */
+    parsing::Profile profile;
+};
+
+/**
+ Parse a MusicXML file. The file is memory mapped and the parser reads directly from the mapped pages instead of going
+ through a file stream. Compressed MusicXML (.mxl) files are recognized by their contents and inflated while they are
+ parsed, score snapshots written with writeSnapshot are loaded without any XML parsing.
+ */
+std::unique_ptr<dom::Score> parseFile(const std::string& path, const ParseOptions& options = ParseOptions());
+
+/**
+ Parse MusicXML, compressed MusicXML or a score snapshot from a buffer in memory. The buffer is not copied, it has to stay valid until the
+ function returns.
+ */
+std::unique_ptr<dom::Score> parseBuffer(const char* data, std::size_t size, const std::string& name, const ParseOptions& options = ParseOptions());
+
+} // namespace mxml
@@ -8,7 +8,29 @@
 
 namespace mxml {
 
-ScoreBuilder::ScoreBuilder() : _score(new dom::Score{}) {
+ScoreBuilder::ScoreBuilder()
+: _score(new dom::Score{}),
+  _strings(std::make_shared<dom::StringTable>()),
+  _previousStrings(),
+  _stringsCurrent(true)
+{
+    _score->setStrings(_strings);
+    _previousStrings = dom::StringTable::setCurrent(_strings.get());
+}
+
+ScoreBuilder::~ScoreBuilder() {
+    endStrings();
+}
+
+void ScoreBuilder::endStrings() {
+    if (!_stringsCurrent)
+        return;
+
+    // Leave the current table alone if someone else changed it since
+    if (dom::StringTable::current() == _strings.get())
+        dom::StringTable::setCurrent(_previousStrings);
+    _previousStrings = nullptr;
+    _stringsCurrent = false;
 }
 
 dom::Part* ScoreBuilder::addPart() {
@@ -63,6 +85,29 @@ dom::Clef* ScoreBuilder::setBassClef(dom::Attributes* attributes, int staff) {
     return attributes->clef(staff);
 }
 
+dom::Direction* ScoreBuilder::addDirection(dom::Measure* measure, dom::time_t start) {
+    auto direction = std::unique_ptr<dom::Direction>(new dom::Direction{});
+    auto raw = direction.get();
+    direction->setStart(start);
+    measure->addNode(std::move(direction));
+    return raw;
+}
+
+dom::Print* ScoreBuilder::addPrint(dom::Measure* measure, bool newSystem) {
+    auto print = std::unique_ptr<dom::Print>(new dom::Print{});
+    auto raw = print.get();
+    print->newSystem = newSystem;
+    measure->addNode(std::move(print));
+    return raw;
+}
+
+dom::Sound* ScoreBuilder::setSound(dom::Direction* direction) {
+    auto sound = std::unique_ptr<dom::Sound>(new dom::Sound{});
+    sound->setParent(direction);
+    direction->setSound(std::move(sound));
+    return direction->sound().get();
+}
+
 dom::Chord* ScoreBuilder::addChord(dom::Measure* measure) {
     auto chord = std::unique_ptr<dom::Chord>(new dom::Chord{});
     auto raw = chord.get();
@@ -165,6 +210,7 @@ dom::Ornaments* ScoreBuilder::addTurn(dom::Note* note, bool slash) {
 }
 
 std::unique_ptr<dom::Score> ScoreBuilder::build() {
+    endStrings();
     return std::move(_score);
 }
 
@@ -7,18 +7,27 @@
 #pragma once
 #include <mxml/dom/Attributes.h>
 #include <mxml/dom/Chord.h>
+#include <mxml/dom/Direction.h>
 #include <mxml/dom/Score.h>
 #include <mxml/dom/Note.h>
 #include <mxml/dom/Ornaments.h>
+#include <mxml/dom/Print.h>
 #include <mxml/dom/Types.h>
 #include <memory>
 
 
 namespace mxml {
 
+/**
+ Builds a score node by node. Like a parse, the builder makes the score's string table current on its thread from
+ construction until build, so strings set on the nodes in between are interned in the score.
+ */
 class ScoreBuilder {
 public:
     ScoreBuilder();
+    ScoreBuilder(const ScoreBuilder&) = delete;
+    ScoreBuilder& operator=(const ScoreBuilder&) = delete;
+    ~ScoreBuilder();
 
     dom::Part* addPart();
     dom::Measure* addMeasure(dom::Part* part);
@@ -29,6 +38,10 @@ public:
     dom::Clef* setTrebleClef(dom::Attributes* attributes, int staff = 1);
     dom::Clef* setBassClef(dom::Attributes* attributes, int staff = 2);
 
+    dom::Direction* addDirection(dom::Measure* measure, dom::time_t start = 0);
+    dom::Print* addPrint(dom::Measure* measure, bool newSystem = false);
+    dom::Sound* setSound(dom::Direction* direction);
+
     dom::Chord* addChord(dom::Measure* measure);
     dom::Note* addNote(dom::Chord* chord, dom::Note::Type type = dom::Note::Type::Eighth, dom::time_t start = 0, dom::time_t duration = 1);
     dom::Note* addNote(dom::Measure* measure, dom::Note::Type type = dom::Note::Type::Eighth, dom::time_t start = 0, dom::time_t duration = 1);
@@ -42,8 +55,14 @@ public:
 
     std::unique_ptr<dom::Score> build();
 
+private:
+    void endStrings();
+
 private:
     std::unique_ptr<dom::Score> _score;
+    std::shared_ptr<dom::StringTable> _strings;
+    dom::StringTable* _previousStrings;
+    bool _stringsCurrent;
 };
 
 }
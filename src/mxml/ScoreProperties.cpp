@@ -16,15 +16,24 @@
 
 namespace mxml {
 
+const std::size_t ScoreProperties::kNoLoop = static_cast<std::size_t>(-1);
+
 ScoreProperties::ScoreProperties(const dom::Score& score, LayoutType layoutType)
 : _sounds(),
+  // Default dynamics loosely based of a MIDI value of 80 (80/127 ~= 0.65)
+  _dynamicsMap(65.0),
+  _octaveShiftMap(0),
   _loops(),
   _jumps(),
+  _measureLoops(),
+  _measureJumps(),
+  _measureJumpBegins(),
   _staves(0),
   _measureCount(0),
   _layoutType(layoutType)
 {
     _staves.resize(score.parts().size(), 0);
+    _printLayouts.resize(score.parts().size(), std::vector<PrintLayout>(1));
     _systemBeginsSet.insert(0);
     _pageBeginsSet.insert(0);
 
@@ -47,11 +56,34 @@ ScoreProperties::ScoreProperties(const dom::Score& score, LayoutType layoutType)
     _divisionsSequence.sort();
     _alterSequence.sort();
 
+    for (auto& ref : _sounds) {
+        if (ref.sound->tempo.isPresent())
+            _tempoMap.addTempo(ref.measureIndex, ref.time, ref.sound->tempo.value());
+        if (ref.sound->dynamics.isPresent())
+            _dynamicsMap.add(ref.partIndex, ref.staff, ref.measureIndex, ref.time, ref.sound->dynamics.value());
+    }
+    _tempoMap.build(*this);
+    _dynamicsMap.build(_staves);
+
+    for (auto& ref : _directions) {
+        auto type = ref.direction->type();
+        if (!type || type->kind() != dom::Node::Kind::OctaveShift)
+            continue;
+        auto octaveShift = static_cast<const dom::OctaveShift*>(type);
+
+        int shift = 0;
+        if (octaveShift->type != dom::OctaveShift::Type::Stop && octaveShift->size != 0)
+            shift = (octaveShift->type == dom::OctaveShift::Type::Down ? -1: 1) * (octaveShift->size - 1);
+        _octaveShiftMap.add(ref.partIndex, ref.staff, ref.measureIndex, ref.time, shift);
+    }
+    _octaveShiftMap.build(_staves);
+
     LoopFactory loopFactory(score);
     _loops = loopFactory.build();
 
     JumpFactory jumpFactory(score);
     _jumps = jumpFactory.build();
+    buildLoopTables();
 
     _systemBegins.insert(_systemBegins.end(), _systemBeginsSet.begin(), _systemBeginsSet.end());
     _pageBegins.insert(_pageBegins.end(), _pageBeginsSet.begin(), _pageBeginsSet.end());
@@ -60,14 +92,22 @@ ScoreProperties::ScoreProperties(const dom::Score& score, LayoutType layoutType)
 void ScoreProperties::process(std::size_t partIndex, const dom::Measure& measure) {
     auto measureIndex = measure.index();
     for (auto& node : measure.nodes()) {
-        if (auto attributes = dynamic_cast<const dom::Attributes*>(node.get()))
-            process(partIndex, measureIndex, *attributes);
-        else if (auto chord = dynamic_cast<const dom::Chord*>(node.get()))
-            process(partIndex, measureIndex, *chord);
-        else if (auto direction = dynamic_cast<const dom::Direction*>(node.get()))
-            process(partIndex, measureIndex, *direction);
-        else if (auto print = dynamic_cast<const dom::Print*>(node.get()))
-            process(partIndex, measureIndex, *print);
+        switch (node->kind()) {
+            case dom::Node::Kind::Attributes:
+                process(partIndex, measureIndex, static_cast<const dom::Attributes&>(*node));
+                break;
+            case dom::Node::Kind::Chord:
+                process(partIndex, measureIndex, static_cast<const dom::Chord&>(*node));
+                break;
+            case dom::Node::Kind::Direction:
+                process(partIndex, measureIndex, static_cast<const dom::Direction&>(*node));
+                break;
+            case dom::Node::Kind::Print:
+                process(partIndex, measureIndex, static_cast<const dom::Print&>(*node));
+                break;
+            default:
+                break;
+        }
     }
 }
 
@@ -110,6 +150,16 @@ void ScoreProperties::process(std::size_t partIndex, std::size_t measureIndex, c
         _systemBeginsSet.insert(measureIndex);
     if (print.newPage)
         _pageBeginsSet.insert(measureIndex);
+
+    auto& layouts = _printLayouts[partIndex];
+    if (print.newSystem && measureIndex != 0)
+        layouts.emplace_back();
+
+    auto& layout = layouts.back();
+    if (print.systemLayout && print.systemLayout.value().systemDistance)
+        layout.systemDistance = print.systemLayout.value().systemDistance;
+    if (print.staffDistance())
+        layout.staffDistance = print.staffDistance();
 }
 
 void ScoreProperties::process(std::size_t partIndex, std::size_t measureIndex, const dom::Chord& chord) {
@@ -162,17 +212,6 @@ int ScoreProperties::alter(const dom::Note& note) const {
     return _alterSequence.find(AlterSequence::indexFromNote(note), base);
 }
 
-float ScoreProperties::tempo(std::size_t measureIndex, dom::time_t time) const {
-    float current = 60.0;
-    for (auto& ref : _sounds) {
-        if (ref.measureIndex > measureIndex || (ref.measureIndex == measureIndex && ref.time > time))
-            return current;
-        if (ref.sound->tempo.isPresent())
-            current = ref.sound->tempo.value();
-    }
-    return current;
-}
-
 float ScoreProperties::dynamics(const dom::Note& note) const {
     if (note.dynamics().isPresent() && note.dynamics().value() > 0)
         return note.dynamics();
@@ -182,60 +221,78 @@ float ScoreProperties::dynamics(const dom::Note& note) const {
     return dynamics(part->index(), measure->index(), note.staff(), note.start());
 }
 
-float ScoreProperties::dynamics(std::size_t partIndex, std::size_t measureIndex, int staff, dom::time_t time) const {
-    // Current value loosely based of a MIDI value of 80 (80/127 ~= 0.65)
-    float current = 65.0;
-    for (auto& ref : _sounds) {
-        if (ref.measureIndex > measureIndex || (ref.measureIndex == measureIndex && ref.time > time))
-            return current;
-
-        if (ref.staff.isPresent() && ref.staff != staff)
-            continue;
-        if (ref.partIndex == partIndex && ref.sound->dynamics.isPresent())
-            current = ref.sound->dynamics.value();
+void ScoreProperties::dynamics(const dom::Part& part, std::size_t beginMeasureIndex, std::size_t endMeasureIndex, const std::function<void (const dom::Note& note, float dynamics)>& f) const {
+    StaffMap<float>::Cursor cursor(_dynamicsMap, part.index());
+
+    const auto& measures = part.measures();
+    endMeasureIndex = std::min(endMeasureIndex, measures.size());
+    for (auto measureIndex = beginMeasureIndex; measureIndex < endMeasureIndex; measureIndex += 1) {
+        cursor.seek(measureIndex);
+
+        auto resolve = [&](const dom::Note& note) {
+            if (note.dynamics().isPresent() && note.dynamics().value() > 0)
+                f(note, note.dynamics());
+            else
+                f(note, cursor.find(note.staff(), note.start()));
+        };
+
+        for (auto& node : measures[measureIndex]->nodes()) {
+            if (node->kind() == dom::Node::Kind::Chord) {
+                for (auto& note : static_cast<const dom::Chord&>(*node).notes())
+                    resolve(*note);
+            } else if (node->kind() == dom::Node::Kind::Note) {
+                resolve(static_cast<const dom::Note&>(*node));
+            }
+        }
     }
-    return current;
 }
 
-const Loop* ScoreProperties::loop(std::size_t measureIndex) const {
-    auto it = std::find_if(_loops.begin(), _loops.end(), [&](const Loop& loop) {
-        return loop.begin() <= measureIndex && loop.end() > measureIndex;
+void ScoreProperties::buildLoopTables() {
+    // Loops may end past the last measure
+    auto loopMeasureCount = _measureCount;
+    for (auto& loop : _loops)
+        loopMeasureCount = std::max(loopMeasureCount, loop.end());
+
+    // When loops overlap the first one wins
+    _measureLoops.assign(loopMeasureCount, kNoLoop);
+    for (std::size_t loopIndex = 0; loopIndex < _loops.size(); loopIndex += 1) {
+        auto& loop = _loops[loopIndex];
+        for (auto measureIndex = loop.begin(); measureIndex < loop.end(); measureIndex += 1) {
+            if (_measureLoops[measureIndex] == kNoLoop)
+                _measureLoops[measureIndex] = loopIndex;
+        }
+    }
+
+    // A jump is taken when reaching the measure after the one it is from
+    auto jumpMeasureCount = _measureCount;
+    for (auto& jump : _jumps)
+        jumpMeasureCount = std::max(jumpMeasureCount, jump.from + 2);
+
+    _measureJumps = _jumps;
+    std::stable_sort(_measureJumps.begin(), _measureJumps.end(), [](const Jump& lhs, const Jump& rhs) {
+        return lhs.from < rhs.from;
     });
-    if (it == _loops.end())
-        return nullptr;
-    return &*it;
-}
 
-std::vector<Jump> ScoreProperties::jumps(std::size_t measureIndex) const {
-    std::vector<Jump> jumps;
-    for (auto& jump : _jumps) {
-        if (jump.from + 1 == measureIndex)
-            jumps.push_back(jump);
-    }
-    return jumps;
+    _measureJumpBegins.assign(jumpMeasureCount + 1, 0);
+    for (auto& jump : _measureJumps)
+        _measureJumpBegins[jump.from + 2] += 1;
+    std::partial_sum(_measureJumpBegins.begin(), _measureJumpBegins.end(), _measureJumpBegins.begin());
 }
 
-int ScoreProperties::octaveShift(std::size_t partIndex, std::size_t measureIndex, int staff, dom::time_t time) const {
-    int current = 0;
-    for (auto& ref : _directions) {
-        if (ref.measureIndex > measureIndex || (ref.measureIndex == measureIndex && ref.time > time))
-            return current;
+std::vector<int> ScoreProperties::octaveShifts(const dom::Measure& measure) const {
+    StaffMap<int>::Cursor cursor(_octaveShiftMap, measure.part()->index());
+    cursor.seek(measure.index());
 
-        if (ref.staff.isPresent() && ref.staff != staff)
-            continue;
-        if (ref.partIndex != partIndex)
+    std::vector<int> shifts;
+    for (auto& node : measure.nodes()) {
+        if (node->kind() != dom::Node::Kind::Chord)
             continue;
-
-        auto octaveShift = dynamic_cast<const dom::OctaveShift*>(ref.direction->type());
-        if (!octaveShift)
+        auto chord = static_cast<const dom::Chord*>(node.get());
+        if (chord->empty())
             continue;
-
-        if (octaveShift->type == dom::OctaveShift::Type::Stop || octaveShift->size == 0)
-            current = 0;
-        else
-            current = (octaveShift->type == dom::OctaveShift::Type::Down ? -1: 1) * (octaveShift->size - 1);
+        shifts.push_back(cursor.find(chord->firstNote()->staff(), chord->start()));
     }
-    return current;
+    return shifts;
 }
 
 std::size_t ScoreProperties::systemIndex(std::size_t measureIndex) const {
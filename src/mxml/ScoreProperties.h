@@ -12,6 +12,8 @@
 #include "attributes/TimeSequence.h"
 #include "Jump.h"
 #include "Loop.h"
+#include "StaffMap.h"
+#include "TempoMap.h"
 
 #include <mxml/dom/Attributes.h>
 #include <mxml/dom/Direction.h>
@@ -20,6 +22,7 @@
 #include <mxml/dom/Sound.h>
 
 #include <algorithm>
+#include <functional>
 #include <map>
 #include <set>
 #include <vector>
@@ -35,6 +38,28 @@ namespace dom {
 
 class ScoreProperties {
 public:
+    struct PrintLayout {
+        dom::Optional<dom::tenths_t> systemDistance;
+        dom::Optional<dom::tenths_t> staffDistance;
+    };
+
+    /**
+     Contiguous range of jumps, iterating it does not allocate.
+     */
+    class JumpRange {
+    public:
+        JumpRange(const Jump* begin, const Jump* end) : _begin(begin), _end(end) {}
+
+        const Jump* begin() const { return _begin; }
+        const Jump* end() const { return _end; }
+        std::size_t size() const { return static_cast<std::size_t>(_end - _begin); }
+        bool empty() const { return _begin == _end; }
+
+    private:
+        const Jump* _begin;
+        const Jump* _end;
+    };
+
     enum class LayoutType : int {
         Scroll,
         Page
@@ -116,30 +141,62 @@ public:
     /**
      Get the tempo at the given measure and time.
      */
-    float tempo(std::size_t measureIndex, dom::time_t time) const;
+    float tempo(std::size_t measureIndex, dom::time_t time) const {
+        return _tempoMap.tempo(measureIndex, time);
+    }
+
+    /**
+     Get the tempo map, use it to convert between measure locations and seconds.
+     */
+    const TempoMap& tempoMap() const {
+        return _tempoMap;
+    }
 
     /**
      Get the dynamics for the given note.
      */
     float dynamics(const dom::Note& note) const;
 
+    /**
+     Get the dynamics for every note of a part in the given measure range in a single forward sweep. The function is
+     called once for every note, in measure order.
+     */
+    void dynamics(const dom::Part& part, std::size_t beginMeasureIndex, std::size_t endMeasureIndex, const std::function<void (const dom::Note& note, float dynamics)>& f) const;
+
     const std::vector<Loop>& loops() const { return _loops; }
     const std::vector<Jump>& jumps() const { return _jumps; }
 
     /**
      Get the loop that contains the given measure, if any.
      */
-    const Loop* loop(std::size_t measureIndex) const;
+    const Loop* loop(std::size_t measureIndex) const {
+        if (measureIndex >= _measureLoops.size() || _measureLoops[measureIndex] == kNoLoop)
+            return nullptr;
+        return &_loops[_measureLoops[measureIndex]];
+    }
 
     /**
-     Get the jumps from the given measure, if any.
+     Get the jumps taken when reaching the given measure, these are the jumps from the previous measure.
      */
-    std::vector<Jump> jumps(std::size_t measureIndex) const;
+    JumpRange jumps(std::size_t measureIndex) const {
+        if (measureIndex + 1 >= _measureJumpBegins.size())
+            return JumpRange(nullptr, nullptr);
+        const auto data = _measureJumps.data();
+        return JumpRange(data + _measureJumpBegins[measureIndex], data + _measureJumpBegins[measureIndex + 1]);
+    }
 
     /**
      Get the size of the octave shift for the given part, measure, staff and time.
      */
-    int octaveShift(std::size_t partIndex, std::size_t measureIndex, int staff, dom::time_t time) const;
+    int octaveShift(std::size_t partIndex, std::size_t measureIndex, int staff, dom::time_t time) const {
+        return _octaveShiftMap.find(partIndex, measureIndex, staff, time);
+    }
+
+    /**
+     Get the size of the octave shift for every chord in the given measure, in node order. Each chord uses the staff
+     of its first note.
+     */
+    std::vector<int> octaveShifts(const dom::Measure& measure) const;
 
     /**
      Get the system index for the given measure index.
@@ -164,6 +221,18 @@ public:
         return _pageBegins.size();
     }
 
+    /**
+     Get the layout set by print elements in a part for the given system. Systems are counted by the new-system print
+     elements of the part itself. Values that are not set by any print element in the system are not present.
+     */
+    const PrintLayout& printLayout(std::size_t partIndex, std::size_t systemIndex) const {
+        static const PrintLayout kEmptyLayout{};
+        auto& layouts = _printLayouts[partIndex];
+        if (systemIndex >= layouts.size())
+            return kEmptyLayout;
+        return layouts[systemIndex];
+    }
+
     /**
      Get the layout type for the score.
      */
@@ -176,7 +245,9 @@ private:
     /**
      Get the dynamics at the given part, measure, staff and time.
      */
-    float dynamics(std::size_t partIndex, std::size_t measureIndex, int staff, dom::time_t time) const;
+    float dynamics(std::size_t partIndex, std::size_t measureIndex, int staff, dom::time_t time) const {
+        return _dynamicsMap.find(partIndex, measureIndex, staff, time);
+    }
 
 protected:
     struct SoundRef {
@@ -252,6 +323,7 @@ protected:
     void process(std::size_t partIndex, std::size_t measureIndex, const dom::Direction& direction);
     void process(std::size_t partIndex, std::size_t measureIndex, const dom::Print& print);
     void process(std::size_t partIndex, std::size_t measureIndex, const dom::Chord& chord);
+    void buildLoopTables();
 
 private:
     std::set<DirectionRef> _directions;
@@ -262,9 +334,20 @@ private:
     TimeSequence _timeSequence;
     DivisionsSequence _divisionsSequence;
     AlterSequence _alterSequence;
+    TempoMap _tempoMap;
+    StaffMap<float> _dynamicsMap;
+    StaffMap<int> _octaveShiftMap;
 
     std::vector<Loop> _loops;
     std::vector<Jump> _jumps;
+
+    /// Index into _loops of the loop containing each measure, or kNoLoop
+    static const std::size_t kNoLoop;
+    std::vector<std::size_t> _measureLoops;
+
+    /// Jumps grouped by the measure they are taken at, _measureJumpBegins has one extra entry at the end
+    std::vector<Jump> _measureJumps;
+    std::vector<std::size_t> _measureJumpBegins;
     std::vector<int> _staves;
     std::size_t _measureCount;
 
@@ -272,6 +355,7 @@ private:
     std::vector<std::size_t> _systemBegins;
     std::set<std::size_t> _pageBeginsSet;
     std::vector<std::size_t> _pageBegins;
+    std::vector<std::vector<PrintLayout>> _printLayouts;
 
     const LayoutType _layoutType;
 };
@@ -0,0 +1,1335 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "ScoreSnapshot.h"
+
+#include <mxml/dom/Attributes.h>
+#include <mxml/dom/Backup.h>
+#include <mxml/dom/Barline.h>
+#include <mxml/dom/Bracket.h>
+#include <mxml/dom/Chord.h>
+#include <mxml/dom/Direction.h>
+#include <mxml/dom/Forward.h>
+#include <mxml/dom/InvalidDataError.h>
+#include <mxml/dom/OctaveShift.h>
+#include <mxml/dom/Pedal.h>
+#include <mxml/dom/Print.h>
+#include <mxml/dom/Tuplet.h>
+#include <mxml/dom/Wedge.h>
+
+#include <cstring>
+#include <limits>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+
+namespace mxml {
+
+using namespace dom;
+
+namespace {
+
+const char kMagic[] = {'M', 'X', 'M', 'L', 'S', 'N', 'A', 'P'};
+
+/**
+ Bump whenever the layout of the snapshot or of a serialized dom type changes.
+ */
+const std::uint32_t kVersion = 1;
+
+/**
+ Serializes a score into a flat little endian byte string. Nodes are written depth first with their children counted
+ up front, so that the reader can rebuild them in a single forward pass.
+ */
+class Writer {
+public:
+    explicit Writer(std::string& data) : _data(data) {}
+
+    void writeHeader() {
+        _data.append(kMagic, sizeof(kMagic));
+        write32(kVersion);
+    }
+    void writeScore(const Score& score);
+
+protected:
+    void writePart(const Part& part);
+    void writeMeasure(const Measure& measure);
+    void writeTimedNode(const TimedNode& node);
+    void writeAttributes(const Attributes& attributes);
+    void writeBarline(const Barline& barline);
+    void writeChord(const Chord& chord);
+    void writeDirection(const Direction& direction);
+    void writeDirectionType(const DirectionType& type);
+    void writeNote(const Note& note);
+    void writeNotations(const Notations& notations);
+    void writePrint(const Print& print);
+    void writeSound(const Sound& sound);
+
+    void write(bool value) {
+        _data.push_back(value ? 1 : 0);
+    }
+    void write(int value) {
+        write32(static_cast<std::uint32_t>(value));
+    }
+    void write(float value) {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        write32(bits);
+    }
+    void write(const std::string& value) {
+        writeSize(value.size());
+        _data.append(value);
+    }
+    template <typename E>
+    typename std::enable_if<std::is_enum<E>::value>::type write(E value) {
+        write(static_cast<int>(value));
+    }
+    template <typename T>
+    void write(const Optional<T>& value) {
+        write(value.isPresent());
+        write(value.value());
+    }
+    template <typename K, typename V>
+    void write(const std::map<K, V>& map) {
+        writeSize(map.size());
+        for (auto& pair : map) {
+            write(pair.first);
+            write(pair.second);
+        }
+    }
+    void write(const std::set<int>& set) {
+        writeSize(set.size());
+        for (auto value : set)
+            write(value);
+    }
+
+    void write(const Position& position);
+    void write(const PageMargins& margins);
+    void write(const PageLayout& layout);
+    void write(const SystemDivider& divider);
+    void write(const SystemLayout& layout);
+    void write(const FormattedText& text);
+    void write(const Scaling& scaling);
+    void write(const Tuplet::Portion& portion);
+
+    void write32(std::uint32_t value) {
+        const char bytes[] = {
+            static_cast<char>(value), static_cast<char>(value >> 8),
+            static_cast<char>(value >> 16), static_cast<char>(value >> 24)
+        };
+        _data.append(bytes, sizeof(bytes));
+    }
+
+    void writeSize(std::size_t size) {
+        if (size > std::numeric_limits<std::uint32_t>::max())
+            throw std::length_error("Score too large for a snapshot");
+        write32(static_cast<std::uint32_t>(size));
+    }
+
+private:
+    std::string& _data;
+};
+
+/**
+ Rebuilds a score from the output of Writer. Every read is bounds checked, a truncated snapshot throws instead of
+ reading past the end of the buffer.
+ */
+class Reader {
+public:
+    Reader(const char* data, std::size_t size) : _data(data), _end(data + size) {}
+
+    void readHeader() {
+        if (!isSnapshot(_data, static_cast<std::size_t>(_end - _data)))
+            throw InvalidDataError("Not a score snapshot");
+        take(sizeof(kMagic));
+        const auto version = read32();
+        if (version != kVersion)
+            throw InvalidDataError("Unsupported score snapshot version " + std::to_string(version));
+    }
+    void readScore(Score& score);
+
+protected:
+    std::unique_ptr<Part> readPart();
+    std::unique_ptr<Measure> readMeasure();
+    void readTimedNode(TimedNode& node);
+    std::unique_ptr<Attributes> readAttributes();
+    std::unique_ptr<Barline> readBarline();
+    std::unique_ptr<Chord> readChord(const Measure& measure);
+    std::unique_ptr<Direction> readDirection();
+    std::unique_ptr<DirectionType> readDirectionType();
+    std::unique_ptr<Note> readNote(const Measure& measure);
+    std::unique_ptr<Notations> readNotations();
+    std::unique_ptr<Print> readPrint();
+    std::unique_ptr<Sound> readSound();
+
+    void read(bool& value) {
+        value = *take(1) != 0;
+    }
+    void read(int& value) {
+        value = static_cast<int>(read32());
+    }
+    void read(float& value) {
+        const auto bits = read32();
+        std::memcpy(&value, &bits, sizeof(value));
+    }
+    void read(std::string& value) {
+        const auto size = readSize();
+        value.assign(take(size), size);
+    }
+    template <typename E>
+    typename std::enable_if<std::is_enum<E>::value>::type read(E& value) {
+        value = static_cast<E>(readValue<int>());
+    }
+    template <typename T>
+    void read(Optional<T>& value) {
+        const auto present = readValue<bool>();
+        value = Optional<T>(readValue<T>(), present);
+    }
+    template <typename K, typename V>
+    void read(std::map<K, V>& map) {
+        map.clear();
+        for (auto count = readSize(); count > 0; count -= 1) {
+            auto key = readValue<K>();
+            map[key] = readValue<V>();
+        }
+    }
+    void read(std::set<int>& set) {
+        set.clear();
+        for (auto count = readSize(); count > 0; count -= 1)
+            set.insert(readValue<int>());
+    }
+
+    void read(Position& position);
+    void read(PageMargins& margins);
+    void read(PageLayout& layout);
+    void read(SystemDivider& divider);
+    void read(SystemLayout& layout);
+    void read(FormattedText& text);
+    void read(Scaling& scaling);
+    void read(Tuplet::Portion& portion);
+
+    template <typename T>
+    T readValue() {
+        T value;
+        read(value);
+        return value;
+    }
+
+    const char* take(std::size_t size) {
+        if (static_cast<std::size_t>(_end - _data) < size)
+            throw InvalidDataError("Truncated score snapshot");
+        const auto data = _data;
+        _data += size;
+        return data;
+    }
+
+    std::uint32_t read32() {
+        auto bytes = reinterpret_cast<const unsigned char*>(take(4));
+        return static_cast<std::uint32_t>(bytes[0]) | static_cast<std::uint32_t>(bytes[1]) << 8 |
+            static_cast<std::uint32_t>(bytes[2]) << 16 | static_cast<std::uint32_t>(bytes[3]) << 24;
+    }
+
+    /**
+     Read an element count. Every element takes at least a byte, larger counts can only come from a corrupt snapshot.
+     */
+    std::size_t readSize() {
+        const std::size_t size = read32();
+        if (size > static_cast<std::size_t>(_end - _data))
+            throw InvalidDataError("Truncated score snapshot");
+        return size;
+    }
+
+private:
+    const char* _data;
+    const char* _end;
+};
+
+/**
+ Makes the arena, if there is one, and the string table of a score current for the lifetime of the scope.
+ */
+class ScoreScope {
+public:
+    explicit ScoreScope(const Score& score) : _arena(score.arena().get()), _previousArena(), _previousStrings() {
+        if (_arena)
+            _previousArena = Arena::setCurrent(_arena);
+        _previousStrings = StringTable::setCurrent(score.strings().get());
+    }
+    ~ScoreScope() {
+        StringTable::setCurrent(_previousStrings);
+        if (_arena)
+            Arena::setCurrent(_previousArena);
+    }
+
+    ScoreScope(const ScoreScope&) = delete;
+    ScoreScope& operator=(const ScoreScope&) = delete;
+
+private:
+    Arena* _arena;
+    Arena* _previousArena;
+    StringTable* _previousStrings;
+};
+
+} // namespace
+
+void writeSnapshot(const Score& score, std::ostream& os) {
+    std::string data;
+    Writer writer(data);
+    writer.writeHeader();
+    writer.writeScore(score);
+    os.write(data.data(), static_cast<std::streamsize>(data.size()));
+}
+
+bool isSnapshot(const char* data, std::size_t size) {
+    return size >= sizeof(kMagic) && std::memcmp(data, kMagic, sizeof(kMagic)) == 0;
+}
+
+std::unique_ptr<Score> readSnapshot(const char* data, std::size_t size, bool useArena) {
+    Reader reader(data, size);
+    reader.readHeader();
+
+    // The score itself owns the arena, so it is always allocated from the heap
+    std::unique_ptr<Score> score(new Score());
+    if (useArena)
+        score->setArena(std::make_shared<Arena>());
+    score->setStrings(std::make_shared<StringTable>());
+
+    ScoreScope scope(*score);
+    reader.readScore(*score);
+    return score;
+}
+
+namespace {
+
+// Writer
+
+void Writer::writeScore(const Score& score) {
+    write(bool(score.identification()));
+    if (auto& identification = score.identification()) {
+        writeSize(identification->creators().size());
+        for (auto& creator : identification->creators()) {
+            write(creator->type());
+            write(creator->value());
+        }
+        writeSize(identification->rights().size());
+        for (auto& rights : identification->rights()) {
+            write(rights->type());
+            write(rights->value());
+        }
+        write(identification->source());
+    }
+
+    write(bool(score.defaults()));
+    if (auto& defaults = score.defaults()) {
+        write(defaults->scaling);
+        write(defaults->pageLayout);
+        write(defaults->systemLayout);
+        write(defaults->staffDistances);
+        write(defaults->appearance.lineWidths);
+        write(defaults->appearance.noteSizes);
+        write(defaults->appearance.distances);
+    }
+
+    writeSize(score.credits().size());
+    for (auto& credit : score.credits()) {
+        write(credit->page());
+        writeSize(credit->creditWords().size());
+        for (auto& words : credit->creditWords()) {
+            write(words->justify);
+            write(words->position);
+            write(words->contents);
+            write(words->fontFamily());
+            write(words->fontStyle());
+            write(words->fontWeight());
+            write(words->fontSize());
+        }
+    }
+
+    writeSize(score.parts().size());
+    for (auto& part : score.parts())
+        writePart(*part);
+}
+
+void Writer::writePart(const Part& part) {
+    writeSize(part.index());
+    write(part.id());
+    write(part.name());
+    writeSize(part.measures().size());
+    for (auto& measure : part.measures())
+        writeMeasure(*measure);
+}
+
+void Writer::writeMeasure(const Measure& measure) {
+    writeSize(measure.index());
+    write(measure.number());
+    writeSize(measure.nodes().size());
+    for (auto& node : measure.nodes()) {
+        write(node->kind());
+        switch (node->kind()) {
+            case Node::Kind::Attributes:
+                writeAttributes(static_cast<const Attributes&>(*node));
+                break;
+            case Node::Kind::Backup:
+            case Node::Kind::Forward:
+                writeTimedNode(static_cast<const TimedNode&>(*node));
+                break;
+            case Node::Kind::Barline:
+                writeBarline(static_cast<const Barline&>(*node));
+                break;
+            case Node::Kind::Chord:
+                writeChord(static_cast<const Chord&>(*node));
+                break;
+            case Node::Kind::Direction:
+                writeDirection(static_cast<const Direction&>(*node));
+                break;
+            case Node::Kind::Note:
+                writeNote(static_cast<const Note&>(*node));
+                break;
+            case Node::Kind::Print:
+                writePrint(static_cast<const Print&>(*node));
+                break;
+            default:
+                throw std::invalid_argument("Measure node can't be written to a snapshot");
+        }
+    }
+}
+
+void Writer::writeTimedNode(const TimedNode& node) {
+    write(node.start());
+    write(node.duration());
+}
+
+void Writer::writeAttributes(const Attributes& attributes) {
+    write(attributes.start());
+    write(attributes.divisions());
+    write(attributes.staves());
+
+    writeSize(attributes.clefs().size());
+    for (auto& clef : attributes.clefs()) {
+        write(bool(clef));
+        if (clef) {
+            write(clef->number());
+            write(clef->sign());
+            write(clef->line());
+        }
+    }
+
+    writeSize(attributes.keys().size());
+    for (auto& key : attributes.keys()) {
+        write(bool(key));
+        if (key) {
+            write(key->number());
+            write(key->printObject());
+            write(key->cancel());
+            write(key->fifths());
+            write(key->mode());
+        }
+    }
+
+    auto time = attributes.time();
+    write(time != nullptr);
+    if (time) {
+        write(time->number());
+        write(time->symbol());
+        write(time->senzaMisura());
+        write(time->beats());
+        write(time->beatType());
+    }
+}
+
+void Writer::writeBarline(const Barline& barline) {
+    write(barline.style());
+    write(barline.location());
+
+    write(bool(barline.ending()));
+    if (auto& ending = barline.ending()) {
+        write(ending->type());
+        write(ending->numbers());
+        write(ending->content());
+    }
+
+    write(bool(barline.repeat()));
+    if (auto& repeat = barline.repeat()) {
+        write(repeat->direction());
+        write(repeat->times());
+    }
+}
+
+void Writer::writeChord(const Chord& chord) {
+    writeTimedNode(chord);
+    writeSize(chord.notes().size());
+    for (auto& note : chord.notes())
+        writeNote(*note);
+}
+
+void Writer::writeDirection(const Direction& direction) {
+    write(direction.placement());
+    write(direction.staff());
+    write(direction.start());
+    write(direction.offset());
+
+    write(direction.type() != nullptr);
+    if (auto type = direction.type())
+        writeDirectionType(*type);
+
+    write(bool(direction.sound()));
+    if (auto& sound = direction.sound())
+        writeSound(*sound);
+}
+
+void Writer::writeDirectionType(const DirectionType& type) {
+    write(type.kind());
+    write(type.position);
+    switch (type.kind()) {
+        case Node::Kind::Bracket: {
+            auto& bracket = static_cast<const Bracket&>(type);
+            write(bracket.type());
+            write(bracket.line());
+            write(bracket.sign());
+            break;
+        }
+        case Node::Kind::Coda:
+        case Node::Kind::Segno:
+            break;
+        case Node::Kind::Dynamics:
+            write(static_cast<const Dynamics&>(type).string());
+            break;
+        case Node::Kind::OctaveShift: {
+            auto& shift = static_cast<const OctaveShift&>(type);
+            write(shift.type);
+            write(shift.number);
+            write(shift.size);
+            break;
+        }
+        case Node::Kind::Pedal: {
+            auto& pedal = static_cast<const Pedal&>(type);
+            write(pedal.type());
+            write(pedal.line());
+            write(pedal.sign());
+            break;
+        }
+        case Node::Kind::Wedge: {
+            auto& wedge = static_cast<const Wedge&>(type);
+            write(wedge.type());
+            write(wedge.number());
+            write(wedge.spread());
+            write(wedge.niente());
+            break;
+        }
+        case Node::Kind::Words:
+            write(static_cast<const Words&>(type).contents());
+            break;
+        default:
+            throw std::invalid_argument("Direction type can't be written to a snapshot");
+    }
+}
+
+void Writer::writeNote(const Note& note) {
+    writeTimedNode(note);
+    write(note.position);
+    write(note.printObject);
+    write(note.chord());
+    write(note.grace());
+    write(note.stem());
+    write(note.staff());
+    write(note.voice());
+    write(note.type());
+    write(note.dynamics());
+    write(note.endDynamics());
+    write(note.attack());
+    write(note.release());
+
+    write(bool(note.pitch));
+    if (note.pitch) {
+        write(note.pitch->step());
+        write(note.pitch->alter());
+        write(note.pitch->octave());
+    }
+
+    write(bool(note.rest));
+    if (note.rest) {
+        write(note.rest->displayStep());
+        write(note.rest->displayOctave());
+    }
+
+    write(bool(note.unpitched));
+    if (note.unpitched) {
+        write(note.unpitched->displayStep());
+        write(note.unpitched->displayOctave());
+    }
+
+    write(bool(note.accidental));
+    if (note.accidental) {
+        write(note.accidental->type.alter);
+        write(note.accidental->poition);
+    }
+
+    write(bool(note.dot));
+    if (note.dot)
+        write(note.dot->placement());
+
+    write(bool(note.tie));
+    if (note.tie)
+        write(note.tie->type());
+
+    write(bool(note.notations));
+    if (note.notations)
+        writeNotations(*note.notations);
+
+    write(bool(note.timeModification));
+    if (note.timeModification) {
+        write(note.timeModification->actualNotes);
+        write(note.timeModification->normalNotes);
+    }
+
+    writeSize(note.beams().size());
+    for (auto& beam : note.beams()) {
+        write(beam->number());
+        write(beam->type());
+    }
+
+    writeSize(note.lyrics().size());
+    for (auto& lyric : note.lyrics()) {
+        write(lyric->number());
+        write(lyric->name());
+        write(lyric->placement());
+        write(lyric->printObject());
+        write(bool(lyric->extend()));
+        if (lyric->extend())
+            write(*lyric->extend());
+        write(bool(lyric->syllabic()));
+        if (lyric->syllabic())
+            write(lyric->syllabic()->type());
+        write(lyric->text());
+    }
+}
+
+void Writer::writeNotations(const Notations& notations) {
+    write(notations.printObject);
+
+    write(bool(notations.fermata));
+    if (notations.fermata) {
+        write(notations.fermata->type());
+        write(notations.fermata->shape());
+    }
+
+    writeSize(notations.articulations.size());
+    for (auto& articulation : notations.articulations) {
+        write(articulation->type());
+        write(articulation->placement());
+    }
+
+    writeSize(notations.slurs.size());
+    for (auto& slur : notations.slurs) {
+        write(slur->number());
+        write(slur->type());
+        write(slur->placement());
+        write(slur->orientation());
+    }
+
+    writeSize(notations.ties.size());
+    for (auto& tie : notations.ties) {
+        write(tie->number());
+        write(tie->type());
+        write(tie->placement());
+        write(tie->orientation());
+    }
+
+    writeSize(notations.ornaments.size());
+    for (auto& ornaments : notations.ornaments) {
+        write(bool(ornaments->trillMark()));
+        if (ornaments->trillMark())
+            write(ornaments->trillMark()->placement());
+        for (auto mordent : {ornaments->mordent().get(), ornaments->invertedMordent().get()}) {
+            write(mordent != nullptr);
+            if (mordent) {
+                write(mordent->placement());
+                write(mordent->isLong());
+            }
+        }
+        for (auto turn : {ornaments->turn().get(), ornaments->invertedTurn().get()}) {
+            write(turn != nullptr);
+            if (turn) {
+                write(turn->placement());
+                write(turn->slash());
+            }
+        }
+    }
+
+    writeSize(notations.tuplets.size());
+    for (auto& tuplet : notations.tuplets) {
+        write(tuplet->actual);
+        write(tuplet->normal);
+        write(tuplet->type);
+        write(tuplet->number);
+        write(tuplet->bracket);
+        write(tuplet->showNumber);
+        write(tuplet->showType);
+        write(tuplet->position);
+        write(tuplet->placement);
+    }
+}
+
+void Writer::writePrint(const Print& print) {
+    write(print.pageLayout);
+    write(print.systemLayout);
+    write(print.staffDistances);
+    write(print.measureDistance);
+    write(print.partNameDisplay);
+    write(print.partAbbreviationDisplay);
+    write(print.newSystem);
+    write(print.newPage);
+    write(print.blankPage);
+    write(print.pageNumber);
+}
+
+void Writer::writeSound(const Sound& sound) {
+    write(sound.tempo);
+    write(sound.dynamics);
+    write(sound.dacapo);
+    write(sound.segno);
+    write(sound.dalsegno);
+    write(sound.coda);
+    write(sound.tocoda);
+    write(sound.divisions);
+    write(sound.forwardRepeat);
+    write(sound.fine);
+    write(sound.timeOnly);
+    write(sound.pizzicato);
+    write(sound.pan);
+    write(sound.elevation);
+    write(sound.damperPedal);
+    write(sound.softPedal);
+    write(sound.sostenutoPedal);
+}
+
+void Writer::write(const Position& position) {
+    write(position.defaultX);
+    write(position.defaultY);
+    write(position.relativeX);
+    write(position.relativeY);
+}
+
+void Writer::write(const PageMargins& margins) {
+    write(margins.left);
+    write(margins.right);
+    write(margins.top);
+    write(margins.bottom);
+    write(margins.type);
+}
+
+void Writer::write(const PageLayout& layout) {
+    write(layout.pageHeight);
+    write(layout.pageWidth);
+    write(layout.evenPageMargins);
+    write(layout.oddPageMargins);
+}
+
+void Writer::write(const SystemDivider& divider) {
+    write(divider.printObject);
+    write(divider.position);
+    write(divider.horizontalAlignment);
+    write(divider.verticalAlignment);
+}
+
+void Writer::write(const SystemLayout& layout) {
+    write(layout.systemMargins.left);
+    write(layout.systemMargins.right);
+    write(layout.systemDistance);
+    write(layout.topSystemDistance);
+    write(layout.systemDividers.leftDivider);
+    write(layout.systemDividers.rightDivider);
+}
+
+void Writer::write(const FormattedText& text) {
+    write(text.string);
+    write(text.position);
+    write(text.justify);
+    write(text.horizontalAlignment);
+    write(text.verticalAlignment);
+    write(text.underline);
+    write(text.overline);
+    write(text.lineThrough);
+}
+
+void Writer::write(const Scaling& scaling) {
+    write(scaling.millimeters);
+    write(scaling.tenths);
+}
+
+void Writer::write(const Tuplet::Portion& portion) {
+    write(portion.number);
+    write(portion.type);
+}
+
+// Reader
+
+void Reader::readScore(Score& score) {
+    if (readValue<bool>()) {
+        std::unique_ptr<Identification> identification(new Identification());
+        for (auto count = readSize(); count > 0; count -= 1) {
+            std::unique_ptr<TypedValue> creator(new TypedValue());
+            creator->setType(readValue<std::string>());
+            creator->setValue(readValue<std::string>());
+            identification->addCreator(std::move(creator));
+        }
+        for (auto count = readSize(); count > 0; count -= 1) {
+            std::unique_ptr<TypedValue> rights(new TypedValue());
+            rights->setType(readValue<std::string>());
+            rights->setValue(readValue<std::string>());
+            identification->addRights(std::move(rights));
+        }
+        identification->setSource(readValue<std::string>());
+        score.setIdentification(std::move(identification));
+    }
+
+    if (readValue<bool>()) {
+        std::unique_ptr<Defaults> defaults(new Defaults());
+        read(defaults->scaling);
+        read(defaults->pageLayout);
+        read(defaults->systemLayout);
+        read(defaults->staffDistances);
+        read(defaults->appearance.lineWidths);
+        read(defaults->appearance.noteSizes);
+        read(defaults->appearance.distances);
+        score.setDefaults(std::move(defaults));
+    }
+
+    for (auto count = readSize(); count > 0; count -= 1) {
+        std::unique_ptr<Credit> credit(new Credit());
+        credit->setPage(readValue<int>());
+        for (auto wordsCount = readSize(); wordsCount > 0; wordsCount -= 1) {
+            std::unique_ptr<CreditWords> words(new CreditWords());
+            read(words->justify);
+            read(words->position);
+            read(words->contents);
+            words->setFontFamily(readValue<std::string>());
+            words->setFontStyle(readValue<CreditWords::FontStyle>());
+            words->setFontWeight(readValue<CreditWords::FontWeight>());
+            words->setFontSize(readValue<float>());
+            credit->addCreditWords(std::move(words));
+        }
+        score.addCredit(std::move(credit));
+    }
+
+    for (auto count = readSize(); count > 0; count -= 1) {
+        auto part = readPart();
+        part->setParent(&score);
+        score.addPart(std::move(part));
+    }
+}
+
+std::unique_ptr<Part> Reader::readPart() {
+    std::unique_ptr<Part> part(new Part());
+    part->setIndex(read32());
+    part->setId(readValue<std::string>());
+    part->setName(readValue<std::string>());
+    for (auto count = readSize(); count > 0; count -= 1) {
+        auto measure = readMeasure();
+        measure->setParent(part.get());
+        part->addMeasure(std::move(measure));
+    }
+    return part;
+}
+
+std::unique_ptr<Measure> Reader::readMeasure() {
+    std::unique_ptr<Measure> measure(new Measure());
+    measure->setIndex(read32());
+    measure->setNumber(readValue<std::string>());
+    for (auto count = readSize(); count > 0; count -= 1) {
+        std::unique_ptr<Node> node;
+        switch (readValue<Node::Kind>()) {
+            case Node::Kind::Attributes:
+                node = readAttributes();
+                break;
+            case Node::Kind::Backup: {
+                std::unique_ptr<Backup> backup(new Backup());
+                readTimedNode(*backup);
+                node = std::move(backup);
+                break;
+            }
+            case Node::Kind::Barline:
+                node = readBarline();
+                break;
+            case Node::Kind::Chord:
+                node = readChord(*measure);
+                break;
+            case Node::Kind::Direction:
+                node = readDirection();
+                break;
+            case Node::Kind::Forward: {
+                std::unique_ptr<Forward> forward(new Forward());
+                readTimedNode(*forward);
+                node = std::move(forward);
+                break;
+            }
+            case Node::Kind::Note:
+                node = readNote(*measure);
+                break;
+            case Node::Kind::Print:
+                node = readPrint();
+                break;
+            default:
+                throw InvalidDataError("Invalid node in score snapshot");
+        }
+        measure->addNode(std::move(node));
+    }
+    return measure;
+}
+
+void Reader::readTimedNode(TimedNode& node) {
+    node.setStart(readValue<int>());
+    read(node.duration());
+}
+
+std::unique_ptr<Attributes> Reader::readAttributes() {
+    std::unique_ptr<Attributes> attributes(new Attributes());
+    attributes->setStart(readValue<int>());
+    attributes->setDivisions(readValue<Optional<int>>());
+
+    // Setting the staves fills in default clef and key slots, the actual slots are restored after that
+    const auto staves = readValue<Optional<int>>();
+    if (staves.isPresent())
+        attributes->setStaves(staves);
+
+    const auto clefCount = readSize();
+    for (std::size_t index = 0; index < clefCount; index += 1) {
+        std::unique_ptr<Clef> clef;
+        if (readValue<bool>()) {
+            clef.reset(new Clef());
+            clef->setNumber(readValue<int>());
+            clef->setSign(readValue<Optional<Clef::Sign>>());
+            clef->setLine(readValue<Optional<int>>());
+            clef->setParent(attributes.get());
+        }
+        attributes->setClef(static_cast<int>(index + 1), std::move(clef));
+    }
+
+    const auto keyCount = readSize();
+    for (std::size_t index = 0; index < keyCount; index += 1) {
+        std::unique_ptr<Key> key;
+        if (readValue<bool>()) {
+            key.reset(new Key());
+            key->setNumber(readValue<int>());
+            key->setPrintObject(readValue<bool>());
+            key->setCancel(readValue<int>());
+            key->setFifths(readValue<int>());
+            key->setMode(readValue<Key::Mode>());
+            key->setParent(attributes.get());
+        }
+        attributes->setKey(static_cast<int>(index + 1), std::move(key));
+    }
+
+    if (readValue<bool>()) {
+        std::unique_ptr<Time> time(new Time());
+        time->setNumber(readValue<Optional<int>>());
+        time->setSymbol(readValue<Time::Symbol>());
+        time->setSenzaMisura(readValue<Optional<std::string>>());
+        time->setBeats(readValue<int>());
+        time->setBeatType(readValue<int>());
+        time->setParent(attributes.get());
+        attributes->setTime(std::move(time));
+    }
+    return attributes;
+}
+
+std::unique_ptr<Barline> Reader::readBarline() {
+    std::unique_ptr<Barline> barline(new Barline());
+    barline->setStyle(readValue<Barline::Style>());
+    barline->setLocation(readValue<Barline::Location>());
+
+    if (readValue<bool>()) {
+        std::unique_ptr<Ending> ending(new Ending());
+        ending->setType(readValue<Ending::Type>());
+        ending->setNumbers(readValue<std::set<int>>());
+        ending->setContent(readValue<std::string>());
+        barline->setEnding(std::move(ending));
+    }
+
+    if (readValue<bool>()) {
+        std::unique_ptr<Repeat> repeat(new Repeat());
+        repeat->setDirection(readValue<Repeat::Direction>());
+        repeat->setTimes(readValue<int>());
+        barline->setRepeat(std::move(repeat));
+    }
+    return barline;
+}
+
+std::unique_ptr<Chord> Reader::readChord(const Measure& measure) {
+    std::unique_ptr<Chord> chord(new Chord());
+    const auto start = readValue<int>();
+    const auto duration = readValue<Optional<int>>();
+    for (auto count = readSize(); count > 0; count -= 1)
+        chord->addNote(readNote(measure));
+    chord->setStart(start);
+    chord->setDuration(duration);
+    return chord;
+}
+
+std::unique_ptr<Direction> Reader::readDirection() {
+    std::unique_ptr<Direction> direction(new Direction());
+    direction->setPlacement(readValue<Optional<Placement>>());
+    direction->setStaff(readValue<Optional<int>>());
+    direction->setStart(readValue<int>());
+    direction->setOffset(readValue<Optional<float>>());
+    if (readValue<bool>())
+        direction->setType(readDirectionType());
+    if (readValue<bool>())
+        direction->setSound(readSound());
+    return direction;
+}
+
+std::unique_ptr<DirectionType> Reader::readDirectionType() {
+    const auto kind = readValue<Node::Kind>();
+    const auto position = readValue<Position>();
+
+    std::unique_ptr<DirectionType> type;
+    switch (kind) {
+        case Node::Kind::Bracket: {
+            std::unique_ptr<Bracket> bracket(new Bracket());
+            bracket->setType(readValue<StartStopContinue>());
+            bracket->setLine(presentOptional(readValue<bool>()));
+            bracket->setSign(presentOptional(readValue<bool>()));
+            type = std::move(bracket);
+            break;
+        }
+        case Node::Kind::Coda:
+            type.reset(new Coda());
+            break;
+        case Node::Kind::Dynamics: {
+            std::unique_ptr<Dynamics> dynamics(new Dynamics());
+            dynamics->setString(readValue<std::string>());
+            type = std::move(dynamics);
+            break;
+        }
+        case Node::Kind::OctaveShift: {
+            std::unique_ptr<OctaveShift> shift(new OctaveShift());
+            read(shift->type);
+            read(shift->number);
+            read(shift->size);
+            type = std::move(shift);
+            break;
+        }
+        case Node::Kind::Pedal: {
+            std::unique_ptr<Pedal> pedal(new Pedal());
+            pedal->setType(readValue<StartStopContinue>());
+            pedal->setLine(presentOptional(readValue<bool>()));
+            pedal->setSign(presentOptional(readValue<bool>()));
+            type = std::move(pedal);
+            break;
+        }
+        case Node::Kind::Segno:
+            type.reset(new Segno());
+            break;
+        case Node::Kind::Wedge: {
+            std::unique_ptr<Wedge> wedge(new Wedge());
+            wedge->setType(readValue<Wedge::Type>());
+            wedge->setNumber(readValue<int>());
+            wedge->setSpread(readValue<float>());
+            wedge->setNiente(readValue<bool>());
+            type = std::move(wedge);
+            break;
+        }
+        case Node::Kind::Words: {
+            std::unique_ptr<Words> words(new Words());
+            words->setContents(readValue<std::string>());
+            type = std::move(words);
+            break;
+        }
+        default:
+            throw InvalidDataError("Invalid direction type in score snapshot");
+    }
+    type->position = position;
+    return type;
+}
+
+std::unique_ptr<Note> Reader::readNote(const Measure& measure) {
+    std::unique_ptr<Note> note(new Note());
+    note->setMeasure(&measure);
+    readTimedNode(*note);
+    read(note->position);
+    read(note->printObject);
+    note->setChord(readValue<bool>());
+    note->setGrace(readValue<bool>());
+    note->setStem(readValue<Optional<Stem>>());
+    note->setStaff(readValue<int>());
+    note->setVoice(readValue<std::string>());
+    note->setType(readValue<Optional<Note::Type>>());
+    note->setDynamics(readValue<Optional<float>>());
+    note->setEndDynamics(readValue<Optional<float>>());
+    note->setAttack(readValue<int>());
+    note->setRelease(readValue<int>());
+
+    if (readValue<bool>()) {
+        note->pitch.reset(new Pitch());
+        note->pitch->setStep(readValue<Pitch::Step>());
+        note->pitch->setAlter(readValue<int>());
+        note->pitch->setOctave(readValue<int>());
+        note->pitch->setParent(note.get());
+    }
+
+    if (readValue<bool>()) {
+        note->rest.reset(new Rest());
+        note->rest->setDisplayStep(readValue<Optional<Pitch::Step>>());
+        note->rest->setDisplayOctave(readValue<Optional<int>>());
+        note->rest->setParent(note.get());
+    }
+
+    if (readValue<bool>()) {
+        note->unpitched.reset(new Unpitched());
+        note->unpitched->setDisplayStep(readValue<Pitch::Step>());
+        note->unpitched->setDisplayOctave(readValue<int>());
+        note->unpitched->setParent(note.get());
+    }
+
+    if (readValue<bool>()) {
+        auto type = Accidental::Type::byAlter(readValue<int>());
+        if (!type)
+            throw InvalidDataError("Invalid accidental in score snapshot");
+        note->accidental.reset(new Accidental(*type));
+        read(note->accidental->poition);
+        note->accidental->setParent(note.get());
+    }
+
+    if (readValue<bool>()) {
+        note->dot.reset(new EmptyPlacement());
+        note->dot->setPlacement(readValue<Optional<Placement>>());
+        note->dot->setParent(note.get());
+    }
+
+    if (readValue<bool>()) {
+        note->tie.reset(new Tie());
+        note->tie->setType(readValue<StartStopContinue>());
+        note->tie->setParent(note.get());
+    }
+
+    if (readValue<bool>()) {
+        note->notations = readNotations();
+        note->notations->setParent(note.get());
+    }
+
+    if (readValue<bool>()) {
+        note->timeModification.reset(new TimeModification());
+        read(note->timeModification->actualNotes);
+        read(note->timeModification->normalNotes);
+        note->timeModification->setParent(note.get());
+    }
+
+    for (auto count = readSize(); count > 0; count -= 1) {
+        std::unique_ptr<Beam> beam(new Beam());
+        beam->setNumber(readValue<int>());
+        beam->setType(readValue<Beam::Type>());
+        beam->setParent(note.get());
+        note->addBeam(std::move(beam));
+    }
+
+    for (auto count = readSize(); count > 0; count -= 1) {
+        std::unique_ptr<Lyric> lyric(new Lyric());
+        lyric->setNumber(readValue<int>());
+        lyric->setName(readValue<std::string>());
+        lyric->setPlacement(readValue<Placement>());
+        lyric->setPrintObject(readValue<bool>());
+        if (readValue<bool>())
+            lyric->setExtend(std::unique_ptr<StartStopContinue>(new StartStopContinue(readValue<StartStopContinue>())));
+        if (readValue<bool>()) {
+            std::unique_ptr<Syllabic> syllabic(new Syllabic());
+            syllabic->setType(readValue<Syllabic::Type>());
+            lyric->setSyllabic(std::move(syllabic));
+        }
+        lyric->setText(readValue<std::string>());
+        lyric->setParent(note.get());
+        note->addLyric(std::move(lyric));
+    }
+    return note;
+}
+
+std::unique_ptr<Notations> Reader::readNotations() {
+    std::unique_ptr<Notations> notations(new Notations());
+    read(notations->printObject);
+
+    if (readValue<bool>()) {
+        notations->fermata.reset(new Fermata());
+        notations->fermata->setType(readValue<Fermata::Type>());
+        notations->fermata->setShape(readValue<Fermata::Shape>());
+        notations->fermata->setParent(notations.get());
+    }
+
+    for (auto count = readSize(); count > 0; count -= 1) {
+        std::unique_ptr<Articulation> articulation(new Articulation(readValue<Articulation::Type>()));
+        articulation->setPlacement(readValue<Optional<Placement>>());
+        notations->articulations.push_back(std::move(articulation));
+    }
+
+    for (auto count = readSize(); count > 0; count -= 1) {
+        std::unique_ptr<Slur> slur(new Slur());
+        slur->setNumber(readValue<int>());
+        slur->setType(readValue<StartStopContinue>());
+        slur->setPlacement(readValue<Placement>());
+        slur->setOrientation(readValue<Orientation>());
+        slur->setParent(notations.get());
+        notations->slurs.push_back(std::move(slur));
+    }
+
+    for (auto count = readSize(); count > 0; count -= 1) {
+        std::unique_ptr<Tied> tie(new Tied());
+        tie->setNumber(readValue<int>());
+        tie->setType(readValue<StartStopContinue>());
+        tie->setPlacement(readValue<Placement>());
+        tie->setOrientation(readValue<Orientation>());
+        tie->setParent(notations.get());
+        notations->ties.push_back(std::move(tie));
+    }
+
+    for (auto count = readSize(); count > 0; count -= 1) {
+        std::unique_ptr<Ornaments> ornaments(new Ornaments());
+        if (readValue<bool>()) {
+            std::unique_ptr<EmptyPlacement> trillMark(new EmptyPlacement());
+            trillMark->setPlacement(readValue<Optional<Placement>>());
+            ornaments->setTrillMark(std::move(trillMark));
+        }
+        for (auto inverted : {false, true}) {
+            if (!readValue<bool>())
+                continue;
+            std::unique_ptr<Mordent> mordent(new Mordent());
+            mordent->setPlacement(readValue<Optional<Placement>>());
+            mordent->setLong(readValue<bool>());
+            if (inverted)
+                ornaments->setInvertedMordent(std::move(mordent));
+            else
+                ornaments->setMordent(std::move(mordent));
+        }
+        for (auto inverted : {false, true}) {
+            if (!readValue<bool>())
+                continue;
+            std::unique_ptr<Turn> turn(new Turn());
+            turn->setPlacement(readValue<Optional<Placement>>());
+            turn->setSlash(readValue<bool>());
+            if (inverted)
+                ornaments->setInvertedTurn(std::move(turn));
+            else
+                ornaments->setTurn(std::move(turn));
+        }
+        ornaments->setParent(notations.get());
+        notations->ornaments.push_back(std::move(ornaments));
+    }
+
+    for (auto count = readSize(); count > 0; count -= 1) {
+        std::unique_ptr<Tuplet> tuplet(new Tuplet());
+        read(tuplet->actual);
+        read(tuplet->normal);
+        read(tuplet->type);
+        read(tuplet->number);
+        read(tuplet->bracket);
+        read(tuplet->showNumber);
+        read(tuplet->showType);
+        read(tuplet->position);
+        read(tuplet->placement);
+        tuplet->setParent(notations.get());
+        notations->tuplets.push_back(std::move(tuplet));
+    }
+    return notations;
+}
+
+std::unique_ptr<Print> Reader::readPrint() {
+    std::unique_ptr<Print> print(new Print());
+    read(print->pageLayout);
+    read(print->systemLayout);
+    read(print->staffDistances);
+    read(print->measureDistance);
+    read(print->partNameDisplay);
+    read(print->partAbbreviationDisplay);
+    read(print->newSystem);
+    read(print->newPage);
+    read(print->blankPage);
+    read(print->pageNumber);
+    return print;
+}
+
+std::unique_ptr<Sound> Reader::readSound() {
+    std::unique_ptr<Sound> sound(new Sound());
+    read(sound->tempo);
+    read(sound->dynamics);
+    read(sound->dacapo);
+    read(sound->segno);
+    read(sound->dalsegno);
+    read(sound->coda);
+    read(sound->tocoda);
+    read(sound->divisions);
+    read(sound->forwardRepeat);
+    read(sound->fine);
+    read(sound->timeOnly);
+    read(sound->pizzicato);
+    read(sound->pan);
+    read(sound->elevation);
+    read(sound->damperPedal);
+    read(sound->softPedal);
+    read(sound->sostenutoPedal);
+    return sound;
+}
+
+void Reader::read(Position& position) {
+    read(position.defaultX);
+    read(position.defaultY);
+    read(position.relativeX);
+    read(position.relativeY);
+}
+
+void Reader::read(PageMargins& margins) {
+    read(margins.left);
+    read(margins.right);
+    read(margins.top);
+    read(margins.bottom);
+    read(margins.type);
+}
+
+void Reader::read(PageLayout& layout) {
+    read(layout.pageHeight);
+    read(layout.pageWidth);
+    read(layout.evenPageMargins);
+    read(layout.oddPageMargins);
+}
+
+void Reader::read(SystemDivider& divider) {
+    read(divider.printObject);
+    read(divider.position);
+    read(divider.horizontalAlignment);
+    read(divider.verticalAlignment);
+}
+
+void Reader::read(SystemLayout& layout) {
+    read(layout.systemMargins.left);
+    read(layout.systemMargins.right);
+    read(layout.systemDistance);
+    read(layout.topSystemDistance);
+    read(layout.systemDividers.leftDivider);
+    read(layout.systemDividers.rightDivider);
+}
+
+void Reader::read(FormattedText& text) {
+    read(text.string);
+    read(text.position);
+    read(text.justify);
+    read(text.horizontalAlignment);
+    read(text.verticalAlignment);
+    read(text.underline);
+    read(text.overline);
+    read(text.lineThrough);
+}
+
+void Reader::read(Scaling& scaling) {
+    read(scaling.millimeters);
+    read(scaling.tenths);
+}
+
+void Reader::read(Tuplet::Portion& portion) {
+    read(portion.number);
+    read(portion.type);
+}
+
+} // namespace
+
+} // namespace mxml
@@ -0,0 +1,36 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+#include <mxml/dom/Score.h>
+
+#include <cstddef>
+#include <memory>
+#include <ostream>
+
+
+namespace mxml {
+
+/**
+ Write a binary snapshot of a parsed score. A snapshot holds everything the parser puts in the dom, reading it back
+ skips the XML parsing entirely and yields the same score. Snapshots are a cache, not an exchange format: they are
+ versioned and only read back by the same version of mxml.
+ */
+void writeSnapshot(const dom::Score& score, std::ostream& os);
+
+/**
+ Check if a buffer starts like a score snapshot.
+ */
+bool isSnapshot(const char* data, std::size_t size);
+
+/**
+ Rebuild a score from a snapshot in memory, for instance a memory mapped file. Throws dom::InvalidDataError if the
+ snapshot is truncated or was written by a different snapshot version. The nodes are allocated from an arena owned by
+ the score if useArena is set, see ParseOptions::useArena.
+ */
+std::unique_ptr<dom::Score> readSnapshot(const char* data, std::size_t size, bool useArena = false);
+
+} // namespace mxml
@@ -80,25 +80,29 @@ void SpanFactory::build(const dom::Measure* measure, bool buildMeasureAttributes
         // Compute next note time
         _nextTime = -1;
         for (auto it2 = std::next(it); it2 != nodes.end(); ++it2) {
-            if (auto chord = dynamic_cast<const dom::Chord*>(it2->get())) {
-                _nextTime = chord->start();
-                break;
-            } else if (auto note = dynamic_cast<const dom::Note*>(it2->get())) {
-                _nextTime = note->start();
+            auto kind = (*it2)->kind();
+            if (kind == dom::Node::Kind::Chord || kind == dom::Node::Kind::Note) {
+                _nextTime = static_cast<const dom::TimedNode&>(**it2).start();
                 break;
             }
         }
         if (_nextTime == -1)
             _nextTime = _scoreProperties.divisionsPerMeasure(measure->index());
 
-        if (const dom::Barline* barline = dynamic_cast<const dom::Barline*>(node.get())) {
-            build(barline);
-        } else if (const dom::Attributes* attributes = dynamic_cast<const dom::Attributes*>(node.get())) {
-            build(attributes);
-        } else if (const dom::Direction* direction = dynamic_cast<const dom::Direction*>(node.get())) {
-            build(direction);
-        } else if (const dom::TimedNode* timedNode = dynamic_cast<const dom::TimedNode*>(node.get())) {
-            build(timedNode);
+        switch (node->kind()) {
+            case dom::Node::Kind::Barline:
+                build(static_cast<const dom::Barline*>(node.get()));
+                break;
+            case dom::Node::Kind::Attributes:
+                build(static_cast<const dom::Attributes*>(node.get()));
+                break;
+            case dom::Node::Kind::Direction:
+                build(static_cast<const dom::Direction*>(node.get()));
+                break;
+            default:
+                if (node->isTimed())
+                    build(static_cast<const dom::TimedNode*>(node.get()));
+                break;
         }
     }
 
@@ -123,7 +127,7 @@ void SpanFactory::build(const dom::Measure* measure, bool buildMeasureAttributes
 
 void SpanFactory::build(const dom::Barline* barline) {
     dom::time_t time = _currentTime;
-    const dom::Measure* measure = dynamic_cast<const dom::Measure*>(barline->parent());
+    const dom::Measure* measure = static_cast<const dom::Measure*>(barline->parent());
     if (barline == measure->nodes().back().get())
         time = std::numeric_limits<int>::max();
 
@@ -157,7 +161,7 @@ void SpanFactory::build(const dom::Measure* measure) {
 
 void SpanFactory::build(const dom::Attributes* attributes) {
     dom::time_t time = _nextTime;
-    const dom::Measure* measure = dynamic_cast<const dom::Measure*>(attributes->parent());
+    const dom::Measure* measure = static_cast<const dom::Measure*>(attributes->parent());
     if (attributes == measure->nodes().back().get())
         time = std::numeric_limits<int>::max();
 
@@ -186,10 +190,10 @@ void SpanFactory::build(const dom::Direction* direction) {
 void SpanFactory::build(const dom::TimedNode* node) {
     _currentTime = node->start();
     
-    if (auto chord = dynamic_cast<const dom::Chord*>(node)) {
-        build(chord);
-    } else if (auto note = dynamic_cast<const dom::Note*>(node)) {
-        build(note);
+    if (node->kind() == dom::Node::Kind::Chord) {
+        build(static_cast<const dom::Chord*>(node));
+    } else if (node->kind() == dom::Node::Kind::Note) {
+        build(static_cast<const dom::Note*>(node));
     }
 }
 
@@ -351,9 +355,9 @@ SpanCollection::iterator SpanFactory::graceNoteSpan(const dom::Chord* chord) {
     auto count = std::count_if(range.first, range.second, [staff](const Span& s) {
         const std::set<const dom::Node*>& nodes = s.nodes();
         auto it = std::find_if(nodes.begin(), nodes.end(), [staff](const dom::Node* n) {
-            const dom::Chord* chord = dynamic_cast<const dom::Chord*>(n);
-            if (!chord)
+            if (n->kind() != dom::Node::Kind::Chord)
                 return false;
+            const dom::Chord* chord = static_cast<const dom::Chord*>(n);
 
             auto note = chord->firstNote();
             return note->grace() && note->staff() == staff;
@@ -365,9 +369,9 @@ SpanCollection::iterator SpanFactory::graceNoteSpan(const dom::Chord* chord) {
     std::size_t n = 0;
     for (auto it = range.first; it != range.second; ++it) {
         for (auto& node : it->nodes()) {
-            const dom::Chord* chord = dynamic_cast<const dom::Chord*>(node);
-            if (!chord)
+            if (node->kind() != dom::Node::Kind::Chord)
                 continue;
+            const dom::Chord* chord = static_cast<const dom::Chord*>(node);
 
             auto note = chord->firstNote();
             if (note->grace() && note->staff() != staff) {
@@ -419,7 +423,8 @@ bool SpanFactory::isAttributeOnlySpan(const Span& span) {
         return false;
 
     for (auto& node : span.nodes()) {
-        if (!dynamic_cast<const dom::Clef*>(node) && !dynamic_cast<const dom::Time*>(node) && !dynamic_cast<const dom::Key*>(node)) {
+        auto kind = node->kind();
+        if (kind != dom::Node::Kind::Clef && kind != dom::Node::Kind::Time && kind != dom::Node::Kind::Key) {
             return false;
         }
     }
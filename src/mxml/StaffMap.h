@@ -0,0 +1,117 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+#include <mxml/dom/Optional.h>
+#include <mxml/dom/Types.h>
+
+#include <vector>
+
+
+namespace mxml {
+
+/**
+ Index of values that change over the course of a score independently for every part and staff, like dynamics or
+ octave shifts. Change points are stored contiguously per (part, staff) line sorted by measure and time, so the value
+ in effect at a given location is a binary search on a single line.
+ */
+template <typename T>
+class StaffMap {
+public:
+    struct Point {
+        std::size_t measureIndex;
+        dom::time_t time;
+        T value;
+
+        bool operator<(const Point& rhs) const {
+            if (measureIndex < rhs.measureIndex)
+                return true;
+            if (measureIndex > rhs.measureIndex)
+                return false;
+            return time < rhs.time;
+        }
+    };
+
+    /**
+     Forward cursor over the lines of a part. Resolves the values of consecutive measures without searching each line
+     from the beginning.
+     */
+    class Cursor {
+    public:
+        Cursor(const StaffMap& map, std::size_t partIndex);
+
+        /**
+         Move to the given measure, measures have to be visited in increasing order.
+         */
+        void seek(std::size_t measureIndex);
+
+        /**
+         Get the value for the given staff and time in the current measure.
+         */
+        T find(int staff, dom::time_t time) const;
+
+    private:
+        struct LineCursor {
+            std::size_t begin;
+            std::size_t measureBegin;
+            std::size_t measureEnd;
+            std::size_t end;
+        };
+
+        const StaffMap& _map;
+        std::size_t _partIndex;
+        std::vector<LineCursor> _lines;
+    };
+
+public:
+    explicit StaffMap(T defaultValue);
+
+    /**
+     Add a change. Changes have to be added in score order. A change without a staff applies to all staves in the part.
+     */
+    void add(std::size_t partIndex, dom::Optional<int> staff, std::size_t measureIndex, dom::time_t time, T value);
+
+    /**
+     Lay out the changes per part and staff, call this after all changes have been added or the results will be
+     undefined.
+     */
+    void build(const std::vector<int>& staves);
+
+    /**
+     Get the value in effect at the given part, measure, staff and time.
+     */
+    T find(std::size_t partIndex, std::size_t measureIndex, int staff, dom::time_t time) const;
+
+protected:
+    struct Change {
+        std::size_t partIndex;
+        int staff;
+        Point point;
+    };
+
+    struct Line {
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    /**
+     Get the line index for a part and staff. Staves without explicit changes use the line for changes that apply to
+     all staves.
+     */
+    std::size_t lineIndex(std::size_t partIndex, int staff) const;
+
+private:
+    T _defaultValue;
+    std::vector<Change> _changes;
+    std::vector<Point> _points;
+    std::vector<Line> _lines;
+    std::vector<std::size_t> _partLines;
+    std::vector<int> _partStaves;
+};
+
+} // namespace mxml
+
+#include "StaffMap.hh"
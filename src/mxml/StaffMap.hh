@@ -0,0 +1,151 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "StaffMap.h"
+
+#include <algorithm>
+#include <iterator>
+
+
+namespace mxml {
+
+template <typename T>
+StaffMap<T>::StaffMap(T defaultValue) : _defaultValue(defaultValue), _changes(), _points(), _lines(), _partLines(), _partStaves() {
+}
+
+template <typename T>
+void StaffMap<T>::add(std::size_t partIndex, dom::Optional<int> staff, std::size_t measureIndex, dom::time_t time, T value) {
+    if (staff.isPresent() && staff.value() < 1)
+        return;
+
+    Change change;
+    change.partIndex = partIndex;
+    change.staff = staff.isPresent() ? staff.value() : 0;
+    change.point.measureIndex = measureIndex;
+    change.point.time = time;
+    change.point.value = value;
+    _changes.push_back(change);
+}
+
+template <typename T>
+void StaffMap<T>::build(const std::vector<int>& staves) {
+    const auto partCount = staves.size();
+
+    _partStaves = staves;
+    for (auto& change : _changes) {
+        if (change.partIndex < partCount)
+            _partStaves[change.partIndex] = std::max(_partStaves[change.partIndex], change.staff);
+    }
+
+    // Every part gets one line per staff plus line 0 for the changes that apply to all staves
+    _partLines.assign(partCount + 1, 0);
+    for (std::size_t partIndex = 0; partIndex < partCount; partIndex += 1)
+        _partLines[partIndex + 1] = _partLines[partIndex] + _partStaves[partIndex] + 1;
+
+    std::vector<std::vector<Point>> lines(_partLines.back());
+    for (auto& change : _changes) {
+        if (change.partIndex >= partCount)
+            continue;
+
+        const auto first = _partLines[change.partIndex];
+        if (change.staff != 0) {
+            lines[first + change.staff].push_back(change.point);
+            continue;
+        }
+
+        for (int staff = 0; staff <= _partStaves[change.partIndex]; staff += 1)
+            lines[first + staff].push_back(change.point);
+    }
+
+    _points.clear();
+    _lines.clear();
+    _lines.reserve(lines.size());
+    for (auto& points : lines) {
+        Line line;
+        line.begin = _points.size();
+        _points.insert(_points.end(), points.begin(), points.end());
+        line.end = _points.size();
+        _lines.push_back(line);
+    }
+    _changes.clear();
+}
+
+template <typename T>
+std::size_t StaffMap<T>::lineIndex(std::size_t partIndex, int staff) const {
+    if (staff < 1 || staff > _partStaves[partIndex])
+        staff = 0;
+    return _partLines[partIndex] + staff;
+}
+
+template <typename T>
+T StaffMap<T>::find(std::size_t partIndex, std::size_t measureIndex, int staff, dom::time_t time) const {
+    if (partIndex >= _partStaves.size())
+        return _defaultValue;
+
+    Point model;
+    model.measureIndex = measureIndex;
+    model.time = time;
+
+    const auto& line = _lines[lineIndex(partIndex, staff)];
+    const auto begin = _points.begin() + line.begin;
+    auto it = std::upper_bound(begin, _points.begin() + line.end, model);
+    if (it == begin)
+        return _defaultValue;
+    return std::prev(it)->value;
+}
+
+
+template <typename T>
+StaffMap<T>::Cursor::Cursor(const StaffMap& map, std::size_t partIndex)
+: _map(map),
+  _partIndex(partIndex),
+  _lines()
+{
+    if (partIndex >= map._partStaves.size())
+        return;
+
+    for (auto index = map._partLines[partIndex]; index < map._partLines[partIndex + 1]; index += 1) {
+        const auto& line = map._lines[index];
+        _lines.push_back(LineCursor{line.begin, line.begin, line.begin, line.end});
+    }
+    seek(0);
+}
+
+template <typename T>
+void StaffMap<T>::Cursor::seek(std::size_t measureIndex) {
+    const auto& points = _map._points;
+    for (auto& line : _lines) {
+        auto begin = std::lower_bound(points.begin() + line.measureBegin, points.begin() + line.end, measureIndex, [](const Point& point, std::size_t measureIndex) {
+            return point.measureIndex < measureIndex;
+        });
+        line.measureBegin = static_cast<std::size_t>(std::distance(points.begin(), begin));
+
+        line.measureEnd = line.measureBegin;
+        while (line.measureEnd < line.end && points[line.measureEnd].measureIndex == measureIndex)
+            line.measureEnd += 1;
+    }
+}
+
+template <typename T>
+T StaffMap<T>::Cursor::find(int staff, dom::time_t time) const {
+    if (_lines.empty())
+        return _map._defaultValue;
+
+    const auto& line = _lines[_map.lineIndex(_partIndex, staff) - _map._partLines[_partIndex]];
+
+    // Only the changes in the current measure need to be searched, everything before them is already in effect
+    const auto& points = _map._points;
+    auto it = std::upper_bound(points.begin() + line.measureBegin, points.begin() + line.measureEnd, time, [](dom::time_t time, const Point& point) {
+        return time < point.time;
+    });
+
+    const auto index = static_cast<std::size_t>(std::distance(points.begin(), it));
+    if (index == line.begin)
+        return _map._defaultValue;
+    return points[index - 1].value;
+}
+
+} // namespace mxml
@@ -0,0 +1,153 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "TempoMap.h"
+#include "ScoreProperties.h"
+
+#include <algorithm>
+#include <iterator>
+
+
+namespace mxml {
+
+const float TempoMap::kDefaultTempo = 60.0;
+
+TempoMap::TempoMap() : _changes(), _points(), _measureStarts() {
+}
+
+void TempoMap::addTempo(std::size_t measureIndex, dom::time_t time, float tempo) {
+    if (!_changes.empty() && _changes.back().measureIndex == measureIndex && _changes.back().time == time) {
+        _changes.back().tempo = tempo;
+        return;
+    }
+
+    Point change;
+    change.measureIndex = measureIndex;
+    change.time = time;
+    change.tempo = tempo;
+    _changes.push_back(change);
+}
+
+void TempoMap::build(const ScoreProperties& scoreProperties) {
+    const auto measureCount = scoreProperties.measureCount();
+
+    _measureStarts.clear();
+    _measureStarts.reserve(measureCount + 1);
+    dom::time_t start = 0;
+    for (std::size_t measureIndex = 0; measureIndex < measureCount; measureIndex += 1) {
+        _measureStarts.push_back(start);
+        start += scoreProperties.divisionsPerMeasure(measureIndex);
+    }
+    _measureStarts.push_back(start);
+
+    // The division duration depends on both the tempo and the divisions per beat, add a point wherever either changes
+    _points.clear();
+    float tempo = kDefaultTempo;
+    dom::time_t divisionsPerBeat = scoreProperties.divisionsPerBeat(0);
+    addPoint(0, 0, tempo, divisionsPerBeat);
+
+    auto change = _changes.begin();
+    for (std::size_t measureIndex = 0; measureIndex < measureCount; measureIndex += 1) {
+        const auto measureDivisionsPerBeat = scoreProperties.divisionsPerBeat(measureIndex);
+        if (measureDivisionsPerBeat != divisionsPerBeat) {
+            divisionsPerBeat = measureDivisionsPerBeat;
+            addPoint(measureIndex, 0, tempo, divisionsPerBeat);
+        }
+
+        for (; change != _changes.end() && change->measureIndex == measureIndex; ++change) {
+            tempo = change->tempo;
+            addPoint(measureIndex, change->time, tempo, divisionsPerBeat);
+        }
+    }
+
+    // Changes past the last measure can still be queried by measure and time
+    for (; change != _changes.end(); ++change) {
+        tempo = change->tempo;
+        addPoint(change->measureIndex, change->time, tempo, divisionsPerBeat);
+    }
+}
+
+void TempoMap::addPoint(std::size_t measureIndex, dom::time_t time, float tempo, dom::time_t divisionsPerBeat) {
+    Point point;
+    point.measureIndex = measureIndex;
+    point.time = time;
+    point.absoluteTime = absoluteTime(measureIndex, time);
+    point.tempo = tempo;
+    point.divisionDuration = 60.0 / (divisionsPerBeat * tempo); // In seconds
+    point.seconds = 0.0;
+
+    if (!_points.empty()) {
+        auto& last = _points.back();
+        if (last.measureIndex == measureIndex && last.time == time) {
+            point.seconds = last.seconds;
+            last = point;
+            return;
+        }
+        point.seconds = last.seconds + last.divisionDuration * static_cast<double>(point.absoluteTime - last.absoluteTime);
+    }
+
+    _points.push_back(point);
+}
+
+dom::time_t TempoMap::absoluteTime(std::size_t measureIndex, dom::time_t time) const {
+    const auto measureCount = _measureStarts.size() - 1;
+    if (measureIndex >= measureCount)
+        return _measureStarts.back();
+
+    // Clamp to the measure so that absolute times never decrease
+    const auto measureDuration = _measureStarts[measureIndex + 1] - _measureStarts[measureIndex];
+    return _measureStarts[measureIndex] + std::max<dom::time_t>(0, std::min(time, measureDuration));
+}
+
+float TempoMap::tempo(std::size_t measureIndex, dom::time_t time) const {
+    Point model;
+    model.measureIndex = measureIndex;
+    model.time = time;
+
+    auto it = std::upper_bound(_points.begin(), _points.end(), model);
+    if (it == _points.begin())
+        return kDefaultTempo;
+    return std::prev(it)->tempo;
+}
+
+double TempoMap::seconds(std::size_t measureIndex, dom::time_t time) const {
+    if (_points.empty())
+        return 0.0;
+
+    const auto absolute = absoluteTime(measureIndex, time);
+    auto it = std::upper_bound(_points.begin(), _points.end(), absolute, [](dom::time_t time, const Point& point) {
+        return time < point.absoluteTime;
+    });
+    if (it != _points.begin())
+        it = std::prev(it);
+
+    return it->seconds + it->divisionDuration * static_cast<double>(absolute - it->absoluteTime);
+}
+
+MeasureLocation TempoMap::location(double seconds) const {
+    MeasureLocation location;
+    if (_points.empty() || seconds <= 0.0)
+        return location;
+
+    auto it = std::upper_bound(_points.begin(), _points.end(), seconds, [](double seconds, const Point& point) {
+        return seconds < point.seconds;
+    });
+    it = std::prev(it);
+
+    auto absolute = it->absoluteTime + static_cast<dom::time_t>((seconds - it->seconds) / it->divisionDuration);
+    if (absolute >= _measureStarts.back() && _measureStarts.size() > 1)
+        absolute = _measureStarts.back() - 1;
+
+    auto measure = std::upper_bound(_measureStarts.begin(), _measureStarts.end() - 1, absolute);
+    if (measure != _measureStarts.begin())
+        measure = std::prev(measure);
+
+    location.measureIndex = static_cast<std::size_t>(std::distance(_measureStarts.begin(), measure));
+    location.division = absolute - *measure;
+    return location;
+}
+
+} // namespace mxml
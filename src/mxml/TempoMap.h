@@ -0,0 +1,84 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+#include "Event.h"
+
+#include <mxml/dom/Types.h>
+
+#include <vector>
+
+
+namespace mxml {
+
+class ScoreProperties;
+
+/**
+ Flattened map of the tempo changes in a score. Every change point stores the wall-clock time at which it occurs when
+ the score is played straight through, so converting between score positions and seconds is a binary search.
+ */
+class TempoMap {
+public:
+    static const float kDefaultTempo;
+
+public:
+    TempoMap();
+
+    /**
+     Add a tempo change. Changes have to be added in score order, a change at the same position as the previous one
+     replaces it.
+     */
+    void addTempo(std::size_t measureIndex, dom::time_t time, float tempo);
+
+    /**
+     Compute the wall-clock offsets of all change points, call this after all tempo changes have been added and the
+     time and divisions sequences are sorted or the results will be undefined.
+     */
+    void build(const ScoreProperties& scoreProperties);
+
+    /**
+     Get the tempo at the given measure and time.
+     */
+    float tempo(std::size_t measureIndex, dom::time_t time) const;
+
+    /**
+     Get the number of seconds from the start of the score to the given measure and time, without repeats.
+     */
+    double seconds(std::size_t measureIndex, dom::time_t time) const;
+
+    /**
+     Get the measure location that is played the given number of seconds from the start of the score, without repeats.
+     */
+    MeasureLocation location(double seconds) const;
+
+protected:
+    struct Point {
+        std::size_t measureIndex;
+        dom::time_t time;
+        dom::time_t absoluteTime;
+        float tempo;
+        double divisionDuration;
+        double seconds;
+
+        bool operator<(const Point& rhs) const {
+            if (measureIndex < rhs.measureIndex)
+                return true;
+            if (measureIndex > rhs.measureIndex)
+                return false;
+            return time < rhs.time;
+        }
+    };
+
+    void addPoint(std::size_t measureIndex, dom::time_t time, float tempo, dom::time_t divisionsPerBeat);
+    dom::time_t absoluteTime(std::size_t measureIndex, dom::time_t time) const;
+
+private:
+    std::vector<Point> _changes;
+    std::vector<Point> _points;
+    std::vector<dom::time_t> _measureStarts;
+};
+
+} // namespace mxml
@@ -0,0 +1,213 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "ZipArchive.h"
+
+#include <mxml/dom/InvalidDataError.h>
+
+#include <algorithm>
+
+#include <zlib.h>
+
+
+namespace mxml {
+
+namespace {
+
+const std::uint32_t kLocalHeaderSignature = 0x04034b50;
+const std::uint32_t kCentralHeaderSignature = 0x02014b50;
+const std::uint32_t kEndOfDirectorySignature = 0x06054b50;
+
+const std::size_t kLocalHeaderSize = 30;
+const std::size_t kCentralHeaderSize = 46;
+const std::size_t kEndOfDirectorySize = 22;
+const std::size_t kMaximumCommentSize = 0xffff;
+
+const std::uint16_t kEncryptedFlag = 0x0001;
+const std::uint16_t kStoredMethod = 0;
+const std::uint16_t kDeflatedMethod = 8;
+
+const std::size_t kInflateBufferSize = 64 * 1024;
+
+std::uint16_t read16(const char* data) {
+    auto bytes = reinterpret_cast<const unsigned char*>(data);
+    return static_cast<std::uint16_t>(bytes[0] | bytes[1] << 8);
+}
+
+std::uint32_t read32(const char* data) {
+    auto bytes = reinterpret_cast<const unsigned char*>(data);
+    return static_cast<std::uint32_t>(bytes[0]) | static_cast<std::uint32_t>(bytes[1]) << 8 |
+        static_cast<std::uint32_t>(bytes[2]) << 16 | static_cast<std::uint32_t>(bytes[3]) << 24;
+}
+
+/**
+ Stream buffer over an entry stored without compression, reads come straight from the archive.
+ */
+class StoredBuffer : public std::streambuf {
+public:
+    StoredBuffer(const char* data, std::size_t size) {
+        auto begin = const_cast<char*>(data);
+        setg(begin, begin, begin + size);
+    }
+};
+
+/**
+ Input stream buffer that inflates a raw deflate stream from memory on demand and verifies its checksum at the end.
+ Throws dom::InvalidDataError on corrupt data, use std::ios_base::badbit in the stream's exception mask to see it.
+ */
+class InflateBuffer : public std::streambuf {
+public:
+    InflateBuffer(const char* data, std::size_t size, std::uint32_t crc);
+    ~InflateBuffer();
+
+    InflateBuffer(const InflateBuffer&) = delete;
+    InflateBuffer& operator=(const InflateBuffer&) = delete;
+
+protected:
+    int_type underflow() override;
+
+private:
+    z_stream _stream;
+    std::unique_ptr<char[]> _buffer;
+    std::uint32_t _expectedCRC;
+    std::uint32_t _crc;
+    bool _done;
+};
+
+} // namespace
+
+ZipArchive::ZipArchive(const char* data, std::size_t size) : _data(data), _size(size), _entries() {
+    if (size < kEndOfDirectorySize)
+        throw dom::InvalidDataError("Invalid ZIP archive, too small");
+
+    // The end of central directory record is followed only by a variable length comment
+    const auto lowest = size - kEndOfDirectorySize - std::min(size - kEndOfDirectorySize, kMaximumCommentSize);
+    auto position = size - kEndOfDirectorySize;
+    while (read32(data + position) != kEndOfDirectorySignature) {
+        if (position == lowest)
+            throw dom::InvalidDataError("Invalid ZIP archive, end of central directory not found");
+        position -= 1;
+    }
+
+    const auto end = data + position;
+    const std::size_t count = read16(end + 10);
+    const std::size_t directorySize = read32(end + 12);
+    const std::size_t directoryOffset = read32(end + 16);
+    if (count == 0xffff || directorySize == 0xffffffff || directoryOffset == 0xffffffff)
+        throw dom::InvalidDataError("ZIP64 archives are not supported");
+    if (directoryOffset > position || directorySize > position - directoryOffset)
+        throw dom::InvalidDataError("Invalid ZIP archive, central directory out of bounds");
+
+    _entries.reserve(count);
+    auto header = data + directoryOffset;
+    const auto directoryEnd = header + directorySize;
+    for (std::size_t index = 0; index < count; index += 1) {
+        if (directoryEnd - header < static_cast<std::ptrdiff_t>(kCentralHeaderSize) || read32(header) != kCentralHeaderSignature)
+            throw dom::InvalidDataError("Invalid ZIP archive, bad central directory entry");
+
+        const std::size_t nameSize = read16(header + 28);
+        const std::size_t extraSize = read16(header + 30);
+        const std::size_t commentSize = read16(header + 32);
+        const auto next = header + kCentralHeaderSize + nameSize + extraSize + commentSize;
+        if (next > directoryEnd)
+            throw dom::InvalidDataError("Invalid ZIP archive, bad central directory entry");
+
+        Entry entry;
+        entry.name.assign(header + kCentralHeaderSize, nameSize);
+        entry.flags = read16(header + 8);
+        entry.method = read16(header + 10);
+        entry.crc = read32(header + 16);
+        entry.compressedSize = read32(header + 20);
+        entry.size = read32(header + 24);
+        entry.headerOffset = read32(header + 42);
+        _entries.push_back(std::move(entry));
+
+        header = next;
+    }
+}
+
+bool ZipArchive::isArchive(const char* data, std::size_t size) {
+    return size >= 4 && read32(data) == kLocalHeaderSignature;
+}
+
+const ZipArchive::Entry* ZipArchive::find(const std::string& name) const {
+    auto it = std::find_if(_entries.begin(), _entries.end(), [&](const Entry& entry) {
+        return entry.name == name;
+    });
+    if (it == _entries.end())
+        return nullptr;
+    return &*it;
+}
+
+std::unique_ptr<std::streambuf> ZipArchive::open(const Entry& entry) const {
+    if (entry.flags & kEncryptedFlag)
+        throw dom::InvalidDataError("Encrypted ZIP entries are not supported: " + entry.name);
+
+    // Sizes in the local header may be deferred to a data descriptor, only its variable length fields are used
+    const auto offset = entry.headerOffset;
+    if (offset > _size || _size - offset < kLocalHeaderSize || read32(_data + offset) != kLocalHeaderSignature)
+        throw dom::InvalidDataError("Invalid ZIP archive, bad local header for " + entry.name);
+
+    const auto dataOffset = offset + kLocalHeaderSize + read16(_data + offset + 26) + read16(_data + offset + 28);
+    if (dataOffset > _size || _size - dataOffset < entry.compressedSize)
+        throw dom::InvalidDataError("Invalid ZIP archive, entry out of bounds: " + entry.name);
+
+    const auto data = _data + dataOffset;
+    if (entry.method == kStoredMethod)
+        return std::unique_ptr<std::streambuf>(new StoredBuffer(data, entry.compressedSize));
+    if (entry.method == kDeflatedMethod)
+        return std::unique_ptr<std::streambuf>(new InflateBuffer(data, entry.compressedSize, entry.crc));
+    throw dom::InvalidDataError("Unsupported ZIP compression method for " + entry.name);
+}
+
+InflateBuffer::InflateBuffer(const char* data, std::size_t size, std::uint32_t crc)
+: _stream(),
+  _buffer(new char[kInflateBufferSize]),
+  _expectedCRC(crc),
+  _crc(static_cast<std::uint32_t>(crc32(0, Z_NULL, 0))),
+  _done(false)
+{
+    _stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+    _stream.avail_in = static_cast<uInt>(size);
+
+    // Negative window bits for a raw deflate stream without zlib header
+    if (inflateInit2(&_stream, -MAX_WBITS) != Z_OK)
+        throw dom::InvalidDataError("Failed to initialize zlib");
+    setg(_buffer.get(), _buffer.get(), _buffer.get());
+}
+
+InflateBuffer::~InflateBuffer() {
+    inflateEnd(&_stream);
+}
+
+InflateBuffer::int_type InflateBuffer::underflow() {
+    if (gptr() < egptr())
+        return traits_type::to_int_type(*gptr());
+
+    while (!_done) {
+        _stream.next_out = reinterpret_cast<Bytef*>(_buffer.get());
+        _stream.avail_out = static_cast<uInt>(kInflateBufferSize);
+
+        const auto status = inflate(&_stream, Z_NO_FLUSH);
+        if (status == Z_STREAM_END)
+            _done = true;
+        else if (status != Z_OK || (_stream.avail_in == 0 && _stream.avail_out != 0))
+            throw dom::InvalidDataError("Invalid compressed data");
+
+        const auto produced = kInflateBufferSize - _stream.avail_out;
+        _crc = static_cast<std::uint32_t>(crc32(_crc, reinterpret_cast<const Bytef*>(_buffer.get()), static_cast<uInt>(produced)));
+        if (_done && _crc != _expectedCRC)
+            throw dom::InvalidDataError("Compressed data checksum mismatch");
+
+        if (produced > 0) {
+            setg(_buffer.get(), _buffer.get(), _buffer.get() + produced);
+            return traits_type::to_int_type(*gptr());
+        }
+    }
+    return traits_type::eof();
+}
+
+} // namespace mxml
@@ -0,0 +1,68 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+
+namespace mxml {
+
+/**
+ Read-only view of a ZIP archive in memory, as used by compressed MusicXML (.mxl) files. Only the central directory is
+ read up front, entries are decompressed while they are read. Stored and deflated entries are supported, encrypted and
+ ZIP64 archives are not. Throws dom::InvalidDataError for archives it can't read.
+ */
+class ZipArchive {
+public:
+    struct Entry {
+        std::string name;
+        std::uint16_t flags;
+        std::uint16_t method;
+        std::uint32_t crc;
+        std::size_t compressedSize;
+        std::size_t size;
+        std::size_t headerOffset;
+    };
+
+public:
+    /**
+     Read the central directory of an archive. The data is not copied, it has to outlive the archive and every buffer
+     opened from it.
+     */
+    ZipArchive(const char* data, std::size_t size);
+
+    /**
+     Check if a buffer starts like a ZIP archive.
+     */
+    static bool isArchive(const char* data, std::size_t size);
+
+    const std::vector<Entry>& entries() const {
+        return _entries;
+    }
+
+    /**
+     Find an entry by its full path in the archive, nullptr if there is none.
+     */
+    const Entry* find(const std::string& name) const;
+
+    /**
+     Open an entry for reading. Deflated entries are inflated in small chunks as the buffer is read, the whole entry is
+     never held in memory.
+     */
+    std::unique_ptr<std::streambuf> open(const Entry& entry) const;
+
+private:
+    const char* _data;
+    std::size_t _size;
+    std::vector<Entry> _entries;
+};
+
+} // namespace mxml
@@ -25,25 +25,50 @@ void AlterSequence::addFromNote(std::size_t partIndex, std::size_t measureIndex,
     _items.push_back(item);
 }
 
-int AlterSequence::find(const Index& index, int defaultAlter) const {
-    Item modelItem;
-    modelItem.index = index;
+void AlterSequence::sort() {
+    std::stable_sort(_items.begin(), _items.end(), [](const Item& lhs, const Item& rhs) {
+        if (lhs.index.time.measureIndex != rhs.index.time.measureIndex)
+            return lhs.index.time.measureIndex < rhs.index.time.measureIndex;
+        if (!(lhs.index.line == rhs.index.line))
+            return lhs.index.line < rhs.index.line;
+        return lhs.index.time.time < rhs.index.time.time;
+    });
+
+    const auto measureCount = _items.empty() ? 0 : _items.back().index.time.measureIndex + 1;
+    _measureBegins.assign(measureCount + 1, 0);
 
+    auto it = _items.begin();
+    for (std::size_t measureIndex = 0; measureIndex < measureCount; measureIndex += 1) {
+        _measureBegins[measureIndex] = static_cast<std::size_t>(std::distance(_items.begin(), it));
+        while (it != _items.end() && it->index.time.measureIndex == measureIndex)
+            ++it;
+    }
+    _measureBegins.back() = _items.size();
+}
+
+int AlterSequence::find(const Index& index, int defaultAlter) const {
     // Only note alters on the same measure should be considered
-    auto range = std::equal_range(_items.begin(), _items.end(), modelItem, [=](const Item& item1, const Item& item2) {
-        return item1.index.time.measureIndex < item2.index.time.measureIndex;
-    });
+    const auto measureIndex = index.time.measureIndex;
+    if (measureIndex + 1 >= _measureBegins.size())
+        return defaultAlter;
+
+    const auto begin = _items.begin() + _measureBegins[measureIndex];
+    const auto end = _items.begin() + _measureBegins[measureIndex + 1];
 
-    // Find the last alter with a time before index
-    auto rbegin = std::reverse_iterator<std::vector<Item>::const_iterator>(range.second);
-    auto rend = std::reverse_iterator<std::vector<Item>::const_iterator>(range.first);
-    auto it = std::find_if(rbegin, rend, [=](const Item& item) {
-        return item.index.line == modelItem.index.line && item.index.time.time < modelItem.index.time.time;
+    // Find the last alter on the same line with a time before index
+    auto it = std::lower_bound(begin, end, index, [](const Item& item, const Index& index) {
+        if (!(item.index.line == index.line))
+            return item.index.line < index.line;
+        return item.index.time.time < index.time.time;
     });
-    if (it == rend)
+    if (it == begin)
+        return defaultAlter;
+
+    auto previous = std::prev(it);
+    if (!(previous->index.line == index.line))
         return defaultAlter;
 
-    return it->value;
+    return previous->value;
 }
 
 } // namespace mxml
@@ -10,8 +10,19 @@
 
 namespace mxml {
 
+/**
+ Accidentals in effect within each measure. Items are grouped by measure and, within a measure, by (part, staff,
+ octave, step) line sorted by time. Every line is a small contiguous list of (time, alter) pairs so finding the alter
+ for a note is a single binary search over the items of its measure.
+ */
 class AlterSequence : public AttributeSequence<int> {
 public:
+    /**
+     Sort all items by measure, line and time, call this after all alters have been added or the results will be
+     undefined.
+     */
+    void sort();
+
     /**
      Add an alter from an instance of the note node.
      */
@@ -21,6 +32,9 @@ public:
      Get active alter
      */
     int find(const Index& index, int defaultAlter) const;
+
+private:
+    std::vector<std::size_t> _measureBegins;
 };
 
 } // namespace mxml
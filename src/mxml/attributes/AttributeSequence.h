@@ -31,6 +31,7 @@ public:
 
         LineIndex() : partIndex(), staff(1), octave(), step() {}
         bool operator==(const LineIndex& rhs) const;
+        bool operator<(const LineIndex& rhs) const;
     };
     
     struct Index {
@@ -45,6 +45,17 @@ bool AttributeSequence<T>::LineIndex::operator==(const LineIndex& rhs) const {
         step == rhs.step;
 }
 
+template <typename T>
+bool AttributeSequence<T>::LineIndex::operator<(const LineIndex& rhs) const {
+    if (partIndex != rhs.partIndex)
+        return partIndex < rhs.partIndex;
+    if (staff != rhs.staff)
+        return staff < rhs.staff;
+    if (octave != rhs.octave)
+        return octave < rhs.octave;
+    return step < rhs.step;
+}
+
 template <typename T>
 bool AttributeSequence<T>::TimeIndex::operator<(const TimeIndex& rhs) const {
     if (measureIndex < rhs.measureIndex)
@@ -6,9 +6,6 @@
 
 #include "ClefSequence.h"
 
-#include <algorithm>
-#include <iterator>
-
 
 namespace mxml {
 
@@ -24,36 +21,20 @@ void ClefSequence::addFromAttributes(std::size_t partIndex, std::size_t measureI
         if (!clef)
             continue;
 
-        Item item;
-        item.index.time.measureIndex = measureIndex;
-        item.index.time.time = attributes.start();
-        item.index.line.partIndex = partIndex;
-        item.index.line.staff = staff;
-        item.value = clef;
-        _items.push_back(item);
+        addItem(partIndex, measureIndex, staff, attributes.start(), clef);
     }
 }
 
 const dom::Clef* ClefSequence::find(std::size_t partIndex, std::size_t measureIndex, int staff, dom::time_t time) const {
-    Item modelItem;
-    modelItem.index.time.measureIndex = measureIndex;
-    modelItem.index.time.time = time;
-    modelItem.index.line.partIndex = partIndex;
-    modelItem.index.line.staff = staff;
-
-    auto end = std::upper_bound(_items.begin(), _items.end(), modelItem);
-    auto rbegin = std::reverse_iterator<std::vector<Item>::const_iterator>(end);
-    auto it = std::find_if(rbegin, _items.rend(), [=](const Item& item) {
-        return item.index.line == modelItem.index.line;
-    });
-    if (it == _items.rend()) {
+    auto item = findItem(partIndex, measureIndex, staff, time);
+    if (!item) {
         if (staff == 1)
             return nullptr;
         else
             return find(partIndex, measureIndex, 1, time);
     }
 
-    return it->value;
+    return item->value;
 }
 
 } // namespace mxml
@@ -5,7 +5,7 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #pragma once
-#include "AttributeSequence.h"
+#include "StaffAttributeSequence.h"
 #include <mxml/dom/Attributes.h>
 #include <mxml/dom/Clef.h>
 #include <mxml/dom/Types.h>
@@ -13,7 +13,7 @@
 
 namespace mxml {
 
-class ClefSequence : public AttributeSequence<const dom::Clef*> {
+class ClefSequence : public StaffAttributeSequence<const dom::Clef*> {
 public:
     /**
      Add all the clefs from an instance of the attributes node.
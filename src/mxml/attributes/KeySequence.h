@@ -5,7 +5,7 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #pragma once
-#include "AttributeSequence.h"
+#include "StaffAttributeSequence.h"
 #include <mxml/dom/Attributes.h>
 #include <mxml/dom/Key.h>
 #include <mxml/dom/Types.h>
@@ -13,7 +13,7 @@
 
 namespace mxml {
 
-class KeySequence : public AttributeSequence<const dom::Key*> {
+class KeySequence : public StaffAttributeSequence<const dom::Key*> {
 public:
     /**
      Add all the keys from an instance of the attributes node.
@@ -0,0 +1,43 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+#include "AttributeSequence.h"
+
+
+namespace mxml {
+
+/**
+ Attribute sequence partitioned by (part, staff) line. Items are stored contiguously per line and sorted by time, so
+ finding the active item for a line is a single binary search regardless of how many items other lines have.
+ */
+template <typename T>
+class StaffAttributeSequence : public AttributeSequence<T> {
+public:
+    /**
+     Sort all items by line and time, call this after all attributes have been added or the results will be undefined.
+     */
+    void sort();
+
+protected:
+    using typename AttributeSequence<T>::Item;
+
+    void addItem(std::size_t partIndex, std::size_t measureIndex, int staff, dom::time_t time, T value);
+
+    /**
+     Get the last item in the given part and staff with a time before or at the given measure and time, or `nullptr`
+     if there is none.
+     */
+    const Item* findItem(std::size_t partIndex, std::size_t measureIndex, int staff, dom::time_t time) const;
+
+private:
+    std::vector<std::size_t> _partLines;
+    std::vector<std::size_t> _lineBegins;
+};
+
+} // namespace mxml
+
+#include "StaffAttributeSequence.hh"
@@ -0,0 +1,84 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "StaffAttributeSequence.h"
+
+#include <algorithm>
+#include <iterator>
+
+
+namespace mxml {
+
+template <typename T>
+void StaffAttributeSequence<T>::sort() {
+    auto& items = this->_items;
+    std::stable_sort(items.begin(), items.end(), [](const Item& lhs, const Item& rhs) {
+        if (lhs.index.line.partIndex != rhs.index.line.partIndex)
+            return lhs.index.line.partIndex < rhs.index.line.partIndex;
+        if (lhs.index.line.staff != rhs.index.line.staff)
+            return lhs.index.line.staff < rhs.index.line.staff;
+        return lhs.index.time < rhs.index.time;
+    });
+
+    // Every part gets as many lines as its highest staff number
+    std::vector<int> staves;
+    for (auto& item : items) {
+        const auto partIndex = item.index.line.partIndex;
+        if (staves.size() <= partIndex)
+            staves.resize(partIndex + 1, 0);
+        staves[partIndex] = std::max(staves[partIndex], item.index.line.staff);
+    }
+
+    _partLines.assign(staves.size() + 1, 0);
+    for (std::size_t partIndex = 0; partIndex < staves.size(); partIndex += 1)
+        _partLines[partIndex + 1] = _partLines[partIndex] + staves[partIndex];
+
+    _lineBegins.assign(_partLines.back() + 1, 0);
+    auto it = items.begin();
+    for (std::size_t line = 0; line < _partLines.back(); line += 1) {
+        _lineBegins[line] = static_cast<std::size_t>(std::distance(items.begin(), it));
+        while (it != items.end() && _partLines[it->index.line.partIndex] + it->index.line.staff - 1 == line)
+            ++it;
+    }
+    _lineBegins.back() = items.size();
+}
+
+template <typename T>
+void StaffAttributeSequence<T>::addItem(std::size_t partIndex, std::size_t measureIndex, int staff, dom::time_t time, T value) {
+    if (staff < 1)
+        return;
+
+    Item item;
+    item.index.time.measureIndex = measureIndex;
+    item.index.time.time = time;
+    item.index.line.partIndex = partIndex;
+    item.index.line.staff = staff;
+    item.value = value;
+    this->_items.push_back(item);
+}
+
+template <typename T>
+auto StaffAttributeSequence<T>::findItem(std::size_t partIndex, std::size_t measureIndex, int staff, dom::time_t time) const -> const Item* {
+    if (partIndex + 1 >= _partLines.size() || staff < 1)
+        return nullptr;
+
+    const auto line = _partLines[partIndex] + staff - 1;
+    if (line >= _partLines[partIndex + 1])
+        return nullptr;
+
+    Item modelItem;
+    modelItem.index.time.measureIndex = measureIndex;
+    modelItem.index.time.time = time;
+
+    const auto& items = this->_items;
+    const auto begin = items.begin() + _lineBegins[line];
+    auto it = std::upper_bound(begin, items.begin() + _lineBegins[line + 1], modelItem);
+    if (it == begin)
+        return nullptr;
+    return &*std::prev(it);
+}
+
+} // namespace mxml
@@ -0,0 +1,79 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Arena.h"
+
+#include <algorithm>
+#include <iterator>
+
+
+namespace mxml {
+namespace dom {
+
+namespace {
+    const std::size_t kAlignment = alignof(std::max_align_t);
+    thread_local Arena* currentArena = nullptr;
+}
+
+const std::size_t Arena::kBlockSize = 64 * 1024;
+
+Arena::Arena() : _blocks(), _blockUsed(0), _blockSize(0), _size(0) {
+}
+
+void* Arena::allocate(std::size_t size) {
+    size = (size + kAlignment - 1) & ~(kAlignment - 1);
+    if (_blocks.empty() || _blockUsed + size > _blockSize) {
+        // Allocations larger than a block get a block of their own
+        _blockSize = std::max(kBlockSize, size);
+        _blocks.push_back(Block{std::unique_ptr<char[]>(new char[_blockSize]), _blockSize});
+        _blockUsed = 0;
+    }
+
+    auto memory = _blocks.back().memory.get() + _blockUsed;
+    _blockUsed += size;
+    _size += size;
+    return memory;
+}
+
+void Arena::absorb(Arena& other) {
+    if (_blocks.empty()) {
+        _blockUsed = other._blockUsed;
+        _blockSize = other._blockSize;
+    }
+
+    // Keep the block being allocated from at the back
+    _blocks.insert(_blocks.begin(), std::make_move_iterator(other._blocks.begin()), std::make_move_iterator(other._blocks.end()));
+    _size += other._size;
+
+    other._blocks.clear();
+    other._blockUsed = 0;
+    other._blockSize = 0;
+    other._size = 0;
+}
+
+bool Arena::contains(const void* pointer) const {
+    // Nodes are usually looked up right after they were allocated, from the last block
+    auto address = static_cast<const char*>(pointer);
+    for (auto it = _blocks.rbegin(); it != _blocks.rend(); ++it) {
+        auto begin = it->memory.get();
+        if (address >= begin && address < begin + it->size)
+            return true;
+    }
+    return false;
+}
+
+Arena* Arena::current() {
+    return currentArena;
+}
+
+Arena* Arena::setCurrent(Arena* arena) {
+    auto previous = currentArena;
+    currentArena = arena;
+    return previous;
+}
+
+} // namespace dom
+} // namespace mxml
@@ -0,0 +1,79 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+
+namespace mxml {
+namespace dom {
+
+/**
+ Monotonic memory arena for dom nodes. Memory is handed out sequentially from large blocks and is only released when
+ the arena is destroyed, deleting a node allocated from an arena runs its destructor but does not free its memory.
+
+ While an arena is current on a thread every dom node created on that thread is allocated from it. The arena has to
+ outlive all the nodes allocated from it.
+ */
+class Arena {
+public:
+    static const std::size_t kBlockSize;
+
+public:
+    Arena();
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /**
+     Allocate memory aligned for any type.
+     */
+    void* allocate(std::size_t size);
+
+    /**
+     Return true if the memory at the given address was allocated from the arena.
+     */
+    bool contains(const void* pointer) const;
+
+    /**
+     Take over the memory of another arena, the nodes allocated from it then live as long as this arena. The other arena
+     is left empty.
+     */
+    void absorb(Arena& other);
+
+    /**
+     Get the total number of bytes allocated from the arena.
+     */
+    std::size_t size() const {
+        return _size;
+    }
+
+    /**
+     Get the arena that nodes on the current thread are allocated from, if any.
+     */
+    static Arena* current();
+
+    /**
+     Set the arena that nodes on the current thread are allocated from. Returns the previous arena.
+     */
+    static Arena* setCurrent(Arena* arena);
+
+private:
+    struct Block {
+        std::unique_ptr<char[]> memory;
+        std::size_t size;
+    };
+
+private:
+    std::vector<Block> _blocks;
+    std::size_t _blockUsed;
+    std::size_t _blockSize;
+    std::size_t _size;
+};
+
+} // namespace dom
+} // namespace mxml
@@ -20,7 +20,7 @@ namespace dom {
 
 class Attributes : public Node {
 public:
-    Attributes() : _divisions(1), _staves(1), _clefs(1), _keys(1), _time(), _start() {}
+    Attributes() : Node(Kind::Attributes), _divisions(1), _staves(1), _clefs(1), _keys(1), _time(), _start() {}
     
     Optional<int> divisions() const {
         return _divisions;
@@ -45,6 +45,13 @@ public:
         return nullptr;
     }
     void setClef(int number, std::unique_ptr<Clef>&& clef);
+
+    /**
+     Get the clef of every staff, staves without a clef of their own have a null entry.
+     */
+    const std::vector<std::unique_ptr<Clef>>& clefs() const {
+        return _clefs;
+    }
     
     const Key* key(int number) const {
         if (number > 0 && number <= _keys.size())
@@ -57,6 +64,13 @@ public:
         return nullptr;
     }
     void setKey(int number, std::unique_ptr<Key> key);
+
+    /**
+     Get the key of every staff, staves without a key of their own have a null entry.
+     */
+    const std::vector<std::unique_ptr<Key>>& keys() const {
+        return _keys;
+    }
     
     const Time* time() const {
         return _time.get();
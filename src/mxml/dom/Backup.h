@@ -11,6 +11,8 @@ namespace mxml {
 namespace dom {
 
 class Backup : public TimedNode {
+public:
+    Backup() : TimedNode(Kind::Backup) {}
 };
 
 } // namespace dom
@@ -36,7 +36,7 @@ public:
     };
     
 public:
-    Barline() : _style(Style::Regular), _location(Location::Middle), _ending(), _repeat() {}
+    Barline() : Node(Kind::Barline), _style(Style::Regular), _location(Location::Middle), _ending(), _repeat() {}
     
     Style style() const {
         return _style;
@@ -14,7 +14,7 @@ namespace mxml {
         
         class Bracket : public DirectionType {
         public:
-            Bracket() : _type(kStart), _line(false), _sign(true) {}
+            Bracket() : DirectionType(Kind::Bracket), _type(kStart), _line(false), _sign(true) {}
             
             bool span() const {
                 return true;
@@ -16,7 +16,7 @@ namespace dom {
 
 class Chord : public TimedNode {
 public:
-    Chord() {}
+    Chord() : TimedNode(Kind::Chord) {}
     
     bool empty() const {
         return _notes.empty();
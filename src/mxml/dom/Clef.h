@@ -40,8 +40,8 @@ public:
     }
     
 public:
-    Clef() : _number(1), _sign(Sign::G), _line() {}
-    Clef(int number) : _number(number), _sign(Sign::G), _line() {}
+    Clef() : Node(Kind::Clef), _number(1), _sign(Sign::G), _line() {}
+    Clef(int number) : Node(Kind::Clef), _number(number), _sign(Sign::G), _line() {}
     
     int number() const {
         return _number;
@@ -27,7 +27,7 @@ public:
     };
     
 public:
-    CreditWords() {}
+    CreditWords() : justify(Justify::Left), _fontStyle(FontStyle::Normal), _fontWeight(FontWeight::Normal), _fontSize() {}
 
     const std::string& fontFamily() const {
         return _fontFamily;
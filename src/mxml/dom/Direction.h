@@ -16,7 +16,7 @@ namespace dom {
 
 class Direction : public Node {
 public:
-    Direction() : _placement(absentOptional(Placement::Above)), _type(), _staff(1), _start(0), _offset() {}
+    Direction() : Node(Kind::Direction), _placement(absentOptional(Placement::Above)), _type(), _staff(1), _start(0), _offset() {}
     
     Optional<Placement> placement() const {
         return _placement;
@@ -8,6 +8,7 @@
 #include "Node.h"
 #include "Optional.h"
 #include "Position.h"
+#include "StringTable.h"
 
 #include <string>
 
@@ -17,6 +18,7 @@ namespace dom {
 class DirectionType : public Node {
 public:
     DirectionType() = default;
+    explicit DirectionType(Kind kind) : Node(kind) {}
     virtual ~DirectionType() = default;
     
     /** Return true if this direction type has start and stop elements. */
@@ -28,8 +30,10 @@ public:
 
 class Dynamics : public DirectionType {
 public:
+    Dynamics() : DirectionType(Kind::Dynamics) {}
+
     const std::string& string() const {
-        return _string;
+        return _string.str();
     }
     void setString(const std::string& string) {
         _string = string;
@@ -40,13 +44,15 @@ public:
     }
     
 private:
-    std::string _string;
+    InternedString _string;
 };
 
 class Words : public DirectionType {
 public:
+    Words() : DirectionType(Kind::Words) {}
+
     const std::string& contents() const {
-        return _contents;
+        return _contents.str();
     }
     void setContents(const std::string& contents) {
         _contents = contents;
@@ -57,11 +63,13 @@ public:
     }
     
 private:
-    std::string _contents;
+    InternedString _contents;
 };
 
 class Segno : public DirectionType {
 public:
+    Segno() : DirectionType(Kind::Segno) {}
+
     bool span() const {
         return false;
     }
@@ -69,6 +77,8 @@ public:
 
 class Coda : public DirectionType {
 public:
+    Coda() : DirectionType(Kind::Coda) {}
+
     bool span() const {
         return false;
     }
@@ -11,6 +11,8 @@ namespace mxml {
 namespace dom {
 
 class Forward : public TimedNode {
+public:
+    Forward() : TimedNode(Kind::Forward) {}
 };
 
 } // namespace dom
@@ -28,8 +28,8 @@ public:
     };
     
 public:
-    Key() : _number(1), _printObject(true), _cancel(), _fifths(), _mode(Mode::Major) {}
-    Key(const Key& rhs) : _number(rhs.number()), _printObject(rhs.printObject()), _cancel(rhs.cancel()), _fifths(rhs.fifths()), _mode(rhs.mode()) {}
+    Key() : Node(Kind::Key), _number(1), _printObject(true), _cancel(), _fifths(), _mode(Mode::Major) {}
+    Key(const Key& rhs) : Node(Kind::Key), _number(rhs.number()), _printObject(rhs.printObject()), _cancel(rhs.cancel()), _fifths(rhs.fifths()), _mode(rhs.mode()) {}
     
     int number() const {
         return _number;
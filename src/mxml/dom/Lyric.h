@@ -6,6 +6,7 @@
 
 #pragma once
 #include "Node.h"
+#include "StringTable.h"
 #include "Syllabic.h"
 #include "Types.h"
 
@@ -26,7 +27,7 @@ public:
     }
 
     const std::string& name() const {
-        return _name;
+        return _name.str();
     }
     void setName(const std::string& name) {
         _name = name;
@@ -61,7 +62,7 @@ public:
     }
 
     const std::string& text() const {
-        return _text;
+        return _text.str();
     }
     void setText(const std::string& text) {
         _text = text;
@@ -69,13 +70,13 @@ public:
     
 private:
     int _number;
-    std::string _name;
+    InternedString _name;
     Placement _placement;
     bool _printObject;
 
     std::unique_ptr<StartStopContinue> _extend;
     std::unique_ptr<Syllabic> _syllabic;
-    std::string _text;
+    InternedString _text;
 };
 
 } // namespace dom
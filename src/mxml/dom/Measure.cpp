@@ -9,7 +9,7 @@
 namespace mxml {
 namespace dom {
 
-Measure::Measure() : _index(), _number() {}
+Measure::Measure() : Node(Kind::Measure), _index(), _number() {}
 
 } // namespace dom
 } // namespace mxml
@@ -6,6 +6,7 @@
 
 #pragma once
 #include "Node.h"
+#include "StringTable.h"
 #include "TimedNode.h"
 
 #include <map>
@@ -40,7 +41,7 @@ public:
      The measure number or label. It is usually a number stating at 1, but it can be any arbitraty string.
      */
     const std::string& number() const {
-        return _number;
+        return _number.str();
     }
     void setNumber(const std::string& number) {
         _number = number;
@@ -60,7 +61,7 @@ public:
 
 private:
     std::size_t _index;
-    std::string _number;
+    InternedString _number;
     std::vector<std::unique_ptr<Node>> _nodes;
 };
 
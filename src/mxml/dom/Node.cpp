@@ -0,0 +1,54 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Node.h"
+#include "Arena.h"
+
+#include <new>
+
+
+namespace mxml {
+namespace dom {
+
+namespace {
+    // Set by the destructor of every node for the operator delete that may follow it
+    thread_local bool destroyedInArena = false;
+}
+
+Node::~Node() {
+    destroyedInArena = _inArena;
+}
+
+bool Node::isInCurrentArena(const Node* node) {
+    auto arena = Arena::current();
+    return arena && arena->contains(node);
+}
+
+void* Node::operator new(std::size_t size) {
+    if (auto arena = Arena::current())
+        return arena->allocate(size);
+    return ::operator new(size);
+}
+
+void Node::operator delete(void* pointer) {
+    if (!pointer)
+        return;
+
+    // Arena memory is released all at once when the arena is destroyed. A node whose constructor never ran can only
+    // come from the arena that is still current.
+    const bool inArena = destroyedInArena;
+    destroyedInArena = false;
+    if (inArena)
+        return;
+    if (auto arena = Arena::current()) {
+        if (arena->contains(pointer))
+            return;
+    }
+    ::operator delete(pointer);
+}
+
+} // namespace dom
+} // namespace mxml
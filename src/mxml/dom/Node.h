@@ -5,15 +5,67 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #pragma once
+#include <cstddef>
+#include <cstdint>
 
 namespace mxml {
 namespace dom {
 
 class Node {
 public:
-    Node() : _parent() {}
-    virtual ~Node() {}
-    
+    /**
+     Concrete type of a node, for the types that traversals dispatch on. Switching on the kind avoids chains of
+     dynamic_casts in the hot paths. Node types that nobody dispatches on have kind Other.
+     */
+    enum class Kind : std::uint8_t {
+        Other,
+        Attributes,
+        Backup,
+        Barline,
+        Chord,
+        Clef,
+        Direction,
+        Forward,
+        Key,
+        Measure,
+        Note,
+        Print,
+        Time,
+
+        // Direction types
+        Bracket,
+        Coda,
+        Dynamics,
+        OctaveShift,
+        Pedal,
+        Segno,
+        Wedge,
+        Words
+    };
+
+public:
+    Node() : _parent(), _kind(Kind::Other), _inArena(isInCurrentArena(this)) {}
+    explicit Node(Kind kind) : _parent(), _kind(kind), _inArena(isInCurrentArena(this)) {}
+    virtual ~Node();
+
+    /**
+     Nodes are allocated from the current Arena, if there is one, and from the heap otherwise. Heap nodes cost the same
+     as without arenas, where the memory came from is kept in the padding of the node.
+     */
+    static void* operator new(std::size_t size);
+    static void operator delete(void* pointer);
+
+    Kind kind() const {
+        return _kind;
+    }
+
+    /**
+     Return true if the node is a TimedNode.
+     */
+    bool isTimed() const {
+        return _kind == Kind::Backup || _kind == Kind::Chord || _kind == Kind::Forward || _kind == Kind::Note;
+    }
+
     const Node* parent() const {
         return _parent;
     }
@@ -22,9 +74,13 @@ public:
     }
     
 protected:
-    // Nodes are only copyable within the dom
-    Node(const Node& rhs) = default;
-    Node& operator=(const Node& rhs) = default;
+    // Nodes are only copyable within the dom, where the memory of a node came from is not copied
+    Node(const Node& rhs) : _parent(rhs._parent), _kind(rhs._kind), _inArena(isInCurrentArena(this)) {}
+    Node& operator=(const Node& rhs) {
+        _parent = rhs._parent;
+        _kind = rhs._kind;
+        return *this;
+    }
 
     const Node* root() const {
         const Node* root = this;
@@ -33,8 +89,13 @@ protected:
         return root;
     }
 
+private:
+    static bool isInCurrentArena(const Node* node);
+
 private:
     const Node* _parent;
+    Kind _kind;
+    bool _inArena;
 };
 
 } // namespace dom
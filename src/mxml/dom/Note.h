@@ -18,6 +18,7 @@
 #include "Position.h"
 #include "Rest.h"
 #include "Slur.h"
+#include "StringTable.h"
 #include "Tie.h"
 #include "Tied.h"
 #include "TimeModification.h"
@@ -55,12 +56,16 @@ public:
     
 public:
     Note()
-    : printObject(true),
-      _type(absentOptional(Type::Quarter)),
+    : TimedNode(Kind::Note),
+      printObject(true),
+      _measure(),
       _chord(false),
       _grace(false),
       _stem(Stem::Up, false),
-      _staff(1)
+      _staff(1),
+      _type(absentOptional(Type::Quarter)),
+      _attack(),
+      _release()
     {}
     
     const Measure* measure() const {
@@ -106,7 +111,7 @@ public:
     }
 
     const std::string& voice() const {
-        return _voice;
+        return _voice.str();
     }
     void setVoice(const std::string& voice) {
         _voice = voice;
@@ -187,7 +192,7 @@ private:
     bool _grace;
     Optional<Stem> _stem;
     int _staff;
-    std::string _voice;
+    InternedString _voice;
 
     Optional<Type> _type;
     Optional<float> _dynamics;
@@ -25,7 +25,7 @@ public:
     };
 
 public:
-    OctaveShift() : type(Type::Up), number(1), size(8)  {}
+    OctaveShift() : DirectionType(Kind::OctaveShift), type(Type::Up), number(1), size(8)  {}
 
     bool span() const {
         return true;
@@ -7,6 +7,7 @@
 #pragma once
 #include "Measure.h"
 #include "Node.h"
+#include "StringTable.h"
 
 #include <memory>
 #include <vector>
@@ -32,7 +33,7 @@ public:
     }
     
     const std::string& id() const {
-        return _id;
+        return _id.str();
     }
     void setId(const std::string& id) {
         _id = id;
@@ -58,10 +59,13 @@ public:
     void addMeasure(std::unique_ptr<Measure>&& measure) {
         _measures.push_back(std::move(measure));
     }
+    void reserveMeasures(std::size_t count) {
+        _measures.reserve(count);
+    }
     
 private:
     std::size_t _index;
-    std::string _id;
+    InternedString _id;
     std::string _name;
     std::vector<std::unique_ptr<Measure>> _measures;
 };
@@ -14,7 +14,7 @@ namespace dom {
 
 class Pedal : public DirectionType {
 public:
-    Pedal() : _type(kStart), _line(false), _sign(true) {}
+    Pedal() : DirectionType(Kind::Pedal), _type(kStart), _line(false), _sign(true) {}
 
     bool span() const {
         return true;
@@ -5,11 +5,13 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #pragma once
+#include "Arena.h"
 #include "Credit.h"
 #include "Defaults.h"
 #include "Identification.h"
 #include "Node.h"
 #include "Part.h"
+#include "StringTable.h"
 
 #include <memory>
 #include <vector>
@@ -19,7 +21,27 @@ namespace dom {
 
 class Score : public Node {
 public:
-    Score() : _parts() {}
+    Score() : _arena(), _strings(), _parts() {}
+
+    /**
+     Get the arena that the nodes of this score were allocated from, if any.
+     */
+    const std::shared_ptr<Arena>& arena() const {
+        return _arena;
+    }
+    void setArena(std::shared_ptr<Arena> arena) {
+        _arena = std::move(arena);
+    }
+
+    /**
+     Get the table that the strings of this score were interned in, if any.
+     */
+    const std::shared_ptr<StringTable>& strings() const {
+        return _strings;
+    }
+    void setStrings(std::shared_ptr<StringTable> strings) {
+        _strings = std::move(strings);
+    }
     
     const std::unique_ptr<Identification>& identification() const {
         return _identification;
@@ -50,6 +72,10 @@ public:
     }
     
 private:
+    // Declared first so that the arena and strings are destroyed after all the nodes using them
+    std::shared_ptr<Arena> _arena;
+    std::shared_ptr<StringTable> _strings;
+
     std::unique_ptr<Identification> _identification;
     std::unique_ptr<Defaults> _defaults;
     std::vector<std::unique_ptr<Credit>> _credits;
@@ -0,0 +1,97 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "StringTable.h"
+
+
+namespace mxml {
+namespace dom {
+
+namespace {
+    thread_local StringTable* currentTable = nullptr;
+}
+
+StringTable::StringTable() : _strings(), _absorbed() {
+}
+
+const std::string& StringTable::intern(const std::string& string) {
+    return *_strings.insert(string).first;
+}
+
+void StringTable::absorb(StringTable& other) {
+    // The strings stay where they are, only the table owning them changes
+    std::unique_ptr<StringTable> table(new StringTable());
+    table->_strings.swap(other._strings);
+    table->_absorbed.swap(other._absorbed);
+    _absorbed.push_back(std::move(table));
+}
+
+std::size_t StringTable::size() const {
+    auto size = _strings.size();
+    for (auto& table : _absorbed)
+        size += table->size();
+    return size;
+}
+
+StringTable* StringTable::current() {
+    return currentTable;
+}
+
+StringTable* StringTable::setCurrent(StringTable* table) {
+    auto previous = currentTable;
+    currentTable = table;
+    return previous;
+}
+
+InternedString& InternedString::operator=(const InternedString& other) {
+    if (this != &other)
+        assign(other.str());
+    return *this;
+}
+
+InternedString& InternedString::operator=(InternedString&& other) {
+    if (this == &other)
+        return *this;
+    if (other._bits & kOwnedBit) {
+        release();
+        _bits = other._bits;
+        other._bits = 0;
+    } else {
+        assign(other.str());
+    }
+    return *this;
+}
+
+void InternedString::assign(const std::string& string) {
+    const std::string* pointer = nullptr;
+    std::uintptr_t owned = 0;
+    if (string.empty()) {
+        // The empty string needs no storage
+    } else if (currentTable) {
+        pointer = &currentTable->intern(string);
+    } else {
+        pointer = new std::string(string);
+        owned = kOwnedBit;
+    }
+
+    // The string may belong to this handle
+    release();
+    _bits = reinterpret_cast<std::uintptr_t>(pointer) | owned;
+}
+
+void InternedString::release() {
+    if (_bits & kOwnedBit)
+        delete reinterpret_cast<std::string*>(_bits & ~kOwnedBit);
+    _bits = 0;
+}
+
+const std::string& InternedString::empty() {
+    static const std::string string;
+    return string;
+}
+
+} // namespace dom
+} // namespace mxml
@@ -0,0 +1,117 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+
+namespace mxml {
+namespace dom {
+
+/**
+ Table of distinct strings shared by the nodes of a score. Voices, measure numbers and the like repeat a lot, the nodes
+ only keep a reference to the one copy in the table.
+
+ While a table is current on a thread every InternedString assigned on that thread is added to it, otherwise the handle
+ keeps its own copy of the string. The table has to outlive all the nodes referring to it.
+ */
+class StringTable {
+public:
+    StringTable();
+    StringTable(const StringTable&) = delete;
+    StringTable& operator=(const StringTable&) = delete;
+
+    /**
+     Get the copy of a string in the table, adding it if needed. The reference is valid as long as the table is.
+     */
+    const std::string& intern(const std::string& string);
+
+    /**
+     Take over the strings of another table, the nodes referring to them then need this table to stay alive instead. The
+     other table is left empty.
+     */
+    void absorb(StringTable& other);
+
+    /**
+     Get the number of strings in the table.
+     */
+    std::size_t size() const;
+
+    /**
+     Get the table that strings on the current thread are interned in, if any.
+     */
+    static StringTable* current();
+
+    /**
+     Set the table that strings on the current thread are interned in. Returns the previous table.
+     */
+    static StringTable* setCurrent(StringTable* table);
+
+private:
+    std::unordered_set<std::string> _strings;
+    std::vector<std::unique_ptr<StringTable>> _absorbed;
+};
+
+/**
+ Handle to a string, the size of a pointer. Strings assigned while a StringTable is current refer to the copy in that
+ table, other strings are owned by the handle. Copies are interned in the current table, or owned if there is none, so
+ a copy never depends on the table of the original.
+ */
+class InternedString {
+public:
+    InternedString() : _bits(0) {}
+    explicit InternedString(const std::string& string) : _bits(0) {
+        assign(string);
+    }
+    InternedString(const InternedString& other) : _bits(0) {
+        assign(other.str());
+    }
+    InternedString(InternedString&& other) : _bits(0) {
+        *this = std::move(other);
+    }
+    ~InternedString() {
+        release();
+    }
+
+    InternedString& operator=(const std::string& string) {
+        assign(string);
+        return *this;
+    }
+    InternedString& operator=(const InternedString& other);
+    InternedString& operator=(InternedString&& other);
+
+    const std::string& str() const {
+        return _bits ? *reinterpret_cast<const std::string*>(_bits & ~kOwnedBit) : empty();
+    }
+
+    /**
+     Whether the string lives in a StringTable instead of the handle.
+     */
+    bool interned() const {
+        return _bits != 0 && (_bits & kOwnedBit) == 0;
+    }
+
+private:
+    void assign(const std::string& string);
+    void release();
+
+    static const std::string& empty();
+
+private:
+    static const std::uintptr_t kOwnedBit = 1;
+
+    // Pointer to the string, the low bit is set if the handle owns it
+    std::uintptr_t _bits;
+};
+
+} // namespace dom
+} // namespace mxml
@@ -15,6 +15,7 @@ namespace dom {
 class TimedNode : public Node {
 public:
     TimedNode() : _start(), _duration() {}
+    explicit TimedNode(Kind kind) : Node(kind), _start(), _duration() {}
     virtual ~TimedNode() {}
     
     time_t start() const {
@@ -20,7 +20,7 @@ public:
     };
     
 public:
-    Wedge() : _type(), _number(1), _spread(15), _niente(false) {}
+    Wedge() : DirectionType(Kind::Wedge), _type(), _number(1), _spread(15), _niente(false) {}
     
     bool span() const {
         return true;
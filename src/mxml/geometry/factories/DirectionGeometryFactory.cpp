@@ -53,8 +53,8 @@ std::vector<std::unique_ptr<PlacementGeometry>> DirectionGeometryFactory::build(
 
     for (auto& measure: _measureGeometries) {
         for (auto& node : measure->measure().nodes()) {
-            if (const dom::Direction* direction = dynamic_cast<const dom::Direction*>(node.get()))
-                buildDirection(*measure, *direction);
+            if (node->kind() == dom::Node::Kind::Direction)
+                buildDirection(*measure, static_cast<const dom::Direction&>(*node));
         }
     }
 
@@ -62,18 +62,20 @@ std::vector<std::unique_ptr<PlacementGeometry>> DirectionGeometryFactory::build(
     for (auto& pair : _openSpanDirections) {
         auto measureGeometry = pair.first;
         auto direction = pair.second;
-        if (dynamic_cast<const dom::OctaveShift*>(direction->type()) && _metrics->scoreProperties().layoutType() == ScoreProperties::LayoutType::Page) {
+        auto kind = direction->type()->kind();
+        if (kind == dom::Node::Kind::OctaveShift && _metrics->scoreProperties().layoutType() == ScoreProperties::LayoutType::Page) {
             buildOctaveShiftToEdge(*measureGeometry, *direction);
-        } else if (dynamic_cast<const dom::Pedal*>(direction->type())) {
+        } else if (kind == dom::Node::Kind::Pedal) {
             buildPedalToEdge(*measureGeometry, *direction);
         }
     }
     
     // Build directions that neither started or stopped
     for (auto& direction : _previouslyOpenSpanDirections) {
-        if (dynamic_cast<const dom::OctaveShift*>(direction->type()) && _metrics->scoreProperties().layoutType() == ScoreProperties::LayoutType::Page) {
+        auto kind = direction->type()->kind();
+        if (kind == dom::Node::Kind::OctaveShift && _metrics->scoreProperties().layoutType() == ScoreProperties::LayoutType::Page) {
             buildOctaveShiftFromEdgeToEdge(*direction);
-        } else if (dynamic_cast<const dom::Pedal*>(direction->type())) {
+        } else if (kind == dom::Node::Kind::Pedal) {
             buildPedalFromEdgeToEdge(*direction);
         }
     }
@@ -82,40 +84,41 @@ std::vector<std::unique_ptr<PlacementGeometry>> DirectionGeometryFactory::build(
 }
 
 void DirectionGeometryFactory::buildDirection(const MeasureGeometry& measureGeom, const dom::Direction& direction) {
-    if (dynamic_cast<const dom::Wedge*>(direction.type())) {
-        buildWedge(measureGeom, direction);
+    if (!direction.type())
         return;
-    }
 
-    if (dynamic_cast<const dom::Pedal*>(direction.type())) {
-        buildPedal(measureGeom, direction);
-        return;
-    }
+    switch (direction.type()->kind()) {
+        case dom::Node::Kind::Wedge:
+            buildWedge(measureGeom, direction);
+            break;
 
-    if (dynamic_cast<const dom::OctaveShift*>(direction.type())) {
-        buildOctaveShift(measureGeom, direction);
-        return;
-    }
+        case dom::Node::Kind::Pedal:
+            buildPedal(measureGeom, direction);
+            break;
 
-    if (dynamic_cast<const dom::Coda*>(direction.type())) {
-        buildCoda(measureGeom, direction);
-        return;
-    }
+        case dom::Node::Kind::OctaveShift:
+            buildOctaveShift(measureGeom, direction);
+            break;
 
-    if (dynamic_cast<const dom::Segno*>(direction.type())) {
-        buildSegno(measureGeom, direction);
-        return;
-    }
+        case dom::Node::Kind::Coda:
+            buildCoda(measureGeom, direction);
+            break;
 
-    if (dynamic_cast<const dom::Words*>(direction.type()) ||
-        dynamic_cast<const dom::Dynamics*>(direction.type()) ) {
-        buildWords(measureGeom, direction);
-        return;
-    }
-    
-    if (dynamic_cast<const dom::Bracket*>(direction.type())) {
-        buildBracket(measureGeom, direction);
-        return;
+        case dom::Node::Kind::Segno:
+            buildSegno(measureGeom, direction);
+            break;
+
+        case dom::Node::Kind::Words:
+        case dom::Node::Kind::Dynamics:
+            buildWords(measureGeom, direction);
+            break;
+
+        case dom::Node::Kind::Bracket:
+            buildBracket(measureGeom, direction);
+            break;
+
+        default:
+            break;
     }
 }
 
@@ -49,12 +49,17 @@ std::unique_ptr<MeasureGeometry> MeasureGeometryFactory::build(const Measure& me
         _geometry->_showNumber = true;
 
     for (auto& node : measure.nodes()) {
-        if (const Attributes* attributes = dynamic_cast<const Attributes*>(node.get())) {
-            buildAttributes(attributes);
-        } else if (const Barline* barline = dynamic_cast<const Barline*>(node.get())) {
-            buildBarline(barline);
-        } else if (const TimedNode* timedNode = dynamic_cast<const TimedNode*>(node.get())) {
-            buildTimedNode(timedNode);
+        switch (node->kind()) {
+            case Node::Kind::Attributes:
+                buildAttributes(static_cast<const Attributes*>(node.get()));
+                break;
+            case Node::Kind::Barline:
+                buildBarline(static_cast<const Barline*>(node.get()));
+                break;
+            default:
+                if (node->isTimed())
+                    buildTimedNode(static_cast<const TimedNode*>(node.get()));
+                break;
         }
     }
 
@@ -203,13 +208,13 @@ void MeasureGeometryFactory::buildBarline(const Barline* barline) {
 }
 
 void MeasureGeometryFactory::buildTimedNode(const TimedNode* node)  {
-    if (auto forward = dynamic_cast<const Forward*>(node)) {
-        _currentTime += forward->duration();
+    if (node->kind() == Node::Kind::Forward) {
+        _currentTime += node->duration();
         return;
     }
 
-    if (auto backup = dynamic_cast<const Backup*>(node)) {
-        _currentTime -= backup->duration();
+    if (node->kind() == Node::Kind::Backup) {
+        _currentTime -= node->duration();
         if (_currentTime < 0)
             _currentTime = 0;
         return;
@@ -219,10 +224,10 @@ void MeasureGeometryFactory::buildTimedNode(const TimedNode* node)  {
         _currentTime = node->start();
     }
 
-    if (auto chord = dynamic_cast<const Chord*>(node)) {
-        buildChord(chord);
-    } else if (auto note = dynamic_cast<const Note*>(node)) {
-        buildRest(note);
+    if (node->kind() == Node::Kind::Chord) {
+        buildChord(static_cast<const Chord*>(node));
+    } else if (node->kind() == Node::Kind::Note) {
+        buildRest(static_cast<const Note*>(node));
     }
 }
 
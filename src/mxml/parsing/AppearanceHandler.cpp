@@ -5,48 +5,61 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "AppearanceHandler.h"
+#include "Tags.h"
 
 #include <lxml/DoubleHandler.h>
 #include <mxml/dom/InvalidDataError.h>
-#include <cstring>
 
 
 namespace mxml {
 
-static const char* kLineWidthTag = "line-width";
-static const char* kNoteSizeTag = "note-size";
-static const char* kDistanceTag = "distance";
+using namespace parsing;
 
 void AppearanceHandler::startElement(const lxml::QName& qname, const AttributeMap& attributes) {
     _result = dom::Appearance{};
 }
 
 lxml::RecursiveHandler* AppearanceHandler::startSubElement(const lxml::QName& qname) {
-    if (strcmp(qname.localName(), kLineWidthTag) == 0)
-        return &_handler;
-    else if (strcmp(qname.localName(), kNoteSizeTag) == 0)
-        return &_handler;
-    else if (strcmp(qname.localName(), kDistanceTag) == 0)
-        return &_handler;
+    _subElementTag = elementTag(qname);
+    switch (_subElementTag) {
+        case Tag::LineWidth:
+        case Tag::NoteSize:
+        case Tag::Distance:
+            return &_handler;
+        default:
+            break;
+    }
     return 0;
 }
 
 void AppearanceHandler::endSubElement(const lxml::QName& qname, RecursiveHandler* parser) {
-    if (strcmp(qname.localName(), kLineWidthTag) == 0) {
-        auto lineWidthNode = _handler.result();
-        auto type = lineTypeFromString(lineWidthNode->attribute("type"));
-        auto value = lxml::DoubleHandler::parseDouble(lineWidthNode->text());
-        _result.lineWidths[type] = static_cast<dom::tenths_t>(value);
-    } else if (strcmp(qname.localName(), kNoteSizeTag) == 0) {
-        auto sizeNode = _handler.result();
-        auto type = noteTypeFromString(sizeNode->attribute("type"));
-        auto value = lxml::DoubleHandler::parseDouble(sizeNode->text());
-        _result.noteSizes[type] = static_cast<dom::tenths_t>(value);
-    } else if (strcmp(qname.localName(), kDistanceTag) == 0) {
-        auto distanceNode = _handler.result();
-        auto type = distanceTypeFromString(distanceNode->attribute("type"));
-        auto value = lxml::DoubleHandler::parseDouble(distanceNode->text());
-        _result.distances[type] = static_cast<dom::tenths_t>(value);
+    switch (_subElementTag) {
+        case Tag::LineWidth: {
+            auto tree = _handler.result();
+            auto& lineWidthNode = tree->root();
+            auto type = lineTypeFromString(lineWidthNode.attribute("type"));
+            auto value = lxml::DoubleHandler::parseDouble(lineWidthNode.text());
+            _result.lineWidths[type] = static_cast<dom::tenths_t>(value);
+            break;
+        }
+        case Tag::NoteSize: {
+            auto tree = _handler.result();
+            auto& sizeNode = tree->root();
+            auto type = noteTypeFromString(sizeNode.attribute("type"));
+            auto value = lxml::DoubleHandler::parseDouble(sizeNode.text());
+            _result.noteSizes[type] = static_cast<dom::tenths_t>(value);
+            break;
+        }
+        case Tag::Distance: {
+            auto tree = _handler.result();
+            auto& distanceNode = tree->root();
+            auto type = distanceTypeFromString(distanceNode.attribute("type"));
+            auto value = lxml::DoubleHandler::parseDouble(distanceNode.text());
+            _result.distances[type] = static_cast<dom::tenths_t>(value);
+            break;
+        }
+        default:
+            break;
     }
 }
 
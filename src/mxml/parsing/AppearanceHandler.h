@@ -10,6 +10,7 @@
 #include <memory>
 
 #include "GenericNodeHandler.h"
+#include "Tags.h"
 
 namespace mxml {
 
@@ -25,6 +26,7 @@ public:
     
 private:
     parsing::GenericNodeHandler _handler;
+    parsing::Tag _subElementTag;
 };
 
 } // namespace mxml
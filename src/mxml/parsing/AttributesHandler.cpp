@@ -5,19 +5,15 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "AttributesHandler.h"
-#include <cstring>
+#include "Tags.h"
 
 namespace mxml {
 
+using namespace parsing;
+
 using dom::Attributes;
 using lxml::QName;
 
-static const char* kDivisionsTag = "divisions";
-static const char* kStavesTag = "staves";
-static const char* kClefTag = "clef";
-static const char* kTimeTag = "time";
-static const char* kKeyTag = "key";
-
 void AttributesHandler::startElement(const QName& qname, const AttributeMap& attributes) {
     _result.reset(new Attributes());
 }
@@ -26,38 +22,53 @@ void AttributesHandler::endElement(const QName& qname, const std::string& conten
 }
 
 lxml::RecursiveHandler* AttributesHandler::startSubElement(const QName& qname) {
-    if (strcmp(qname.localName(), kDivisionsTag) == 0)
-        return &_integerHandler;
-    else if (strcmp(qname.localName(), kStavesTag) == 0)
-        return &_integerHandler;
-    else if (strcmp(qname.localName(), kClefTag) == 0)
-        return &_clefHandler;
-    else if (strcmp(qname.localName(), kTimeTag) == 0)
-        return &_timeHandler;
-    else if (strcmp(qname.localName(), kKeyTag) == 0)
-        return &_keyHandler;
+    _subElementTag = elementTag(qname);
+    switch (_subElementTag) {
+        case Tag::Divisions:
+        case Tag::Staves:
+            return &_integerHandler;
+        case Tag::Clef:
+            return &_clefHandler;
+        case Tag::Time:
+            return &_timeHandler;
+        case Tag::Key:
+            return &_keyHandler;
+        default:
+            break;
+    }
     return 0;
 }
 
 void AttributesHandler::endSubElement(const QName& qname, RecursiveHandler* parser) {
     using dom::presentOptional;
 
-    if (strcmp(qname.localName(), kDivisionsTag) == 0)
-        _result->setDivisions(presentOptional(_integerHandler.result()));
-    else if (strcmp(qname.localName(), kStavesTag) == 0)
-        _result->setStaves(presentOptional(_integerHandler.result()));
-    else if (strcmp(qname.localName(), kClefTag) == 0) {
-        std::unique_ptr<dom::Clef> clef = std::move(_clefHandler.result());
-        clef->setParent(_result.get());
-        _result->setClef(clef->number(), std::move(clef));
-    } else if (strcmp(qname.localName(), kTimeTag) == 0) {
-        std::unique_ptr<dom::Time> time = std::move(_timeHandler.result());
-        time->setParent(_result.get());
-        _result->setTime(std::move(time));
-    } else if (strcmp(qname.localName(), kKeyTag) == 0) {
-        std::unique_ptr<dom::Key> key = std::move(_keyHandler.result());
-        key->setParent(_result.get());
-        _result->setKey(key->number(), std::move(key));
+    switch (_subElementTag) {
+        case Tag::Divisions:
+            _result->setDivisions(presentOptional(_integerHandler.result()));
+            break;
+        case Tag::Staves:
+            _result->setStaves(presentOptional(_integerHandler.result()));
+            break;
+        case Tag::Clef: {
+            std::unique_ptr<dom::Clef> clef = std::move(_clefHandler.result());
+            clef->setParent(_result.get());
+            _result->setClef(clef->number(), std::move(clef));
+            break;
+        }
+        case Tag::Time: {
+            std::unique_ptr<dom::Time> time = std::move(_timeHandler.result());
+            time->setParent(_result.get());
+            _result->setTime(std::move(time));
+            break;
+        }
+        case Tag::Key: {
+            std::unique_ptr<dom::Key> key = std::move(_keyHandler.result());
+            key->setParent(_result.get());
+            _result->setKey(key->number(), std::move(key));
+            break;
+        }
+        default:
+            break;
     }
 }
 
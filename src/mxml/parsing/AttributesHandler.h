@@ -10,6 +10,7 @@
 #include <lxml/IntegerHandler.h>
 #include "KeyHandler.h"
 #include "TimeHandler.h"
+#include "Tags.h"
 
 #include <mxml/dom/Attributes.h>
 #include <memory>
@@ -29,6 +30,7 @@ private:
     lxml::IntegerHandler _integerHandler;
     TimeHandler _timeHandler;
     KeyHandler _keyHandler;
+    parsing::Tag _subElementTag;
 };
 
 } // namespace mxml
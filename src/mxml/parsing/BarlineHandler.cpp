@@ -5,43 +5,53 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "BarlineHandler.h"
+#include "Tags.h"
 #include <mxml/dom/InvalidDataError.h>
 
 namespace mxml {
 
+using namespace parsing;
+
 using dom::Barline;
 using lxml::QName;
 
-static const char* kStyleTag = "bar-style";
-static const char* kLocationTag = "location";
-static const char* kEndingTag = "ending";
-static const char* kRepeatTag = "repeat";
-
 void BarlineHandler::startElement(const QName& qname, const AttributeMap& attributes) {
     _result.reset(new Barline());
 }
 
 lxml::RecursiveHandler* BarlineHandler::startSubElement(const QName& qname) {
-    if (strcmp(qname.localName(), kStyleTag) == 0)
-        return &_stringHandler;
-    else if (strcmp(qname.localName(), kLocationTag) == 0)
-        return &_stringHandler;
-    else if (strcmp(qname.localName(), kEndingTag) == 0)
-        return &_endingHandler;
-    else if (strcmp(qname.localName(), kRepeatTag) == 0)
-        return &_repeatHandler;
+    _subElementTag = elementTag(qname);
+    switch (_subElementTag) {
+        case Tag::BarStyle:
+        case Tag::Location:
+            return &_stringHandler;
+        case Tag::Ending:
+            return &_endingHandler;
+        case Tag::Repeat:
+            return &_repeatHandler;
+        default:
+            break;
+    }
     return 0;
 }
 
 void BarlineHandler::endSubElement(const QName& qname, RecursiveHandler* parser) {
-    if (strcmp(qname.localName(), kStyleTag) == 0)
-        _result->setStyle(styleFromString(_stringHandler.result()));
-    else if (strcmp(qname.localName(), kLocationTag) == 0)
-        _result->setLocation(locationFromString(_stringHandler.result()));
-    else if (strcmp(qname.localName(), kEndingTag) == 0)
-        _result->setEnding(_endingHandler.result());
-    else if (strcmp(qname.localName(), kRepeatTag) == 0)
-        _result->setRepeat(_repeatHandler.result());
+    switch (_subElementTag) {
+        case Tag::BarStyle:
+            _result->setStyle(styleFromString(_stringHandler.result()));
+            break;
+        case Tag::Location:
+            _result->setLocation(locationFromString(_stringHandler.result()));
+            break;
+        case Tag::Ending:
+            _result->setEnding(_endingHandler.result());
+            break;
+        case Tag::Repeat:
+            _result->setRepeat(_repeatHandler.result());
+            break;
+        default:
+            break;
+    }
 }
 
 Barline::Style BarlineHandler::styleFromString(const std::string& string) {
@@ -8,6 +8,7 @@
 #include <lxml/BaseRecursiveHandler.h>
 #include "EndingHandler.h"
 #include "RepeatHandler.h"
+#include "Tags.h"
 #include <lxml/StringHandler.h>
 
 #include <mxml/dom/Barline.h>
@@ -28,6 +29,7 @@ private:
     lxml::StringHandler _stringHandler;
     EndingHandler _endingHandler;
     RepeatHandler _repeatHandler;
+    parsing::Tag _subElementTag;
 };
 
 } // namespace mxml
@@ -5,17 +5,17 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "ClefHandler.h"
+#include "Tags.h"
 #include <mxml/dom/InvalidDataError.h>
-#include <cstring>
 
 namespace mxml {
 
+using namespace parsing;
+
 using dom::Clef;
 using lxml::QName;
 
 static const char* kNumberAttribute = "number";
-static const char* kSignTag = "sign";
-static const char* kLineTag = "line";
 
 void ClefHandler::startElement(const QName& qname, const AttributeMap& attributes) {
     _result.reset(new Clef());
@@ -26,18 +26,29 @@ void ClefHandler::startElement(const QName& qname, const AttributeMap& attribute
 }
 
 lxml::RecursiveHandler* ClefHandler::startSubElement(const QName& qname) {
-    if (strcmp(qname.localName(), kSignTag) == 0)
-        return &_stringHandler;
-    else if (strcmp(qname.localName(), kLineTag) == 0)
-        return &_integerHandler;
+    _subElementTag = elementTag(qname);
+    switch (_subElementTag) {
+        case Tag::Sign:
+            return &_stringHandler;
+        case Tag::Line:
+            return &_integerHandler;
+        default:
+            break;
+    }
     return 0;
 }
 
 void ClefHandler::endSubElement(const QName& qname, RecursiveHandler* parser) {
-    if (strcmp(qname.localName(), kSignTag) == 0)
-        _result->setSign(dom::presentOptional(signFromString(_stringHandler.result())));
-    else if (strcmp(qname.localName(), kLineTag) == 0)
-        _result->setLine(dom::presentOptional(_integerHandler.result()));
+    switch (_subElementTag) {
+        case Tag::Sign:
+            _result->setSign(dom::presentOptional(signFromString(_stringHandler.result())));
+            break;
+        case Tag::Line:
+            _result->setLine(dom::presentOptional(_integerHandler.result()));
+            break;
+        default:
+            break;
+    }
 }
 
 Clef::Sign ClefHandler::signFromString(const std::string& string) {
@@ -0,0 +1,65 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "ContainerHandler.h"
+#include "Tags.h"
+
+namespace mxml {
+namespace parsing {
+
+using lxml::QName;
+
+static const char* kFullPathAttribute = "full-path";
+static const char* kMediaTypeAttribute = "media-type";
+static const char* kMusicXMLMediaType = "application/vnd.recordare.musicxml+xml";
+
+void RootfileHandler::startElement(const QName& qname, const AttributeMap& attributes) {
+    _result.clear();
+
+    // A root file without a media type is MusicXML, other root files are alternative renditions like PDFs
+    auto mediaType = attributes.find(kMediaTypeAttribute);
+    if (mediaType != attributes.end() && mediaType->second != kMusicXMLMediaType)
+        return;
+
+    auto fullPath = attributes.find(kFullPathAttribute);
+    if (fullPath != attributes.end())
+        _result = fullPath->second;
+}
+
+void RootfilesHandler::startElement(const QName& qname, const AttributeMap& attributes) {
+    _result.clear();
+}
+
+lxml::RecursiveHandler* RootfilesHandler::startSubElement(const QName& qname) {
+    _subElementTag = elementTag(qname);
+    if (_subElementTag == Tag::Rootfile)
+        return &_rootfileHandler;
+    return 0;
+}
+
+void RootfilesHandler::endSubElement(const QName& qname, RecursiveHandler* parser) {
+    if (_subElementTag == Tag::Rootfile && _result.empty())
+        _result = _rootfileHandler.result();
+}
+
+void ContainerHandler::startElement(const QName& qname, const AttributeMap& attributes) {
+    _result.clear();
+}
+
+lxml::RecursiveHandler* ContainerHandler::startSubElement(const QName& qname) {
+    _subElementTag = elementTag(qname);
+    if (_subElementTag == Tag::Rootfiles)
+        return &_rootfilesHandler;
+    return 0;
+}
+
+void ContainerHandler::endSubElement(const QName& qname, RecursiveHandler* parser) {
+    if (_subElementTag == Tag::Rootfiles && _result.empty())
+        _result = _rootfilesHandler.result();
+}
+
+} // namespace parsing
+} // namespace mxml
@@ -0,0 +1,51 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+#include <lxml/BaseRecursiveHandler.h>
+#include "Tags.h"
+
+#include <string>
+
+namespace mxml {
+namespace parsing {
+
+/**
+ Handles a `rootfile` element, the result is its path if it is a MusicXML document and empty otherwise.
+ */
+class RootfileHandler : public lxml::BaseRecursiveHandler<std::string> {
+public:
+    void startElement(const lxml::QName& qname, const AttributeMap& attributes);
+};
+
+class RootfilesHandler : public lxml::BaseRecursiveHandler<std::string> {
+public:
+    void startElement(const lxml::QName& qname, const AttributeMap& attributes);
+    RecursiveHandler* startSubElement(const lxml::QName& qname);
+    void endSubElement(const lxml::QName& qname, RecursiveHandler* parser);
+
+private:
+    RootfileHandler _rootfileHandler;
+    Tag _subElementTag;
+};
+
+/**
+ Handles the `META-INF/container.xml` file of a compressed MusicXML archive. The result is the path of the first
+ MusicXML root file in the archive, empty if there is none.
+ */
+class ContainerHandler : public lxml::BaseRecursiveHandler<std::string> {
+public:
+    void startElement(const lxml::QName& qname, const AttributeMap& attributes);
+    RecursiveHandler* startSubElement(const lxml::QName& qname);
+    void endSubElement(const lxml::QName& qname, RecursiveHandler* parser);
+
+private:
+    RootfilesHandler _rootfilesHandler;
+    Tag _subElementTag;
+};
+
+} // namespace parsing
+} // namespace mxml
@@ -5,15 +5,17 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "CreditHandler.h"
+#include "Tags.h"
 #include <lxml/IntegerHandler.h>
 
 namespace mxml {
 
+using namespace parsing;
+
 using dom::Credit;
 using lxml::QName;
 
 static const char* kPageAttribute = "page";
-static const char* kCreditWordsTag = "credit-words";
 
 void CreditHandler::startElement(const QName& qname, const AttributeMap& attributes) {
     _result.reset(new Credit());
@@ -24,13 +26,14 @@ void CreditHandler::startElement(const QName& qname, const AttributeMap& attribu
 }
 
 lxml::RecursiveHandler* CreditHandler::startSubElement(const QName& qname) {
-    if (strcmp(qname.localName(), kCreditWordsTag) == 0)
+    _subElementTag = elementTag(qname);
+    if (_subElementTag == Tag::CreditWords)
         return &_creditWordsHandler;
     return 0;
 }
 
 void CreditHandler::endSubElement(const QName& qname, RecursiveHandler* parser) {
-    if (strcmp(qname.localName(), kCreditWordsTag) == 0)
+    if (_subElementTag == Tag::CreditWords)
         _result->addCreditWords(_creditWordsHandler.result());
 }
 
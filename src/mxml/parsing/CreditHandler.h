@@ -7,6 +7,7 @@
 #pragma once
 #include <lxml/BaseRecursiveHandler.h>
 #include "CreditWordsHandler.h"
+#include "Tags.h"
 
 #include <mxml/dom/Credit.h>
 
@@ -20,6 +21,7 @@ public:
     
 private:
     CreditWordsHandler _creditWordsHandler;
+    parsing::Tag _subElementTag;
 };
 
 } // namespace mxml
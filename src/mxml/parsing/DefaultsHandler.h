@@ -15,6 +15,7 @@
 #include "ScalingHandler.h"
 #include "StaffLayoutHandler.h"
 #include "SystemLayoutHandler.h"
+#include "Tags.h"
 
 
 namespace mxml {
@@ -31,6 +32,7 @@ private:
     ScalingHandler _scalingHandler;
     StaffLayoutHandler _staffLayoutHandler;
     SystemLayoutHandler _systemLayoutHandler;
+    parsing::Tag _subElementTag;
 };
 
 } // namespace mxml
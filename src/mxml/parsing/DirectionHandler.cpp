@@ -5,19 +5,17 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "DirectionHandler.h"
-#include <cstring>
+#include "Tags.h"
 
 namespace mxml {
 
+using namespace parsing;
+
 using dom::Direction;
 using dom::Placement;
 using lxml::QName;
 
 static const char* kPlacementAttribute = "placement";
-static const char* kStaffTag = "staff";
-static const char* kOffsetTag = "offset";
-static const char* kDirectionTypeTag = "direction-type";
-static const char* kSoundTag = "sound";
 
 void DirectionHandler::startElement(const QName& qname, const AttributeMap& attributes) {
     _result.reset(new Direction());
@@ -28,28 +26,41 @@ void DirectionHandler::startElement(const QName& qname, const AttributeMap& attr
 }
 
 lxml::RecursiveHandler* DirectionHandler::startSubElement(const QName& qname) {
-    if (strcmp(qname.localName(), kStaffTag) == 0)
-        return &_integerHandler;
-    else if (strcmp(qname.localName(), kOffsetTag) == 0)
-        return &_doubleHandler;
-    else if (strcmp(qname.localName(), kDirectionTypeTag) == 0)
-        return &_directionTypeHandler;
-    else if (strcmp(qname.localName(), kSoundTag) == 0)
-        return &_soundHandler;
+    _subElementTag = elementTag(qname);
+    switch (_subElementTag) {
+        case Tag::Staff:
+            return &_integerHandler;
+        case Tag::Offset:
+            return &_doubleHandler;
+        case Tag::DirectionType:
+            return &_directionTypeHandler;
+        case Tag::Sound:
+            return &_soundHandler;
+        default:
+            break;
+    }
     return 0;
 }
 
 void DirectionHandler::endSubElement(const QName& qname, RecursiveHandler* parser) {
     using dom::presentOptional;
 
-    if (strcmp(qname.localName(), kStaffTag) == 0)
-        _result->setStaff(dom::presentOptional(_integerHandler.result()));
-    else if (strcmp(qname.localName(), kOffsetTag) == 0)
-        _result->setOffset(presentOptional((float)_doubleHandler.result()));
-    else if (strcmp(qname.localName(), kDirectionTypeTag) == 0)
-        _result->setType(_directionTypeHandler.result());
-    else if (strcmp(qname.localName(), kSoundTag) == 0)
-        _result->setSound(_soundHandler.result());
+    switch (_subElementTag) {
+        case Tag::Staff:
+            _result->setStaff(dom::presentOptional(_integerHandler.result()));
+            break;
+        case Tag::Offset:
+            _result->setOffset(presentOptional((float)_doubleHandler.result()));
+            break;
+        case Tag::DirectionType:
+            _result->setType(_directionTypeHandler.result());
+            break;
+        case Tag::Sound:
+            _result->setSound(_soundHandler.result());
+            break;
+        default:
+            break;
+    }
 }
 
 Placement DirectionHandler::placementFromString(const std::string& string) {
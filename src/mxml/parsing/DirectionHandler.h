@@ -12,6 +12,7 @@
 #include <mxml/dom/Direction.h>
 #include "DirectionTypeHandler.h"
 #include "SoundHandler.h"
+#include "Tags.h"
 
 #include <memory>
 
@@ -31,6 +32,7 @@ private:
     lxml::IntegerHandler _integerHandler;
     DirectionTypeHandler _directionTypeHandler;
     SoundHandler _soundHandler;
+    parsing::Tag _subElementTag;
 };
 
 } // namespace mxml
@@ -6,9 +6,9 @@
 
 #include <lxml/DoubleHandler.h>
 #include <mxml/dom/InvalidDataError.h>
-#include <cstring>
 
 #include "DirectionTypeHandler.h"
+#include "Tags.h"
 #include "PositionFactory.h"
 
 
@@ -29,15 +29,6 @@ static const char* kSpreadAttribute = "spread";
 static const char* kLineAttribute = "line";
 static const char* kSignAttribute = "sign";
 
-static const char* kDynamicsTag = "dynamics";
-static const char* kPedalTag = "pedal";
-static const char* kWedgeTag = "wedge";
-static const char* kWordsTag = "words";
-static const char* kSegnoTag = "segno";
-static const char* kCodaTag = "coda";
-static const char* kOctaveShiftTag = "octave-shift";
-static const char* kBracketTag = "bracket";
-
 
 void DynamicsHandler::startElement(const QName& qname, const AttributeMap& attributes) {
     _result.reset(new Dynamics{});
@@ -45,31 +36,7 @@ void DynamicsHandler::startElement(const QName& qname, const AttributeMap& attri
 }
 
 lxml::RecursiveHandler* DynamicsHandler::startSubElement(const QName& qname) {
-    bool valid =
-        strcmp(qname.localName(), "f") == 0 ||
-        strcmp(qname.localName(), "ff") == 0 ||
-        strcmp(qname.localName(), "fff") == 0 ||
-        strcmp(qname.localName(), "ffff") == 0 ||
-        strcmp(qname.localName(), "fffff") == 0 ||
-        strcmp(qname.localName(), "ffffff") == 0 ||
-        strcmp(qname.localName(), "fp") == 0 ||
-        strcmp(qname.localName(), "fz") == 0 ||
-        strcmp(qname.localName(), "mf") == 0 ||
-        strcmp(qname.localName(), "mp") == 0 ||
-        strcmp(qname.localName(), "p") == 0 ||
-        strcmp(qname.localName(), "pp") == 0 ||
-        strcmp(qname.localName(), "ppp") == 0 ||
-        strcmp(qname.localName(), "pppp") == 0 ||
-        strcmp(qname.localName(), "ppppp") == 0 ||
-        strcmp(qname.localName(), "pppppp") == 0 ||
-        strcmp(qname.localName(), "rf") == 0 ||
-        strcmp(qname.localName(), "rfz") == 0 ||
-        strcmp(qname.localName(), "sf") == 0 ||
-        strcmp(qname.localName(), "sffz") == 0 ||
-        strcmp(qname.localName(), "sfp") == 0 ||
-        strcmp(qname.localName(), "sfpp") == 0 ||
-        strcmp(qname.localName(), "sfz") == 0;
-    if (valid)
+    if (isDynamicsMark(elementTag(qname)))
         _result->setString(qname.localName());
     return 0;
 }
@@ -167,42 +134,59 @@ void DirectionTypeHandler::startElement(const QName& qname, const AttributeMap&
 }
 
 lxml::RecursiveHandler* DirectionTypeHandler::startSubElement(const QName& qname) {
-    if (strcmp(qname.localName(), kDynamicsTag) == 0)
-        return &_dynamicsHandler;
-    else if (strcmp(qname.localName(), kWedgeTag) == 0)
-        return &_wedgeHandler;
-    else if (strcmp(qname.localName(), kPedalTag) == 0)
-        return &_pedalHandler;
-    else if (strcmp(qname.localName(), kWordsTag) == 0)
-        return &_wordsHandler;
-    else if (strcmp(qname.localName(), kSegnoTag) == 0)
-        return &_segnoHandler;
-    else if (strcmp(qname.localName(), kCodaTag) == 0)
-        return &_codaHandler;
-    else if (strcmp(qname.localName(), kOctaveShiftTag) == 0)
-        return &_octaveShiftHandler;
-    else if (strcmp(qname.localName(), kBracketTag) == 0)
-        return &_bracketHandler;
+    _subElementTag = elementTag(qname);
+    switch (_subElementTag) {
+        case Tag::Dynamics:
+            return &_dynamicsHandler;
+        case Tag::Wedge:
+            return &_wedgeHandler;
+        case Tag::Pedal:
+            return &_pedalHandler;
+        case Tag::Words:
+            return &_wordsHandler;
+        case Tag::Segno:
+            return &_segnoHandler;
+        case Tag::Coda:
+            return &_codaHandler;
+        case Tag::OctaveShift:
+            return &_octaveShiftHandler;
+        case Tag::Bracket:
+            return &_bracketHandler;
+        default:
+            break;
+    }
     return 0;
 }
 
 void DirectionTypeHandler::endSubElement(const QName& qname, RecursiveHandler* parser) {
-    if (strcmp(qname.localName(), kDynamicsTag) == 0)
-        _result = _dynamicsHandler.result();
-    else if (strcmp(qname.localName(), kWedgeTag) == 0)
-        _result = _wedgeHandler.result();
-    else if (strcmp(qname.localName(), kPedalTag) == 0)
-        _result = _pedalHandler.result();
-    else if (strcmp(qname.localName(), kWordsTag) == 0)
-        _result = _wordsHandler.result();
-    else if (strcmp(qname.localName(), kSegnoTag) == 0)
-        _result = _segnoHandler.result();
-    else if (strcmp(qname.localName(), kCodaTag) == 0)
-        _result = _codaHandler.result();
-    else if (strcmp(qname.localName(), kOctaveShiftTag) == 0)
-        _result = _octaveShiftHandler.result();
-    else if (strcmp(qname.localName(), kBracketTag) == 0)
-        _result = _bracketHandler.result();
+    switch (_subElementTag) {
+        case Tag::Dynamics:
+            _result = _dynamicsHandler.result();
+            break;
+        case Tag::Wedge:
+            _result = _wedgeHandler.result();
+            break;
+        case Tag::Pedal:
+            _result = _pedalHandler.result();
+            break;
+        case Tag::Words:
+            _result = _wordsHandler.result();
+            break;
+        case Tag::Segno:
+            _result = _segnoHandler.result();
+            break;
+        case Tag::Coda:
+            _result = _codaHandler.result();
+            break;
+        case Tag::OctaveShift:
+            _result = _octaveShiftHandler.result();
+            break;
+        case Tag::Bracket:
+            _result = _bracketHandler.result();
+            break;
+        default:
+            break;
+    }
 }
 
 } // namespace mxml
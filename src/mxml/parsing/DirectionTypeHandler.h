@@ -19,6 +19,7 @@
 #include <memory>
 
 #include "OctaveShiftHandler.h"
+#include "Tags.h"
 
 
 namespace mxml {
@@ -89,6 +90,7 @@ private:
     CodaHandler _codaHandler;
     OctaveShiftHandler _octaveShiftHandler;
     BracketHandler _bracketHandler;
+    parsing::Tag _subElementTag;
 };
 
 } // namespace mxml
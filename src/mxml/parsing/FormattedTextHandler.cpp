@@ -53,7 +53,7 @@ dom::FormattedText FormattedTextHandler::buildFromGenericNode(const parsing::Gen
     result.horizontalAlignment = HAlignFactory::buildFromGenericNode(node);
     result.verticalAlignment = VAlignFactory::buildFromGenericNode(node);
 
-    dom::Optional<std::string> string;
+    const char* string;
 
     string = node.attribute(kUnderlineAttribute);
     if (string)
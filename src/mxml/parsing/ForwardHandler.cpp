@@ -5,26 +5,28 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "ForwardHandler.h"
+#include "Tags.h"
 
 namespace mxml {
 
+using namespace parsing;
+
 using dom::Forward;
 using lxml::QName;
 
-static const char* kDurationTag = "duration";
-
 void ForwardHandler::startElement(const QName& qname, const AttributeMap& attributes) {
     _result.reset(new Forward());
 }
 
 lxml::RecursiveHandler* ForwardHandler::startSubElement(const QName& qname) {
-    if (strcmp(qname.localName(), kDurationTag) == 0)
+    _subElementTag = elementTag(qname);
+    if (_subElementTag == Tag::Duration)
         return &_integerHandler;
     return 0;
 }
 
 void ForwardHandler::endSubElement(const QName& qname, RecursiveHandler* parser) {
-    if (strcmp(qname.localName(), kDurationTag) == 0)
+    if (_subElementTag == Tag::Duration)
         _result->setDuration(_integerHandler.result());
 }
 
@@ -6,6 +6,7 @@
 
 #pragma once
 #include <lxml/BaseRecursiveHandler.h>
+#include "Tags.h"
 #include <lxml/IntegerHandler.h>
 
 #include <mxml/dom/Forward.h>
@@ -21,6 +22,7 @@ public:
     
 private:
     lxml::IntegerHandler _integerHandler;
+    parsing::Tag _subElementTag;
 };
 
 } // namespace mxml
@@ -6,27 +6,127 @@
 
 #include "GenericNode.h"
 
+#include <cstring>
+
 namespace mxml {
 namespace parsing {
 
-dom::Optional<std::string> GenericNode::attribute(const std::string& string) const {
-    auto it = _attributes.find(string);
-    if (it != _attributes.end())
-        return it->second;
-    return dom::Optional<std::string>();
+const std::string& GenericNode::name() const {
+    return _tree->_names[_name];
+}
+
+bool GenericNode::hasAttribute(const char* name) const {
+    return attribute(name) != nullptr;
+}
+
+const char* GenericNode::attribute(const char* name) const {
+    const auto id = _tree->find(name);
+    if (id < 0)
+        return nullptr;
+
+    for (std::uint32_t i = _attributesBegin; i < _attributesBegin + _attributeCount; i += 1) {
+        auto& attribute = _tree->_attributes[i];
+        if (static_cast<int>(attribute.name) == id)
+            return _tree->characters(attribute.offset);
+    }
+    return nullptr;
 }
 
-void GenericNode::setAttribute(const std::string& name, const std::string& value) {
-    _attributes[name] = value;
+const char* GenericNode::text() const {
+    return _tree->characters(_textOffset);
 }
 
-const GenericNode* GenericNode::child(const std::string& name) const {
-    for (auto& child : _children) {
-        if (child->name() == name)
-            return child.get();
+const GenericNode* GenericNode::child(const char* name) const {
+    const auto id = _tree->find(name);
+    if (id < 0)
+        return nullptr;
+
+    for (auto child = firstChild(); child; child = child->nextSibling()) {
+        if (static_cast<int>(child->_name) == id)
+            return child;
     }
     return nullptr;
 }
 
+const GenericNode* GenericNode::firstChild() const {
+    if (_index + 1 >= _end)
+        return nullptr;
+    return &_tree->_nodes[_index + 1];
+}
+
+const GenericNode* GenericNode::nextSibling() const {
+    if (_index == 0)
+        return nullptr;
+    auto& parent = _tree->_nodes[_parent];
+    if (_end >= parent._end)
+        return nullptr;
+    return &_tree->_nodes[_end];
+}
+
+std::size_t GenericNode::childCount() const {
+    std::size_t count = 0;
+    for (auto child = firstChild(); child; child = child->nextSibling())
+        count += 1;
+    return count;
+}
+
+void GenericTree::startNode(const char* name) {
+    GenericNode node;
+    node._tree = this;
+    node._index = static_cast<std::uint32_t>(_nodes.size());
+    node._parent = _open.empty() ? 0 : _open.back();
+    node._end = node._index + 1;
+    node._name = intern(name);
+    node._attributeCount = 0;
+    node._attributesBegin = static_cast<std::uint32_t>(_attributes.size());
+    node._textOffset = 0;
+    _nodes.push_back(node);
+    _open.push_back(node._index);
+}
+
+void GenericTree::addAttribute(const char* name, const std::string& value) {
+    auto& node = _nodes[_open.back()];
+    Attribute attribute;
+    attribute.name = intern(name);
+    attribute.offset = append(value);
+    _attributes.push_back(attribute);
+    node._attributeCount += 1;
+}
+
+void GenericTree::endNode(const std::string& text) {
+    auto& node = _nodes[_open.back()];
+    node._end = static_cast<std::uint32_t>(_nodes.size());
+    node._textOffset = append(text);
+    _open.pop_back();
+}
+
+std::uint16_t GenericTree::intern(const char* name) {
+    for (std::size_t i = 0; i < _names.size(); i += 1) {
+        if (std::strcmp(_names[i].c_str(), name) == 0)
+            return static_cast<std::uint16_t>(i);
+    }
+    _names.emplace_back(name);
+    return static_cast<std::uint16_t>(_names.size() - 1);
+}
+
+int GenericTree::find(const char* name) const {
+    for (std::size_t i = 0; i < _names.size(); i += 1) {
+        if (std::strcmp(_names[i].c_str(), name) == 0)
+            return static_cast<int>(i);
+    }
+    return -1;
+}
+
+std::uint32_t GenericTree::append(const std::string& string) {
+    const auto offset = static_cast<std::uint32_t>(_characters.size());
+    _characters.append(string);
+    _characters.push_back('\0');
+    return offset;
+}
+
+const char* GenericTree::characters(std::uint32_t offset) const {
+    return _characters.data() + offset;
+}
+
 } // namespace parsing
 } // namespace mxml
@@ -5,56 +5,116 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #pragma once
-#include <map>
-#include <memory>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 
-#include <mxml/dom/Optional.h>
-
 
 namespace mxml {
 namespace parsing {
 
+class GenericTree;
+
+/**
+ A node of a GenericTree. Nodes are stored by value in their tree and only refer to it, they are valid as long as the
+ tree is.
+ */
 class GenericNode {
 public:
-    GenericNode() = default;
-    explicit GenericNode(const std::string& name) : _name(name) {}
+    const std::string& name() const;
 
-    const std::string& name() const { return _name; }
-    void setName(const std::string& name) { _name = name; }
+    bool hasAttribute(const char* name) const;
 
-    bool hasAttribute(const std::string& string) const;
-    dom::Optional<std::string> attribute(const std::string& string) const;
-    void setAttribute(const std::string& name, const std::string& value);
+    /**
+     Return the value of an attribute, or nullptr if the node doesn't have it. The value points into the tree.
+     */
+    const char* attribute(const char* name) const;
 
-    const std::string& text() const { return _text; }
-    std::string& text() { return _text; }
-    void setText(const std::string& string) { _text = string; }
+    /**
+     Return the trimmed text of the node. The text points into the tree.
+     */
+    const char* text() const;
 
-    const GenericNode* parent() const { return _parent; }
-    void setParent(const GenericNode* parent) { _parent = parent; }
+    /**
+     Return the first child with the given name, or nullptr if the child is not found.
+     */
+    const GenericNode* child(const char* name) const;
 
-    const std::vector<std::unique_ptr<GenericNode>>& children() const { return _children; }
-    const std::unique_ptr<GenericNode>& child(std::size_t i) const { return _children[i]; }
-    std::vector<std::unique_ptr<GenericNode>>& children() { return _children; }
-    std::unique_ptr<GenericNode>& child(std::size_t i) { return _children[i]; }
-    void addChild(std::unique_ptr<GenericNode> child) { _children.push_back(std::move(child)); }
+    /**
+     Return the first child, or nullptr if the node has no children.
+     */
+    const GenericNode* firstChild() const;
 
     /**
-     Return the first child with the given name, or nullptr if the child is not found.
+     Return the next node with the same parent, or nullptr if this is the last child.
      */
-    const GenericNode* child(const std::string& name) const;
+    const GenericNode* nextSibling() const;
+
+    std::size_t childCount() const;
 
 private:
-    std::string _name;
+    friend class GenericTree;
+
+    const GenericTree* _tree;
+    std::uint32_t _index;
+    std::uint32_t _parent;
+    std::uint32_t _end;
+    std::uint16_t _name;
+    std::uint16_t _attributeCount;
+    std::uint32_t _attributesBegin;
+    std::uint32_t _textOffset;
+};
 
-    std::map<std::string, std::string> _attributes;
-    std::string _text;
+/**
+ A subtree of elements the parser keeps without interpreting them. All nodes live in a single vector in document order,
+ the descendants of a node are the range up to its end index. Element and attribute names are interned per tree and
+ attribute values and text are null terminated strings in one shared character buffer.
+ */
+class GenericTree {
+public:
+    GenericTree() = default;
+    GenericTree(const GenericTree&) = delete;
+    GenericTree& operator=(const GenericTree&) = delete;
 
-    const GenericNode* _parent;
-    std::vector<std::unique_ptr<GenericNode>> _children;
+    const GenericNode& root() const { return _nodes.front(); }
+    bool empty() const { return _nodes.empty(); }
+    std::size_t size() const { return _nodes.size(); }
+
+    /**
+     Open a node as the last child of the innermost open node.
+     */
+    void startNode(const char* name);
+
+    /**
+     Add an attribute to the innermost open node, before any child is started.
+     */
+    void addAttribute(const char* name, const std::string& value);
+
+    /**
+     Close the innermost open node.
+     */
+    void endNode(const std::string& text);
+
+private:
+    struct Attribute {
+        std::uint16_t name;
+        std::uint32_t offset;
+    };
+
+    std::uint16_t intern(const char* name);
+    int find(const char* name) const;
+    std::uint32_t append(const std::string& string);
+    const char* characters(std::uint32_t offset) const;
+
+private:
+    friend class GenericNode;
 
+    std::vector<GenericNode> _nodes;
+    std::vector<Attribute> _attributes;
+    std::vector<std::string> _names;
+    std::string _characters;
+    std::vector<std::uint32_t> _open;
 };
 
 } // namespace parsing
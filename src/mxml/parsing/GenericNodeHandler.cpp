@@ -13,24 +13,27 @@ namespace mxml {
 namespace parsing {
 
 void GenericNodeHandler::startElement(const lxml::QName& qname, const AttributeMap& attributes) {
-    _result.reset(new GenericNode{qname.localName()});
-    for (auto pair : attributes) {
-        _result->setAttribute(pair.first.localName(), pair.second);
+    // Any other element is a new top level element, even if a previous parse stopped in the middle of a subtree
+    if (!_subElement)
+        _result.reset(new GenericTree{});
+    _subElement = false;
+
+    _result->startNode(qname.localName());
+    for (auto& pair : attributes) {
+        _result->addAttribute(pair.first.localName(), pair.second);
     }
 }
 
 void GenericNodeHandler::endElement(const lxml::QName& qname, const std::string& contents) {
-    _result->setText(lxml::StringHandler::trim(contents));
+    _result->endNode(lxml::StringHandler::trim(contents));
 }
 
 lxml::RecursiveHandler* GenericNodeHandler::startSubElement(const lxml::QName& qname) {
-    if (!_subHandler)
-        _subHandler.reset(new GenericNodeHandler{});
-    return _subHandler.get();
+    _subElement = true;
+    return this;
 }
 
 void GenericNodeHandler::endSubElement(const lxml::QName& qname, RecursiveHandler* parser) {
-    _result->addChild(_subHandler->result());
 }
 
 } // namespace parsing
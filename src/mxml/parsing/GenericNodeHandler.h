@@ -14,15 +14,22 @@
 namespace mxml {
 namespace parsing {
 
-class GenericNodeHandler : public lxml::BaseRecursiveHandler<std::unique_ptr<GenericNode>> {
+/**
+ Collects an element and everything under it into a GenericTree. The same handler is used for every level of the
+ subtree, a new tree is started for each top level element.
+ */
+class GenericNodeHandler : public lxml::BaseRecursiveHandler<std::unique_ptr<GenericTree>> {
 public:
+    GenericNodeHandler() : _subElement() {}
+
     void startElement(const lxml::QName& qname, const AttributeMap& attributes);
     void endElement(const lxml::QName& qname, const std::string& contents);
     RecursiveHandler* startSubElement(const lxml::QName& qname);
     void endSubElement(const lxml::QName& qname, lxml::RecursiveHandler* parser);
     
 private:
-    std::unique_ptr<GenericNodeHandler> _subHandler;
+    // Set while the parser starts one of the elements below the top level one, which all come through startSubElement
+    bool _subElement;
 };
 
 } // namespace parsing
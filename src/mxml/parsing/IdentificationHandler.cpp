@@ -5,16 +5,16 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "IdentificationHandler.h"
+#include "Tags.h"
 
 namespace mxml {
 
+using namespace parsing;
+
 using dom::TypedValue;
 using lxml::QName;
 
 static const char* kTypeAttribute = "type";
-static const char* kCreatorTag = "creator";
-static const char* kRightsTag = "rights";
-static const char* kSourceTag = "source";
 
 void TypedValueHandler::startElement(const QName& qname, const AttributeMap& attributes) {
     _result.reset(new TypedValue());
@@ -33,24 +33,35 @@ void TypedValueHandler::endElement(const QName& qname, const std::string& conten
 }
 
 lxml::RecursiveHandler* IdentificationHandler::startSubElement(const QName& qname) {
+    _subElementTag = elementTag(qname);
     _result.reset(new dom::Identification());
     
-    if (strcmp(qname.localName(), kCreatorTag) == 0)
-        return &_typedValueHandler;
-    else if (strcmp(qname.localName(), kRightsTag) == 0)
-        return &_typedValueHandler;
-    else if (strcmp(qname.localName(), kSourceTag) == 0)
-        return &_stringHandler;
+    switch (_subElementTag) {
+        case Tag::Creator:
+        case Tag::Rights:
+            return &_typedValueHandler;
+        case Tag::Source:
+            return &_stringHandler;
+        default:
+            break;
+    }
     return 0;
 }
 
 void IdentificationHandler::endSubElement(const QName& qname, RecursiveHandler* parser) {
-    if (strcmp(qname.localName(), kCreatorTag) == 0)
-        _result->addCreator(_typedValueHandler.result());
-    else if (strcmp(qname.localName(), kRightsTag) == 0)
-        _result->addRights(_typedValueHandler.result());
-    else if (strcmp(qname.localName(), kSourceTag) == 0)
-        _result->setSource(_stringHandler.result());
+    switch (_subElementTag) {
+        case Tag::Creator:
+            _result->addCreator(_typedValueHandler.result());
+            break;
+        case Tag::Rights:
+            _result->addRights(_typedValueHandler.result());
+            break;
+        case Tag::Source:
+            _result->setSource(_stringHandler.result());
+            break;
+        default:
+            break;
+    }
 }
 
 } // namespace mxml
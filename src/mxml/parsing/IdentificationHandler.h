@@ -6,6 +6,7 @@
 
 #pragma once
 #include <lxml/BaseRecursiveHandler.h>
+#include "Tags.h"
 #include <lxml/StringHandler.h>
 #include <mxml/dom/Identification.h>
 
@@ -25,6 +26,7 @@ public:
 private:
     TypedValueHandler _typedValueHandler;
     lxml::StringHandler _stringHandler;
+    parsing::Tag _subElementTag;
 };
 
 } // namespace mxml
@@ -5,18 +5,18 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "KeyHandler.h"
+#include "Tags.h"
 #include <mxml/dom/InvalidDataError.h>
 
 namespace mxml {
 
+using namespace parsing;
+
 using lxml::QName;
 using dom::Key;
 
 static const char* kNumberAttribute = "number";
 static const char* kPrintObjectAttribute = "print-object";
-static const char* kCancelTag = "cancel";
-static const char* kFifthsTag = "fifths";
-static const char* kModeTag = "mode";
 
 void KeyHandler::startElement(const QName& qname, const AttributeMap& attributes) {
     _result.reset(new Key());
@@ -31,22 +31,33 @@ void KeyHandler::startElement(const QName& qname, const AttributeMap& attributes
 }
 
 lxml::RecursiveHandler* KeyHandler::startSubElement(const QName& qname) {
-    if (strcmp(qname.localName(), kCancelTag) == 0)
-        return &_integerHandler;
-    else if (strcmp(qname.localName(), kFifthsTag) == 0)
-        return &_integerHandler;
-    else if (strcmp(qname.localName(), kModeTag) == 0)
-        return &_stringHandler;
+    _subElementTag = elementTag(qname);
+    switch (_subElementTag) {
+        case Tag::Cancel:
+        case Tag::Fifths:
+            return &_integerHandler;
+        case Tag::Mode:
+            return &_stringHandler;
+        default:
+            break;
+    }
     return 0;
 }
 
 void KeyHandler::endSubElement(const QName& qname, RecursiveHandler* parser) {
-    if (strcmp(qname.localName(), kCancelTag) == 0)
-        _result->setCancel(_integerHandler.result());
-    else if (strcmp(qname.localName(), kFifthsTag) == 0)
-        _result->setFifths(_integerHandler.result());
-    else if (strcmp(qname.localName(), kModeTag) == 0)
-        _result->setMode(modeFromString(_stringHandler.result()));
+    switch (_subElementTag) {
+        case Tag::Cancel:
+            _result->setCancel(_integerHandler.result());
+            break;
+        case Tag::Fifths:
+            _result->setFifths(_integerHandler.result());
+            break;
+        case Tag::Mode:
+            _result->setMode(modeFromString(_stringHandler.result()));
+            break;
+        default:
+            break;
+    }
 }
 
 Key::Mode KeyHandler::modeFromString(const std::string& string) {
@@ -6,6 +6,7 @@
 
 #pragma once
 #include <lxml/BaseRecursiveHandler.h>
+#include "Tags.h"
 #include <lxml/IntegerHandler.h>
 #include <lxml/StringHandler.h>
 
@@ -24,6 +25,7 @@ public:
 private:
     lxml::IntegerHandler _integerHandler;
     lxml::StringHandler _stringHandler;
+    parsing::Tag _subElementTag;
 };
 
 } // namespace mxml
@@ -5,19 +5,19 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "LyricHandler.h"
+#include "Tags.h"
 #include <lxml/IntegerHandler.h>
 #include <mxml/dom/InvalidDataError.h>
 
 namespace mxml {
 
+using namespace parsing;
+
 static const char* kNumberAttribute = "number";
 static const char* kNameAttribute = "name";
 static const char* kPrintObjectAttribute = "name";
 
-//static const char* kExtendTag = "extend";
-static const char* kSyllabicTag = "syllabic";
-static const char* kTextTag = "text";
-
+//
 using dom::Lyric;
 
 void LyricHandler::startElement(const lxml::QName& qname, const AttributeMap& attributes) {
@@ -37,18 +37,29 @@ void LyricHandler::startElement(const lxml::QName& qname, const AttributeMap& at
 }
 
 lxml::RecursiveHandler* LyricHandler::startSubElement(const lxml::QName& qname) {
-    if (strcmp(qname.localName(), kSyllabicTag) == 0)
-        return &_syllabicHandler;
-    else if (strcmp(qname.localName(), kTextTag) == 0)
-        return &_stringHandler;
+    _subElementTag = elementTag(qname);
+    switch (_subElementTag) {
+        case Tag::Syllabic:
+            return &_syllabicHandler;
+        case Tag::Text:
+            return &_stringHandler;
+        default:
+            break;
+    }
     return 0;
 }
 
 void LyricHandler::endSubElement(const lxml::QName& qname, RecursiveHandler* parser) {
-    if (strcmp(qname.localName(), kSyllabicTag) == 0)
-        _result->setSyllabic(_syllabicHandler.result());
-    else if (strcmp(qname.localName(), kTextTag) == 0)
-        _result->setText(_stringHandler.result());
+    switch (_subElementTag) {
+        case Tag::Syllabic:
+            _result->setSyllabic(_syllabicHandler.result());
+            break;
+        case Tag::Text:
+            _result->setText(_stringHandler.result());
+            break;
+        default:
+            break;
+    }
 }
 
 } // namespace
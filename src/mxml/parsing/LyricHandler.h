@@ -8,6 +8,7 @@
 #include <lxml/BaseRecursiveHandler.h>
 #include <lxml/StringHandler.h>
 #include "SyllabicHandler.h"
+#include "Tags.h"
 
 #include <mxml/dom/Lyric.h>
 
@@ -22,6 +23,7 @@ public:
 private:
     lxml::StringHandler _stringHandler;
     SyllabicHandler _syllabicHandler;
+    parsing::Tag _subElementTag;
 };
 
 } // namespace
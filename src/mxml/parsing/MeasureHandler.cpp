@@ -5,8 +5,8 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "MeasureHandler.h"
+#include "Tags.h"
 #include <mxml/dom/Chord.h>
-#include <cstring>
 
 namespace mxml {
 namespace parsing {
@@ -14,14 +14,6 @@ namespace parsing {
 using dom::Measure;
 using lxml::QName;
 
-static const char* kNoteTag = "note";
-static const char* kBackupTag = "backup";
-static const char* kForwardTag = "forward";
-static const char* kAttributesTag = "attributes";
-static const char* kDirectionTag = "direction";
-static const char* kPrintTag = "print";
-static const char* kBarlineTag = "barline";
-
 static const char* kNumberAttribute = "number";
 
 void MeasureHandler::startElement(const QName& qname, const AttributeMap& attributes) {
@@ -49,47 +41,66 @@ void MeasureHandler::endElement(const QName& qname, const std::string& contents)
 }
 
 lxml::RecursiveHandler* MeasureHandler::startSubElement(const QName& qname) {
-    if (strcmp(qname.localName(), kNoteTag) == 0)
-        return &_noteHandler;
-    else if (strcmp(qname.localName(), kBackupTag) == 0)
-        return &_backupHandler;
-    else if (strcmp(qname.localName(), kForwardTag) == 0)
-        return &_forwardHandler;
-    else if (strcmp(qname.localName(), kAttributesTag) == 0)
-        return &_attributesHandler;
-    else if (strcmp(qname.localName(), kDirectionTag) == 0)
-        return &_directionHandler;
-    else if (strcmp(qname.localName(), kPrintTag) == 0)
-        return &_printHandler;
-    else if (strcmp(qname.localName(), kBarlineTag) == 0)
-        return &_barlineHandler;
+    _subElementTag = elementTag(qname);
+    switch (_subElementTag) {
+        case Tag::Note:
+            return &_noteHandler;
+        case Tag::Backup:
+            return &_backupHandler;
+        case Tag::Forward:
+            return &_forwardHandler;
+        case Tag::Attributes:
+            return &_attributesHandler;
+        case Tag::Direction:
+            return &_directionHandler;
+        case Tag::Print:
+            return _profile != Profile::Playback ? &_printHandler : 0;
+        case Tag::Barline:
+            return &_barlineHandler;
+        default:
+            break;
+    }
     return 0;
 }
 
 void MeasureHandler::endSubElement(const QName& qname, RecursiveHandler* parser) {
-    if (strcmp(qname.localName(), kNoteTag) == 0) {
-        handleNote(_noteHandler.result());
-    } else if(strcmp(qname.localName(), kForwardTag) == 0) {
-        std::unique_ptr<dom::Forward> forward = _forwardHandler.result();
-        _time += forward->duration();
-        _result->addNode(std::move(forward));
-    } else if(strcmp(qname.localName(), kBackupTag) == 0) {
-        std::unique_ptr<dom::Backup> backup = _backupHandler.result();
-        _time -= backup->duration();
-        _result->addNode(std::move(backup));
-    } else if (strcmp(qname.localName(), kAttributesTag) == 0) {
-        auto attributes = _attributesHandler.result();
-        attributes->setStart(_time);
-        attributes->setParent(_result.get());
-        _result->addNode(std::move(attributes));
-    } else if (strcmp(qname.localName(), kDirectionTag) == 0) {
-        std::unique_ptr<dom::Direction> direction = _directionHandler.result();
-        direction->setStart(_time);
-        _result->addNode(std::move(direction));
-    } else if (strcmp(qname.localName(), kPrintTag) == 0) {
-        _result->addNode(_printHandler.result());
-    } else if (strcmp(qname.localName(), kBarlineTag) == 0) {
-        _result->addNode(_barlineHandler.result());
+    switch (_subElementTag) {
+        case Tag::Note:
+            handleNote(_noteHandler.result());
+            break;
+        case Tag::Forward: {
+            std::unique_ptr<dom::Forward> forward = _forwardHandler.result();
+            _time += forward->duration();
+            _result->addNode(std::move(forward));
+            break;
+        }
+        case Tag::Backup: {
+            std::unique_ptr<dom::Backup> backup = _backupHandler.result();
+            _time -= backup->duration();
+            _result->addNode(std::move(backup));
+            break;
+        }
+        case Tag::Attributes: {
+            auto attributes = _attributesHandler.result();
+            attributes->setStart(_time);
+            attributes->setParent(_result.get());
+            _result->addNode(std::move(attributes));
+            break;
+        }
+        case Tag::Direction: {
+            std::unique_ptr<dom::Direction> direction = _directionHandler.result();
+            direction->setStart(_time);
+            _result->addNode(std::move(direction));
+            break;
+        }
+        case Tag::Print:
+            _result->addNode(_printHandler.result());
+            break;
+        case Tag::Barline:
+            _result->addNode(_barlineHandler.result());
+            break;
+        default:
+            break;
     }
 }
 
@@ -13,6 +13,8 @@
 #include "ForwardHandler.h"
 #include "NoteHandler.h"
 #include "PrintHandler.h"
+#include "Profile.h"
+#include "Tags.h"
 
 #include <mxml/dom/Chord.h>
 #include <mxml/dom/Measure.h>
@@ -23,7 +25,12 @@ namespace parsing {
 
 class MeasureHandler : public lxml::BaseRecursiveHandler<std::unique_ptr<dom::Measure>> {
 public:
-    MeasureHandler() : _lastTime(), _time() {}
+    MeasureHandler() : _lastTime(), _time(), _profile(Profile::Full) {}
+
+    void setProfile(Profile profile) {
+        _profile = profile;
+        _noteHandler.setProfile(profile);
+    }
     
     RecursiveHandler* startSubElement(const lxml::QName& qname);
     void endElement(const lxml::QName& qname, const std::string& contents);
@@ -50,6 +57,8 @@ private:
     int _lastTime;
     int _time;
     bool _empty;
+    Profile _profile;
+    Tag _subElementTag;
 };
 
 } // namespace parsing
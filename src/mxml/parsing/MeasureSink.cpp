@@ -0,0 +1,77 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "MeasureSink.h"
+
+
+namespace mxml {
+namespace parsing {
+
+MeasureAttributes::MeasureAttributes() : divisions(1), staves(1), time(), clefs(), keys() {
+}
+
+void MeasureAttributes::reset() {
+    divisions = 1;
+    staves = 1;
+    time = nullptr;
+    clefs.clear();
+    keys.clear();
+}
+
+void MeasureAttributes::apply(const dom::Attributes& attributes) {
+    if (attributes.divisions().isPresent())
+        divisions = attributes.divisions().value();
+    if (attributes.staves().isPresent())
+        staves = attributes.staves().value();
+    if (attributes.time())
+        time = attributes.time();
+
+    clefs.resize(staves);
+    keys.resize(staves);
+    for (int staff = 1; staff <= staves; staff += 1) {
+        if (auto clef = attributes.clef(staff))
+            clefs[staff - 1] = clef;
+        if (auto key = attributes.key(staff))
+            keys[staff - 1] = key;
+    }
+}
+
+const dom::Clef* MeasureAttributes::clef(int staff) const {
+    if (staff > 0 && static_cast<std::size_t>(staff) <= clefs.size())
+        return clefs[staff - 1];
+    return nullptr;
+}
+
+const dom::Key* MeasureAttributes::key(int staff) const {
+    if (staff > 0 && static_cast<std::size_t>(staff) <= keys.size())
+        return keys[staff - 1];
+    return nullptr;
+}
+
+void streamMeasure(const MeasureSink& sink, std::size_t partIndex, const dom::Measure& measure, MeasureAttributes& attributes) {
+    using dom::Node;
+
+    // Attributes before the first note apply to the whole measure
+    const auto& nodes = measure.nodes();
+    auto it = nodes.begin();
+    for (; it != nodes.end(); ++it) {
+        const auto kind = (*it)->kind();
+        if (kind == Node::Kind::Note || kind == Node::Kind::Chord || kind == Node::Kind::Forward || kind == Node::Kind::Backup)
+            break;
+        if (kind == Node::Kind::Attributes)
+            attributes.apply(static_cast<const dom::Attributes&>(**it));
+    }
+
+    sink(partIndex, measure, attributes);
+
+    for (; it != nodes.end(); ++it) {
+        if ((*it)->kind() == Node::Kind::Attributes)
+            attributes.apply(static_cast<const dom::Attributes&>(**it));
+    }
+}
+
+} // namespace parsing
+} // namespace mxml
@@ -0,0 +1,55 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+#include <mxml/dom/Attributes.h>
+#include <mxml/dom/Measure.h>
+
+#include <functional>
+#include <vector>
+
+
+namespace mxml {
+namespace parsing {
+
+/**
+ The attributes in effect in a part while it is being parsed. MusicXML attributes elements only contain what changes,
+ this accumulates them. The pointers refer to nodes of the score being parsed.
+ */
+struct MeasureAttributes {
+    MeasureAttributes();
+
+    void reset();
+
+    /**
+     Apply the values present in an attributes node.
+     */
+    void apply(const dom::Attributes& attributes);
+
+    const dom::Clef* clef(int staff) const;
+    const dom::Key* key(int staff) const;
+
+    int divisions;
+    int staves;
+    const dom::Time* time;
+    std::vector<const dom::Clef*> clefs;
+    std::vector<const dom::Key*> keys;
+};
+
+/**
+ Callback for measures parsed in streaming mode. It is called as soon as a measure is complete, before the rest of the
+ document is read, with the index of its part and the attributes in effect at the start of the measure. Attributes
+ elements before the first note of the measure are already applied, later ones are nodes of the measure.
+ */
+typedef std::function<void (std::size_t partIndex, const dom::Measure& measure, const MeasureAttributes& attributes)> MeasureSink;
+
+/**
+ Report a measure to a sink and advance the attributes of its part past the measure.
+ */
+void streamMeasure(const MeasureSink& sink, std::size_t partIndex, const dom::Measure& measure, MeasureAttributes& attributes);
+
+} // namespace parsing
+} // namespace mxml
@@ -5,6 +5,7 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "NotationsHandler.h"
+#include "Tags.h"
 #include "TypeFactories.h"
 
 
@@ -15,14 +16,8 @@ using dom::Notations;
 using lxml::QName;
 
 static const char* kPrintObjectAttribute = "print-object";
-static const char* kArticulationsTag = "articulations";
-static const char* kFermataTag = "fermata";
-static const char* kSlurTag = "slur";
-static const char* kOrnamentsTag = "ornaments";
-static const char* kTiedTag = "tied";
-static const char* kTupletTag = "tuplet";
 
-NotationsHandler::NotationsHandler() : _articulationHandler(), _articulationsHandler(_articulationHandler) {}
+NotationsHandler::NotationsHandler() : _articulationHandler(), _articulationsHandler(_articulationHandler), _profile(Profile::Full) {}
 
 void NotationsHandler::startElement(const QName& qname, const AttributeMap& attributes) {
     _result.reset(new Notations());
@@ -33,43 +28,66 @@ void NotationsHandler::startElement(const QName& qname, const AttributeMap& attr
 }
 
 lxml::RecursiveHandler* NotationsHandler::startSubElement(const QName& qname) {
-    if (strcmp(qname.localName(), kArticulationsTag) == 0)
-        return &_articulationsHandler;
-    else if (strcmp(qname.localName(), kFermataTag) == 0)
-        return &_fermataHandler;
-    else if (strcmp(qname.localName(), kOrnamentsTag) == 0)
-        return &_ornamentsHandler;
-    else if (strcmp(qname.localName(), kSlurTag) == 0)
-        return &_slurHandler;
-    else if (strcmp(qname.localName(), kTiedTag) == 0)
-        return &_tiedHandler;
-    else if (strcmp(qname.localName(), kTupletTag) == 0)
-        return &_tupletHandler;
+    _subElementTag = elementTag(qname);
+
+    // Ties are the only notations that change how the notes sound
+    if (_profile == Profile::Playback && _subElementTag != Tag::Tied)
+        return 0;
+
+    switch (_subElementTag) {
+        case Tag::Articulations:
+            return &_articulationsHandler;
+        case Tag::Fermata:
+            return &_fermataHandler;
+        case Tag::Ornaments:
+            return &_ornamentsHandler;
+        case Tag::Slur:
+            return &_slurHandler;
+        case Tag::Tied:
+            return &_tiedHandler;
+        case Tag::Tuplet:
+            return &_tupletHandler;
+        default:
+            break;
+    }
     return 0;
 }
 
 void NotationsHandler::endSubElement(const QName& qname, RecursiveHandler* parser) {
-    if (strcmp(qname.localName(), kArticulationsTag) == 0) {
-        _result->articulations = _articulationsHandler.result();
-    } else if (strcmp(qname.localName(), kFermataTag) == 0) {
-        _result->fermata = _fermataHandler.result();
-        _result->fermata->setParent(_result.get());
-    } else if (strcmp(qname.localName(), kOrnamentsTag) == 0) {
-        auto ornament = _ornamentsHandler.result();
-        ornament->setParent(_result.get());
-        _result->ornaments.push_back(std::move(ornament));
-    } else if (strcmp(qname.localName(), kSlurTag) == 0) {
-        auto slur = _slurHandler.result();
-        slur->setParent(_result.get());
-        _result->slurs.push_back(std::move(slur));
-    } else if (strcmp(qname.localName(), kTiedTag) == 0) {
-        auto tie = _tiedHandler.result();
-        tie->setParent(_result.get());
-        _result->ties.push_back(std::move(tie));
-    } else if (strcmp(qname.localName(), kTupletTag) == 0) {
-        auto tuplet = _tupletHandler.result();
-        tuplet->setParent(_result.get());
-        _result->tuplets.push_back(std::move(tuplet));
+    switch (_subElementTag) {
+        case Tag::Articulations:
+            _result->articulations = _articulationsHandler.result();
+            break;
+        case Tag::Fermata:
+            _result->fermata = _fermataHandler.result();
+            _result->fermata->setParent(_result.get());
+            break;
+        case Tag::Ornaments: {
+            auto ornament = _ornamentsHandler.result();
+            ornament->setParent(_result.get());
+            _result->ornaments.push_back(std::move(ornament));
+            break;
+        }
+        case Tag::Slur: {
+            auto slur = _slurHandler.result();
+            slur->setParent(_result.get());
+            _result->slurs.push_back(std::move(slur));
+            break;
+        }
+        case Tag::Tied: {
+            auto tie = _tiedHandler.result();
+            tie->setParent(_result.get());
+            _result->ties.push_back(std::move(tie));
+            break;
+        }
+        case Tag::Tuplet: {
+            auto tuplet = _tupletHandler.result();
+            tuplet->setParent(_result.get());
+            _result->tuplets.push_back(std::move(tuplet));
+            break;
+        }
+        default:
+            break;
     }
 }
 
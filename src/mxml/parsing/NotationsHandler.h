@@ -10,9 +10,11 @@
 #include <lxml/ListHandler.h>
 #include "FermataHandler.h"
 #include "OrnamentsHandler.h"
+#include "Profile.h"
 #include "SlurHandler.h"
 #include "TiedHandler.h"
 #include "TupletHandler.h"
+#include "Tags.h"
 
 #include <mxml/dom/Notations.h>
 
@@ -22,6 +24,10 @@ namespace parsing {
 class NotationsHandler : public lxml::BaseRecursiveHandler<std::unique_ptr<dom::Notations>> {
 public:
     NotationsHandler();
+
+    void setProfile(Profile profile) {
+        _profile = profile;
+    }
     
     void startElement(const lxml::QName& qname, const AttributeMap& attributes);
     RecursiveHandler* startSubElement(const lxml::QName& qname);
@@ -35,6 +41,8 @@ private:
     SlurHandler _slurHandler;
     TiedHandler _tiedHandler;
     TupletHandler _tupletHandler;
+    Profile _profile;
+    Tag _subElementTag;
 };
 
 } // namespace parsing
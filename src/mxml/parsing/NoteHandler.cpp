@@ -5,11 +5,12 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "NoteHandler.h"
+#include "Numbers.h"
+#include "Tags.h"
 #include "PositionFactory.h"
 #include "TypeFactories.h"
 
 #include <mxml/dom/InvalidDataError.h>
-#include <cstring>
 
 namespace mxml {
 namespace parsing {
@@ -22,49 +23,37 @@ static const char* kEndDynamicsAttribute = "end-dynamics";
 static const char* kAttackAttribute = "attack";
 static const char* kReleaseAttribute = "release";
 
-static const char* kAccidentalTag = "accidental";
-static const char* kBeamTag = "beam";
-static const char* kChordTag = "chord";
-static const char* kDotTag = "dot";
-static const char* kDurationTag = "duration";
-static const char* kGraceTag = "grace";
-static const char* kLyricTag = "lyric";
-static const char* kNotationsTag = "notations";
-static const char* kPitchTag = "pitch";
-static const char* kRestTag = "rest";
-static const char* kStaffTag = "staff";
-static const char* kStemTag = "stem";
-static const char* kTieTag = "tie";
-static const char* kTimeModificationTag = "time-modification";
-static const char* kTypeTag = "type";
-static const char* kUnpitchedTag = "unpitched";
-static const char* kVoiceTag = "voice";
+/**
+ Note contents that only affect how the note is drawn.
+ */
+static bool isLayoutOnly(Tag tag) {
+    return tag == Tag::Stem || tag == Tag::Dot || tag == Tag::Beam || tag == Tag::Lyric;
+}
 
 
 void NoteHandler::startElement(const QName& qname, const AttributeMap& attributes) {
     using dom::presentOptional;
-    using lxml::DoubleHandler;
-    using lxml::IntegerHandler;
 
     _result.reset(new Note());
-    _result->position = PositionFactory::buildFromAttributes(attributes);
+    if (_profile != Profile::Playback)
+        _result->position = PositionFactory::buildFromAttributes(attributes);
     _result->printObject = PrintObjectFactory::buildFromAttributes(attributes);
 
     auto dynamics = attributes.find(kDynamicsAttribute);
     if (dynamics != attributes.end())
-        _result->setDynamics(presentOptional((float)DoubleHandler::parseDouble(dynamics->second)));
+        _result->setDynamics(presentOptional((float)parseDouble(dynamics->second)));
 
     auto endDynamics = attributes.find(kEndDynamicsAttribute);
     if (endDynamics != attributes.end())
-        _result->setEndDynamics(presentOptional((float)DoubleHandler::parseDouble(endDynamics->second)));
+        _result->setEndDynamics(presentOptional((float)parseDouble(endDynamics->second)));
 
     auto attack = attributes.find(kAttackAttribute);
     if (attack != attributes.end())
-        _result->setAttack(IntegerHandler::parseInteger(attack->second));
+        _result->setAttack(parseInteger(attack->second));
 
     auto release = attributes.find(kReleaseAttribute);
     if (release != attributes.end())
-        _result->setRelease(IntegerHandler::parseInteger(release->second));
+        _result->setRelease(parseInteger(release->second));
 }
 
 void NoteHandler::endElement(const lxml::QName& qname, const std::string& contents) {
@@ -83,100 +72,133 @@ void NoteHandler::endElement(const lxml::QName& qname, const std::string& conten
 }
 
 lxml::RecursiveHandler* NoteHandler::startSubElement(const QName& qname) {
-    if (strcmp(qname.localName(), kDurationTag) == 0)
-        return &_integerHandler;
-    else if (strcmp(qname.localName(), kTypeTag) == 0)
-        return &_stringHandler;
-    else if (strcmp(qname.localName(), kChordTag) == 0)
-        return &_presenceHandler;
-    else if (strcmp(qname.localName(), kGraceTag) == 0)
-        return &_presenceHandler;
-    else if (strcmp(qname.localName(), kStemTag) == 0)
-        return &_stringHandler;
-    else if (strcmp(qname.localName(), kStaffTag) == 0)
-        return &_integerHandler;
-    else if (strcmp(qname.localName(), kVoiceTag) == 0)
-        return &_stringHandler;
-    else if (strcmp(qname.localName(), kPitchTag) == 0)
-        return &_pitchHandler;
-    else if (strcmp(qname.localName(), kRestTag) == 0)
-        return &_restHandler;
-    else if (strcmp(qname.localName(), kUnpitchedTag) == 0)
-        return &_unpitchedHandler;
-    else if (strcmp(qname.localName(), kAccidentalTag) == 0)
-        return &_stringHandler;
-    else if (strcmp(qname.localName(), kDotTag) == 0)
-        return &_emptyPlacementHandler;
-    else if (strcmp(qname.localName(), kTieTag) == 0)
-        return &_tieHandler;
-    else if (strcmp(qname.localName(), kNotationsTag) == 0)
-        return &_notationsHandler;
-    else if (strcmp(qname.localName(), kBeamTag) == 0)
-        return &_beamHandler;
-    else if (strcmp(qname.localName(), kLyricTag) == 0)
-        return &_lyricHandler;
-    else if (strcmp(qname.localName(), kTimeModificationTag) == 0)
-        return &_timeModificationHandler;
+    _subElementTag = elementTag(qname);
+    if (_profile == Profile::Playback && isLayoutOnly(_subElementTag))
+        return 0;
+
+    switch (_subElementTag) {
+        case Tag::Duration:
+        case Tag::Staff:
+            return &_integerHandler;
+        case Tag::Type:
+        case Tag::Stem:
+        case Tag::Voice:
+        case Tag::Accidental:
+            return &_stringHandler;
+        case Tag::Chord:
+        case Tag::Grace:
+            return &_presenceHandler;
+        case Tag::Pitch:
+            return &_pitchHandler;
+        case Tag::Rest:
+            return &_restHandler;
+        case Tag::Unpitched:
+            return &_unpitchedHandler;
+        case Tag::Dot:
+            return &_emptyPlacementHandler;
+        case Tag::Tie:
+            return &_tieHandler;
+        case Tag::Notations:
+            return &_notationsHandler;
+        case Tag::Beam:
+            return &_beamHandler;
+        case Tag::Lyric:
+            return &_lyricHandler;
+        case Tag::TimeModification:
+            return &_timeModificationHandler;
+        default:
+            break;
+    }
     return 0;
 }
 
 void NoteHandler::endSubElement(const QName& qname, RecursiveHandler* parser) {
     using dom::presentOptional;
 
-    if (strcmp(qname.localName(), kDurationTag) == 0)
-        _result->setDuration(presentOptional(_integerHandler.result()));
-    else if (strcmp(qname.localName(), kTypeTag) == 0)
-        _result->setType(presentOptional(typeFromString(_stringHandler.result())));
-    else if (strcmp(qname.localName(), kChordTag) == 0)
-        _result->setChord(_presenceHandler.result());
-    else if (strcmp(qname.localName(), kGraceTag) == 0)
-        _result->setGrace(_presenceHandler.result());
-    else if (strcmp(qname.localName(), kStemTag) == 0)
-        _result->setStem(presentOptional(stemFromString(_stringHandler.result())));
-    else if (strcmp(qname.localName(), kStaffTag) == 0)
-        _result->setStaff(_integerHandler.result());
-    else if (strcmp(qname.localName(), kVoiceTag) == 0)
-        _result->setVoice(_stringHandler.result());
-    else if (strcmp(qname.localName(), kPitchTag) == 0) {
-        auto pitch = _pitchHandler.result();
-        pitch->setParent(_result.get());
-        _result->pitch = std::move(pitch);
-    } else if (strcmp(qname.localName(), kRestTag) == 0) {
-        auto rest = _restHandler.result();
-        rest->setParent(_result.get());
-        _result->rest = std::move(rest);
-    } else if (strcmp(qname.localName(), kUnpitchedTag) == 0) {
-        auto unpitched = _unpitchedHandler.result();
-        unpitched->setParent(_result.get());
-        _result->unpitched = _unpitchedHandler.result();
-    } else if (strcmp(qname.localName(), kAccidentalTag) == 0) {
-        auto accidental = std::unique_ptr<dom::Accidental>(new dom::Accidental(accidentalTypeFromString(_stringHandler.result())));
-        accidental->setParent(_result.get());
-        _result->accidental = std::move(accidental);
-    } else if (strcmp(qname.localName(), kDotTag) == 0) {
-        auto dot = _emptyPlacementHandler.result();
-        dot->setParent(_result.get());
-        _result->dot = std::move(dot);
-    } else if (strcmp(qname.localName(), kTieTag) == 0) {
-        auto tie = _tieHandler.result();
-        tie->setParent(_result.get());
-        _result->tie = std::move(tie);
-    } else if (strcmp(qname.localName(), kNotationsTag) == 0) {
-        auto notations = _notationsHandler.result();
-        notations->setParent(_result.get());
-        _result->notations = std::move(notations);
-    } else if (strcmp(qname.localName(), kBeamTag) == 0) {
-        auto beam = _beamHandler.result();
-        beam->setParent(_result.get());
-        _result->addBeam(std::move(beam));
-    } else if (strcmp(qname.localName(), kLyricTag) == 0) {
-        auto lyric = _lyricHandler.result();
-        lyric->setParent(_result.get());
-        _result->addLyric(std::move(lyric));
-    } else if (strcmp(qname.localName(), kTimeModificationTag) == 0) {
-        auto timeModification = _timeModificationHandler.result();
-        timeModification->setParent(_result.get());
-        _result->timeModification = std::move(timeModification);
+    switch (_subElementTag) {
+        case Tag::Duration:
+            _result->setDuration(presentOptional(_integerHandler.result()));
+            break;
+        case Tag::Type:
+            _result->setType(presentOptional(typeFromString(_stringHandler.result())));
+            break;
+        case Tag::Chord:
+            _result->setChord(_presenceHandler.result());
+            break;
+        case Tag::Grace:
+            _result->setGrace(_presenceHandler.result());
+            break;
+        case Tag::Stem:
+            _result->setStem(presentOptional(stemFromString(_stringHandler.result())));
+            break;
+        case Tag::Staff:
+            _result->setStaff(_integerHandler.result());
+            break;
+        case Tag::Voice:
+            _result->setVoice(_stringHandler.result());
+            break;
+        case Tag::Pitch: {
+            auto pitch = _pitchHandler.result();
+            pitch->setParent(_result.get());
+            _result->pitch = std::move(pitch);
+            break;
+        }
+        case Tag::Rest: {
+            auto rest = _restHandler.result();
+            rest->setParent(_result.get());
+            _result->rest = std::move(rest);
+            break;
+        }
+        case Tag::Unpitched: {
+            auto unpitched = _unpitchedHandler.result();
+            unpitched->setParent(_result.get());
+            _result->unpitched = _unpitchedHandler.result();
+            break;
+        }
+        case Tag::Accidental: {
+            auto accidental = std::unique_ptr<dom::Accidental>(new dom::Accidental(accidentalTypeFromString(_stringHandler.result())));
+            accidental->setParent(_result.get());
+            _result->accidental = std::move(accidental);
+            break;
+        }
+        case Tag::Dot: {
+            auto dot = _emptyPlacementHandler.result();
+            dot->setParent(_result.get());
+            _result->dot = std::move(dot);
+            break;
+        }
+        case Tag::Tie: {
+            auto tie = _tieHandler.result();
+            tie->setParent(_result.get());
+            _result->tie = std::move(tie);
+            break;
+        }
+        case Tag::Notations: {
+            auto notations = _notationsHandler.result();
+            notations->setParent(_result.get());
+            _result->notations = std::move(notations);
+            break;
+        }
+        case Tag::Beam: {
+            auto beam = _beamHandler.result();
+            beam->setParent(_result.get());
+            _result->addBeam(std::move(beam));
+            break;
+        }
+        case Tag::Lyric: {
+            auto lyric = _lyricHandler.result();
+            lyric->setParent(_result.get());
+            _result->addLyric(std::move(lyric));
+            break;
+        }
+        case Tag::TimeModification: {
+            auto timeModification = _timeModificationHandler.result();
+            timeModification->setParent(_result.get());
+            _result->timeModification = std::move(timeModification);
+            break;
+        }
+        default:
+            break;
     }
 }
 
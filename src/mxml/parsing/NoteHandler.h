@@ -6,7 +6,6 @@
 
 #pragma once
 #include <lxml/BaseRecursiveHandler.h>
-#include <lxml/IntegerHandler.h>
 #include <lxml/PresenceHandler.h>
 #include <lxml/StringHandler.h>
 
@@ -17,11 +16,14 @@
 #include "EmptyPlacementHandler.h"
 #include "LyricHandler.h"
 #include "NotationsHandler.h"
+#include "Numbers.h"
 #include "PitchHandler.h"
+#include "Profile.h"
 #include "RestHandler.h"
 #include "TieHandler.h"
 #include "TimeModificationHandler.h"
 #include "UnpitchedHandler.h"
+#include "Tags.h"
 
 
 namespace mxml {
@@ -29,6 +31,13 @@ namespace parsing {
 
 class NoteHandler : public lxml::BaseRecursiveHandler<std::unique_ptr<dom::Note>> {
 public:
+    NoteHandler() : _profile(Profile::Full) {}
+
+    void setProfile(Profile profile) {
+        _profile = profile;
+        _notationsHandler.setProfile(profile);
+    }
+
     void startElement(const lxml::QName& qname, const AttributeMap& attributes);
     void endElement(const lxml::QName& qname, const std::string& contents);
 
@@ -51,7 +60,7 @@ protected:
     void decreasePitch(dom::Pitch& pitch);
 
 private:
-    lxml::IntegerHandler _integerHandler;
+    IntegerContentHandler _integerHandler;
     lxml::StringHandler _stringHandler;
     lxml::PresenceHandler _presenceHandler;
 
@@ -64,6 +73,8 @@ private:
     NotationsHandler _notationsHandler;
     LyricHandler _lyricHandler;
     TimeModificationHandler _timeModificationHandler;
+    Profile _profile;
+    Tag _subElementTag;
 };
 
 } // namespace parsing
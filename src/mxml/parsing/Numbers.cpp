@@ -0,0 +1,152 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Numbers.h"
+
+#include <cstdint>
+#include <limits>
+#include <locale>
+#include <sstream>
+
+
+namespace mxml {
+namespace parsing {
+
+namespace {
+
+// Powers of ten that are exact in a double
+const double kPowersOfTen[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+const int kMaxExactPower = 22;
+const std::uint64_t kMaxExactMantissa = std::uint64_t(1) << 53;
+const int kMaxMantissaDigits = 19;
+
+bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+const char* skipSpace(const char* begin, const char* end) {
+    while (begin != end && isSpace(*begin))
+        ++begin;
+    return begin;
+}
+
+/**
+ Parse a number the fast path can't represent exactly, independently of the global locale.
+ */
+double parseSlow(const char* begin, const char* end) {
+    std::istringstream is(std::string(begin, end));
+    is.imbue(std::locale::classic());
+    double value = 0;
+    is >> value;
+    return value;
+}
+
+} // namespace
+
+int parseInteger(const char* begin, const char* end) {
+    auto p = skipSpace(begin, end);
+    bool negative = false;
+    if (p != end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        ++p;
+    }
+
+    const long long limit = negative ? -static_cast<long long>(std::numeric_limits<int>::min()) : std::numeric_limits<int>::max();
+    long long value = 0;
+    for (; p != end && isDigit(*p); ++p) {
+        value = value * 10 + (*p - '0');
+        if (value > limit)
+            value = limit;
+    }
+    return static_cast<int>(negative ? -value : value);
+}
+
+double parseDouble(const char* begin, const char* end) {
+    const auto start = skipSpace(begin, end);
+    auto p = start;
+    bool negative = false;
+    if (p != end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        ++p;
+    }
+
+    // Up to 19 significant digits fit in the mantissa, the rest only shift the exponent
+    std::uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool truncated = false;
+    bool any = false;
+    for (; p != end && isDigit(*p); ++p) {
+        any = true;
+        if (digits < kMaxMantissaDigits) {
+            mantissa = mantissa * 10 + static_cast<unsigned>(*p - '0');
+            if (mantissa != 0)
+                digits += 1;
+        } else {
+            exponent += 1;
+            truncated = truncated || *p != '0';
+        }
+    }
+    if (p != end && *p == '.') {
+        ++p;
+        for (; p != end && isDigit(*p); ++p) {
+            any = true;
+            if (digits < kMaxMantissaDigits) {
+                mantissa = mantissa * 10 + static_cast<unsigned>(*p - '0');
+                if (mantissa != 0)
+                    digits += 1;
+                exponent -= 1;
+            } else {
+                truncated = truncated || *p != '0';
+            }
+        }
+    }
+    if (!any)
+        return 0;
+
+    if (p != end && (*p == 'e' || *p == 'E')) {
+        auto q = p + 1;
+        bool negativeExponent = false;
+        if (q != end && (*q == '-' || *q == '+')) {
+            negativeExponent = *q == '-';
+            ++q;
+        }
+        if (q != end && isDigit(*q)) {
+            int value = 0;
+            for (; q != end && isDigit(*q); ++q) {
+                if (value < 10000)
+                    value = value * 10 + (*q - '0');
+            }
+            exponent += negativeExponent ? -value : value;
+            p = q;
+        }
+    }
+
+    if (mantissa == 0)
+        return negative ? -0.0 : 0.0;
+
+    // Both the mantissa and the power of ten are exact, a single multiplication or division rounds correctly
+    if (!truncated && mantissa <= kMaxExactMantissa && exponent >= -kMaxExactPower && exponent <= kMaxExactPower) {
+        auto value = static_cast<double>(mantissa);
+        if (exponent >= 0)
+            value *= kPowersOfTen[exponent];
+        else
+            value /= kPowersOfTen[-exponent];
+        return negative ? -value : value;
+    }
+
+    return parseSlow(start, p);
+}
+
+} // namespace parsing
+} // namespace mxml
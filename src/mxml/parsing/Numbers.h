@@ -0,0 +1,51 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+#include <lxml/BaseRecursiveHandler.h>
+
+#include <string>
+
+
+namespace mxml {
+namespace parsing {
+
+/**
+ Parse a decimal integer from a range of characters. Like strtol it skips leading white space and stops at the first
+ character that is not part of the number, it returns 0 if there is no number. Values out of range are clamped.
+ */
+int parseInteger(const char* begin, const char* end);
+
+inline int parseInteger(const std::string& string) {
+    return parseInteger(string.data(), string.data() + string.size());
+}
+
+/**
+ Parse a decimal floating point number, as used by MusicXML, from a range of characters. The decimal separator is
+ always a period regardless of the C locale. Like strtod it skips leading white space and stops at the first character
+ that is not part of the number, it returns 0 if there is no number. The result is correctly rounded.
+ */
+double parseDouble(const char* begin, const char* end);
+
+inline double parseDouble(const std::string& string) {
+    return parseDouble(string.data(), string.data() + string.size());
+}
+
+/**
+ Handler for elements holding an integer, parsed with parseInteger.
+ */
+class IntegerContentHandler : public lxml::BaseRecursiveHandler<int> {
+public:
+    void startElement(const lxml::QName& qname, const AttributeMap& attributes) {
+        _result = 0;
+    }
+    void endElement(const lxml::QName& qname, const std::string& contents) {
+        _result = parseInteger(contents);
+    }
+};
+
+} // namespace parsing
+} // namespace mxml
@@ -9,6 +9,7 @@
 #include "EmptyPlacementHandler.h"
 #include "MordentHandler.h"
 #include "TurnHandler.h"
+#include "Tags.h"
 
 #include <mxml/dom/Ornaments.h>
 
@@ -24,6 +25,7 @@ private:
     EmptyPlacementHandler _emptyPlacementHandler;
     MordentHandler _mordentHandler;
     TurnHandler _turnHandler;
+    parsing::Tag _subElementTag;
 };
 
 } // namespace
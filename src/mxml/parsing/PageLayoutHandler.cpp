@@ -5,40 +5,52 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "PageLayoutHandler.h"
+#include "Tags.h"
 
 namespace mxml {
 
-static const char* kPageHeightTag = "page-height";
-static const char* kPageWidthTag = "page-width";
-static const char* kPageMarginsTag = "page-margins";
+using namespace parsing;
 
 void PageLayoutHandler::startElement(const lxml::QName& qname, const AttributeMap& attributes) {
     _result = dom::PageLayout{};
 }
 
 lxml::RecursiveHandler* PageLayoutHandler::startSubElement(const lxml::QName& qname) {
-    if (strcmp(qname.localName(), kPageHeightTag) == 0)
-        return &_doubleHandler;
-    else if (strcmp(qname.localName(), kPageWidthTag) == 0)
-        return &_doubleHandler;
-    else if (strcmp(qname.localName(), kPageMarginsTag) == 0)
-        return &_pageMarginsHandler;
+    _subElementTag = elementTag(qname);
+    switch (_subElementTag) {
+        case Tag::PageHeight:
+        case Tag::PageWidth:
+            return &_doubleHandler;
+        case Tag::PageMargins:
+            return &_pageMarginsHandler;
+        default:
+            break;
+    }
     return 0;
 }
 
 void PageLayoutHandler::endSubElement(const lxml::QName& qname, RecursiveHandler* parser) {
-    if (strcmp(qname.localName(), kPageHeightTag) == 0) {
-        auto value = static_cast<dom::tenths_t>(_doubleHandler.result());
-        _result.pageHeight = dom::presentOptional(value);
-    } else if (strcmp(qname.localName(), kPageWidthTag) == 0) {
-        auto value = static_cast<dom::tenths_t>(_doubleHandler.result());
-        _result.pageWidth = dom::presentOptional(value);
-    } else if (strcmp(qname.localName(), kPageMarginsTag) == 0) {
-        auto margins = _pageMarginsHandler.result();
-        if (margins.type == dom::PageMargins::MarginType::Odd || margins.type == dom::PageMargins::MarginType::Both)
-            _result.oddPageMargins = margins;
-        if (margins.type == dom::PageMargins::MarginType::Even || margins.type == dom::PageMargins::MarginType::Both)
-            _result.evenPageMargins = margins;
+    switch (_subElementTag) {
+        case Tag::PageHeight: {
+            auto value = static_cast<dom::tenths_t>(_doubleHandler.result());
+            _result.pageHeight = dom::presentOptional(value);
+            break;
+        }
+        case Tag::PageWidth: {
+            auto value = static_cast<dom::tenths_t>(_doubleHandler.result());
+            _result.pageWidth = dom::presentOptional(value);
+            break;
+        }
+        case Tag::PageMargins: {
+            auto margins = _pageMarginsHandler.result();
+            if (margins.type == dom::PageMargins::MarginType::Odd || margins.type == dom::PageMargins::MarginType::Both)
+                _result.oddPageMargins = margins;
+            if (margins.type == dom::PageMargins::MarginType::Even || margins.type == dom::PageMargins::MarginType::Both)
+                _result.evenPageMargins = margins;
+            break;
+        }
+        default:
+            break;
     }
 }
 
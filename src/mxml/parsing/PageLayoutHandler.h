@@ -11,6 +11,7 @@
 #include <mxml/dom/PageLayout.h>
 
 #include "PageMarginsHandler.h"
+#include "Tags.h"
 
 
 namespace mxml {
@@ -24,6 +25,7 @@ public:
 private:
     lxml::DoubleHandler _doubleHandler;
     PageMarginsHandler _pageMarginsHandler;
+    parsing::Tag _subElementTag;
 };
 
 } // namespace mxml
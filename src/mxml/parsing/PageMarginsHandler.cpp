@@ -5,16 +5,15 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "PageMarginsHandler.h"
+#include "Tags.h"
 
 #include <mxml/dom/InvalidDataError.h>
 
 namespace mxml {
 
+using namespace parsing;
+
 static const char* kTypeAttribute = "type";
-static const char* kLeftMarginTag = "left-margin";
-static const char* kRightMarginTag = "right-margin";
-static const char* kTopMarginTag = "top-margin";
-static const char* kBottomMarginTag = "bottom-margin";
 
 void PageMarginsHandler::startElement(const lxml::QName& qname, const AttributeMap& attributes) {
     _result = dom::PageMargins{};
@@ -25,30 +24,43 @@ void PageMarginsHandler::startElement(const lxml::QName& qname, const AttributeM
 }
 
 lxml::RecursiveHandler* PageMarginsHandler::startSubElement(const lxml::QName& qname) {
-    if (strcmp(qname.localName(), kLeftMarginTag) == 0)
-        return &_doubleHandler;
-    else  if (strcmp(qname.localName(), kRightMarginTag) == 0)
-        return &_doubleHandler;
-    else  if (strcmp(qname.localName(), kTopMarginTag) == 0)
-        return &_doubleHandler;
-    else  if (strcmp(qname.localName(), kBottomMarginTag) == 0)
-        return &_doubleHandler;
+    _subElementTag = elementTag(qname);
+    switch (_subElementTag) {
+        case Tag::LeftMargin:
+        case Tag::RightMargin:
+        case Tag::TopMargin:
+        case Tag::BottomMargin:
+            return &_doubleHandler;
+        default:
+            break;
+    }
     return 0;
 }
 
 void PageMarginsHandler::endSubElement(const lxml::QName& qname, RecursiveHandler* parser) {
-    if (strcmp(qname.localName(), kLeftMarginTag) == 0) {
-        auto value = static_cast<dom::tenths_t>(_doubleHandler.result());
-        _result.left = dom::presentOptional(value);
-    } else if (strcmp(qname.localName(), kRightMarginTag) == 0) {
-        auto value = static_cast<dom::tenths_t>(_doubleHandler.result());
-        _result.right = dom::presentOptional(value);
-    } else if (strcmp(qname.localName(), kTopMarginTag) == 0) {
-        auto value = static_cast<dom::tenths_t>(_doubleHandler.result());
-        _result.top = dom::presentOptional(value);
-    } else if (strcmp(qname.localName(), kBottomMarginTag) == 0) {
-        auto value = static_cast<dom::tenths_t>(_doubleHandler.result());
-        _result.bottom = dom::presentOptional(value);
+    switch (_subElementTag) {
+        case Tag::LeftMargin: {
+            auto value = static_cast<dom::tenths_t>(_doubleHandler.result());
+            _result.left = dom::presentOptional(value);
+            break;
+        }
+        case Tag::RightMargin: {
+            auto value = static_cast<dom::tenths_t>(_doubleHandler.result());
+            _result.right = dom::presentOptional(value);
+            break;
+        }
+        case Tag::TopMargin: {
+            auto value = static_cast<dom::tenths_t>(_doubleHandler.result());
+            _result.top = dom::presentOptional(value);
+            break;
+        }
+        case Tag::BottomMargin: {
+            auto value = static_cast<dom::tenths_t>(_doubleHandler.result());
+            _result.bottom = dom::presentOptional(value);
+            break;
+        }
+        default:
+            break;
     }
 }
 
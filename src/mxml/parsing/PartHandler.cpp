@@ -5,7 +5,7 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "PartHandler.h"
-#include <cstring>
+#include "Tags.h"
 
 namespace mxml {
 namespace parsing {
@@ -14,11 +14,12 @@ using dom::Part;
 using lxml::QName;
 
 static const char* kIdTag = "id";
-static const char* kMeasureTag = "measure";
 
 void PartHandler::startElement(const QName& qname, const AttributeMap& attributes) {
     _result.reset(new Part());
+    _result->setIndex(_index);
     _measureIndex = 0;
+    _attributes.reset();
 
     auto id = attributes.find(kIdTag);
     if (id != attributes.end())
@@ -26,17 +27,21 @@ void PartHandler::startElement(const QName& qname, const AttributeMap& attribute
 }
 
 lxml::RecursiveHandler* PartHandler::startSubElement(const QName& qname) {
-    if (strcmp(qname.localName(), kMeasureTag) == 0)
+    _subElementTag = elementTag(qname);
+    if (_subElementTag == Tag::Measure)
         return &_measureHandler;
     return 0;
 }
 
 void PartHandler::endSubElement(const QName& qname, RecursiveHandler* parser) {
-    if (strcmp(qname.localName(), kMeasureTag) == 0) {
+    if (_subElementTag == Tag::Measure) {
         auto measure = _measureHandler.result();
         measure->setIndex(_measureIndex++);
         measure->setParent(_result.get());
         _result->addMeasure(std::move(measure));
+
+        if (_measureSink)
+            streamMeasure(_measureSink, _index, *_result->measures().back(), _attributes);
     }
 }
 
@@ -7,6 +7,8 @@
 #pragma once
 #include <lxml/BaseRecursiveHandler.h>
 #include "MeasureHandler.h"
+#include "MeasureSink.h"
+#include "Tags.h"
 
 #include <mxml/dom/Part.h>
 
@@ -17,6 +19,26 @@ namespace parsing {
 
 class PartHandler : public lxml::BaseRecursiveHandler<std::unique_ptr<dom::Part>> {
 public:
+    PartHandler() : _measureIndex(), _index(), _measureSink(), _attributes() {}
+
+    /**
+     Set the index of the next part to parse, it is reported to the measure sink.
+     */
+    void setIndex(std::size_t index) {
+        _index = index;
+    }
+
+    /**
+     Report every measure to a sink as soon as it is parsed. The measures are still added to the part.
+     */
+    void setMeasureSink(MeasureSink sink) {
+        _measureSink = std::move(sink);
+    }
+
+    void setProfile(Profile profile) {
+        _measureHandler.setProfile(profile);
+    }
+
     void startElement(const lxml::QName& qname, const AttributeMap& attributes);
     
     RecursiveHandler* startSubElement(const lxml::QName& qname);
@@ -25,6 +47,11 @@ public:
 private:
     MeasureHandler _measureHandler;
     std::size_t _measureIndex;
+
+    std::size_t _index;
+    MeasureSink _measureSink;
+    MeasureAttributes _attributes;
+    Tag _subElementTag;
 };
 
 } // namespace parsing
@@ -0,0 +1,209 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "PartScanner.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+
+namespace mxml {
+namespace parsing {
+
+namespace {
+
+const char* kRootName = "score-partwise";
+const char* kPartName = "part";
+const char* kEncodingName = "encoding";
+const char* kNamespaceName = "xmlns";
+
+bool isNameEnd(char c) {
+    return c == '>' || c == '/' || std::isspace(static_cast<unsigned char>(c));
+}
+
+bool equals(const char* begin, const char* end, const char* name) {
+    const auto length = static_cast<std::size_t>(end - begin);
+    return std::strlen(name) == length && std::equal(begin, end, name);
+}
+
+} // namespace
+
+PartScanner::PartScanner() : _data(), _size(), _parts() {
+}
+
+bool PartScanner::scan(const char* data, std::size_t size) {
+    _data = data;
+    _size = size;
+    _parts.clear();
+
+    std::size_t position = 0;
+    if (startsWith(position, "\xEF\xBB\xBF"))
+        position = 3;
+
+    bool rootFound = false;
+    bool inPart = false;
+    std::size_t depth = 0;
+    Range part{0, 0};
+
+    while (position < _size) {
+        auto next = static_cast<const char*>(std::memchr(_data + position, '<', _size - position));
+        if (!next)
+            break;
+        position = static_cast<std::size_t>(next - _data);
+        const auto begin = position;
+
+        if (startsWith(position, "<?")) {
+            const auto end = find(position, "?>");
+            if (end == std::string::npos)
+                return false;
+            if (startsWith(position, "<?xml") && isNameEnd(_data[position + 5]) && !isUTF8Declaration(position, end))
+                return false;
+            position = end + 2;
+        } else if (startsWith(position, "<!--")) {
+            const auto end = find(position + 4, "-->");
+            if (end == std::string::npos)
+                return false;
+            position = end + 3;
+        } else if (startsWith(position, "<![CDATA[")) {
+            const auto end = find(position, "]]>");
+            if (end == std::string::npos)
+                return false;
+            position = end + 3;
+        } else if (startsWith(position, "<!")) {
+            // An internal DTD subset may declare entities that the parts use, those can't be parsed on their own
+            const auto end = tagEnd(position);
+            if (end == std::string::npos || std::find(_data + position, _data + end, '[') != _data + end)
+                return false;
+            position = end + 1;
+        } else if (startsWith(position, "</")) {
+            const auto end = tagEnd(position);
+            if (end == std::string::npos || depth == 0)
+                return false;
+            position = end + 1;
+
+            depth -= 1;
+            if (inPart && depth == 1) {
+                part.end = position;
+                _parts.push_back(part);
+                inPart = false;
+            }
+        } else {
+            const auto end = tagEnd(position);
+            if (end == std::string::npos)
+                return false;
+            position = end + 1;
+
+            auto nameEnd = begin + 1;
+            while (nameEnd < end && !isNameEnd(_data[nameEnd]))
+                nameEnd += 1;
+            const auto selfClosing = _data[end - 1] == '/';
+
+            if (depth == 0) {
+                if (rootFound || !equals(_data + begin + 1, _data + nameEnd, kRootName))
+                    return false;
+
+                // The parts would be parsed without the namespaces the root declares for them
+                if (declaresNamespace(nameEnd, end))
+                    return false;
+                rootFound = true;
+            } else if (depth == 1 && equals(_data + begin + 1, _data + nameEnd, kPartName)) {
+                part.begin = begin;
+                if (selfClosing) {
+                    part.end = position;
+                    _parts.push_back(part);
+                } else {
+                    inPart = true;
+                }
+            }
+
+            if (!selfClosing)
+                depth += 1;
+        }
+    }
+
+    return rootFound && depth == 0;
+}
+
+std::string PartScanner::skeleton() const {
+    std::string skeleton;
+    std::size_t position = 0;
+    for (auto& part : _parts) {
+        skeleton.append(_data + position, _data + part.begin);
+        position = part.end;
+    }
+    skeleton.append(_data + position, _data + _size);
+    return skeleton;
+}
+
+bool PartScanner::startsWith(std::size_t position, const char* prefix) const {
+    const auto length = std::strlen(prefix);
+    return _size - position >= length && std::memcmp(_data + position, prefix, length) == 0;
+}
+
+std::size_t PartScanner::find(std::size_t position, const char* string) const {
+    const auto end = _data + _size;
+    auto it = std::search(_data + position, end, string, string + std::strlen(string));
+    if (it == end)
+        return std::string::npos;
+    return static_cast<std::size_t>(it - _data);
+}
+
+std::size_t PartScanner::tagEnd(std::size_t position) const {
+    char quote = 0;
+    for (; position < _size; position += 1) {
+        const auto c = _data[position];
+        if (quote) {
+            if (c == quote)
+                quote = 0;
+        } else if (c == '"' || c == '\'') {
+            quote = c;
+        } else if (c == '>') {
+            return position;
+        }
+    }
+    return std::string::npos;
+}
+
+bool PartScanner::declaresNamespace(std::size_t begin, std::size_t end) const {
+    const auto length = std::strlen(kNamespaceName);
+    char quote = 0;
+    for (auto position = begin; position < end; position += 1) {
+        const auto c = _data[position];
+        if (quote) {
+            if (c == quote)
+                quote = 0;
+        } else if (c == '"' || c == '\'') {
+            quote = c;
+        } else if (std::isspace(static_cast<unsigned char>(c)) && end - position > length &&
+                   std::memcmp(_data + position + 1, kNamespaceName, length) == 0) {
+            const auto next = _data[position + 1 + length];
+            if (next == '=' || next == ':' || std::isspace(static_cast<unsigned char>(next)))
+                return true;
+        }
+    }
+    return false;
+}
+
+bool PartScanner::isUTF8Declaration(std::size_t begin, std::size_t end) const {
+    auto it = std::search(_data + begin, _data + end, kEncodingName, kEncodingName + std::strlen(kEncodingName));
+    if (it == _data + end)
+        return true;
+
+    auto quote = std::find_if(it, _data + end, [](char c) { return c == '"' || c == '\''; });
+    if (quote == _data + end)
+        return false;
+    auto valueEnd = std::find(quote + 1, _data + end, *quote);
+
+    std::string encoding(quote + 1, valueEnd);
+    std::transform(encoding.begin(), encoding.end(), encoding.begin(), [](char c) {
+        return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    });
+    return encoding == "utf-8" || encoding == "utf8";
+}
+
+} // namespace parsing
+} // namespace mxml
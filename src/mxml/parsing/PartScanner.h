@@ -0,0 +1,78 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+
+namespace mxml {
+namespace parsing {
+
+/**
+ Splits a score-partwise document at its top level `part` elements without fully parsing it. Each part can then be
+ parsed on its own with a PartHandler and the rest of the document, the skeleton, with a ScoreHandler.
+
+ The scan only understands enough XML to find element boundaries. Documents it cannot split safely, like timewise
+ scores, documents with a non UTF-8 encoding, with an internal DTD subset or with namespace declarations on the root
+ element, are rejected and should be parsed sequentially.
+ */
+class PartScanner {
+public:
+    struct Range {
+        std::size_t begin;
+        std::size_t end;
+    };
+
+public:
+    PartScanner();
+
+    /**
+     Scan a document. Returns false if the document cannot be split. The data is not copied and has to stay valid while
+     the scanner is used.
+     */
+    bool scan(const char* data, std::size_t size);
+
+    /**
+     Get the byte ranges of the top level parts in document order, including their start and end tags.
+     */
+    const std::vector<Range>& parts() const {
+        return _parts;
+    }
+
+    /**
+     Get a copy of the document with all the top level parts removed.
+     */
+    std::string skeleton() const;
+
+protected:
+    bool startsWith(std::size_t position, const char* prefix) const;
+    std::size_t find(std::size_t position, const char* string) const;
+
+    /**
+     Find the `>` that ends the markup starting at position, skipping quoted attribute values.
+     */
+    std::size_t tagEnd(std::size_t position) const;
+
+    /**
+     Check that the XML declaration between begin and end does not declare an encoding other than UTF-8.
+     */
+    bool isUTF8Declaration(std::size_t begin, std::size_t end) const;
+
+    /**
+     Check whether the attributes of the start tag between begin and end declare a namespace.
+     */
+    bool declaresNamespace(std::size_t begin, std::size_t end) const;
+
+private:
+    const char* _data;
+    std::size_t _size;
+    std::vector<Range> _parts;
+};
+
+} // namespace parsing
+} // namespace mxml
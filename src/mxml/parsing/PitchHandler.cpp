@@ -5,39 +5,48 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "PitchHandler.h"
+#include "Tags.h"
 #include <mxml/dom/InvalidDataError.h>
-#include <cstring>
 
 namespace mxml {
 
+using namespace parsing;
+
 using dom::Pitch;
 using lxml::QName;
 
-static const char* kStepTag = "step";
-static const char* kAlterTag = "alter";
-static const char* kOctaveTag = "octave";
-
 void PitchHandler::startElement(const lxml::QName& qname, const AttributeMap& attributes) {
     _result.reset(new Pitch());
 }
 
 lxml::RecursiveHandler* PitchHandler::startSubElement(const QName& qname) {
-    if (strcmp(qname.localName(), kStepTag) == 0)
-        return &_stringHandler;
-    else if (strcmp(qname.localName(), kAlterTag) == 0)
-        return &_integerHandler;
-    else if (strcmp(qname.localName(), kOctaveTag) == 0)
-        return &_integerHandler;
+    _subElementTag = elementTag(qname);
+    switch (_subElementTag) {
+        case Tag::Step:
+            return &_stringHandler;
+        case Tag::Alter:
+        case Tag::Octave:
+            return &_integerHandler;
+        default:
+            break;
+    }
     return 0;
 }
 
 void PitchHandler::endSubElement(const QName& qname, RecursiveHandler* parser) {
-    if (strcmp(qname.localName(), kStepTag) == 0)
-        _result->setStep(stepFromString(_stringHandler.result()));
-    else if (strcmp(qname.localName(), kAlterTag) == 0)
-        _result->setAlter(_integerHandler.result());
-    else if (strcmp(qname.localName(), kOctaveTag) == 0)
-        _result->setOctave(_integerHandler.result());
+    switch (_subElementTag) {
+        case Tag::Step:
+            _result->setStep(stepFromString(_stringHandler.result()));
+            break;
+        case Tag::Alter:
+            _result->setAlter(_integerHandler.result());
+            break;
+        case Tag::Octave:
+            _result->setOctave(_integerHandler.result());
+            break;
+        default:
+            break;
+    }
 }
 
 Pitch::Step PitchHandler::stepFromString(const std::string& string) {
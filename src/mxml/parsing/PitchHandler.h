@@ -6,6 +6,7 @@
 
 #pragma once
 #include <lxml/BaseRecursiveHandler.h>
+#include "Tags.h"
 #include <lxml/DoubleHandler.h>
 #include <lxml/IntegerHandler.h>
 #include <lxml/StringHandler.h>
@@ -26,6 +27,7 @@ private:
     lxml::DoubleHandler _doubleHandler;
     lxml::IntegerHandler _integerHandler;
     lxml::StringHandler _stringHandler;
+    parsing::Tag _subElementTag;
 };
 
 } // namespace mxml
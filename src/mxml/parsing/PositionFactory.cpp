@@ -5,7 +5,9 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "PositionFactory.h"
-#include <lxml/DoubleHandler.h>
+#include "Numbers.h"
+
+#include <cstring>
 
 static const char* kDefaultXAttribute = "default-x";
 static const char* kDefaultYAttribute = "default-y";
@@ -43,33 +45,38 @@ dom::Position PositionFactory::buildFromAttributes(const lxml::RecursiveHandler:
 
 dom::Position PositionFactory::buildFromGenericNode(const GenericNode& node) {
     dom::Position position;
-    dom::Optional<std::string> string;
+    const char* string;
 
     string = node.attribute(kDefaultXAttribute);
     if (string)
-        position.defaultX = value(string.value());
+        position.defaultX = value(string);
     
     string = node.attribute(kDefaultXAttribute);
     if (string)
-        position.defaultX = value(string.value());
+        position.defaultX = value(string);
 
     string = node.attribute(kDefaultYAttribute);
     if (string)
-        position.defaultY = value(string.value());
+        position.defaultY = value(string);
 
     string = node.attribute(kRelativeXAttribute);
     if (string)
-        position.relativeX = value(string.value());
+        position.relativeX = value(string);
 
     string = node.attribute(kRelativeYAttribute);
     if (string)
-        position.relativeY = value(string.value());
+        position.relativeY = value(string);
 
     return position;
 }
 
 dom::Optional<dom::tenths_t> PositionFactory::value(const std::string& string) {
-    auto value = static_cast<dom::tenths_t>(lxml::DoubleHandler::parseDouble(string));
+    auto value = static_cast<dom::tenths_t>(parseDouble(string));
+    return dom::presentOptional(value);
+}
+
+dom::Optional<dom::tenths_t> PositionFactory::value(const char* string) {
+    auto value = static_cast<dom::tenths_t>(parseDouble(string, string + std::strlen(string)));
     return dom::presentOptional(value);
 }
 
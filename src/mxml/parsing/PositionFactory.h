@@ -20,6 +20,7 @@ public:
 
 protected:
     static dom::Optional<dom::tenths_t> value(const std::string& string);
+    static dom::Optional<dom::tenths_t> value(const char* string);
 };
 
 } // namespace parsing
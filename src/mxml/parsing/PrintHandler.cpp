@@ -5,6 +5,7 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "PrintHandler.h"
+#include "Tags.h"
 #include "TypeFactories.h"
 
 #include <lxml/DoubleHandler.h>
@@ -20,14 +21,6 @@ static const char* kNewPageAttribute = "new-page";
 static const char* kBlankPageAttribute = "blank-page";
 static const char* kPageNumberAttribute = "page-number";
 
-static const char* kPageLayoutTag = "page-layout";
-static const char* kSystemLayoutTag = "system-layout";
-static const char* kStaffLayoutTag = "staff-layout";
-static const char* kMeasureLayoutTag = "measure-layout";
-static const char* kMeasureNumberingTag = "measure-numbering";
-static const char* kPartNameDisplayTag = "part-name-display";
-static const char* kPartAbbreviationDisplayTag = "part-abbreviation-display";
-
 void PrintHandler::startElement(const lxml::QName& qname, const AttributeMap& attributes) {
     _result.reset(new dom::Print{});
 
@@ -51,48 +44,63 @@ void PrintHandler::startElement(const lxml::QName& qname, const AttributeMap& at
 }
 
 lxml::RecursiveHandler* PrintHandler::startSubElement(const lxml::QName& qname) {
-    if (strcmp(qname.localName(), kPageLayoutTag) == 0)
-        return &_pageLayoutHandler;
-    else if (strcmp(qname.localName(), kSystemLayoutTag) == 0)
-        return &_systemLayoutHandler;
-    else if (strcmp(qname.localName(), kStaffLayoutTag) == 0)
-        return &_staffLayoutHandler;
-    else if (strcmp(qname.localName(), kPartNameDisplayTag) == 0)
-        return &_formattedTextHandler;
-    else if (strcmp(qname.localName(), kPartAbbreviationDisplayTag) == 0)
-        return &_formattedTextHandler;
+    _subElementTag = elementTag(qname);
+    switch (_subElementTag) {
+        case Tag::PageLayout:
+            return &_pageLayoutHandler;
+        case Tag::SystemLayout:
+            return &_systemLayoutHandler;
+        case Tag::StaffLayout:
+            return &_staffLayoutHandler;
+        default:
+            break;
+    }
 
     return &_genericNodeHandler;
 }
 
 void PrintHandler::endSubElement(const lxml::QName& qname, RecursiveHandler* parser) {
-    if (strcmp(qname.localName(), kPageLayoutTag) == 0) {
-        _result->pageLayout = dom::presentOptional(_pageLayoutHandler.result());
-    } else if (strcmp(qname.localName(), kSystemLayoutTag) == 0) {
-        _result->systemLayout = dom::presentOptional(_systemLayoutHandler.result());
-    } else if (strcmp(qname.localName(), kStaffLayoutTag) == 0) {
-        auto staffLayout = _staffLayoutHandler.result();
-        _result->staffDistances[staffLayout.number] = staffLayout.staffDistance;
-    } else if (strcmp(qname.localName(), kMeasureLayoutTag) == 0) {
-        auto node = _genericNodeHandler.result();
-        auto value = static_cast<dom::tenths_t>(lxml::DoubleHandler::parseDouble(node->text()));
-        _result->measureDistance = dom::presentOptional(value);
-    } else if (strcmp(qname.localName(), kMeasureNumberingTag) == 0) {
-        // Not supported
-    } else if (strcmp(qname.localName(), kPartNameDisplayTag) == 0) {
-        auto partNameDisplayNode = _genericNodeHandler.result();
-        auto displayTextNode = partNameDisplayNode->child("display-text");
-        if (displayTextNode) {
-            auto value = FormattedTextHandler::buildFromGenericNode(*displayTextNode);
-            _result->partNameDisplay = dom::presentOptional(value);
+    switch (_subElementTag) {
+        case Tag::PageLayout:
+            _result->pageLayout = dom::presentOptional(_pageLayoutHandler.result());
+            break;
+        case Tag::SystemLayout:
+            _result->systemLayout = dom::presentOptional(_systemLayoutHandler.result());
+            break;
+        case Tag::StaffLayout: {
+            auto staffLayout = _staffLayoutHandler.result();
+            _result->staffDistances[staffLayout.number] = staffLayout.staffDistance;
+            break;
+        }
+        case Tag::MeasureLayout: {
+            auto tree = _genericNodeHandler.result();
+            auto value = static_cast<dom::tenths_t>(lxml::DoubleHandler::parseDouble(tree->root().text()));
+            _result->measureDistance = dom::presentOptional(value);
+            break;
+        }
+        case Tag::MeasureNumbering:
+            // Not supported
+            break;
+        case Tag::PartNameDisplay: {
+            auto tree = _genericNodeHandler.result();
+            auto displayTextNode = tree->root().child("display-text");
+            if (displayTextNode) {
+                auto value = FormattedTextHandler::buildFromGenericNode(*displayTextNode);
+                _result->partNameDisplay = dom::presentOptional(value);
+            }
+            break;
         }
-    } else if (strcmp(qname.localName(), kPartAbbreviationDisplayTag) == 0) {
-        auto partNameDisplayNode = _genericNodeHandler.result();
-        auto displayTextNode = partNameDisplayNode->child("display-text");
-        if (displayTextNode) {
-            auto value = FormattedTextHandler::buildFromGenericNode(*displayTextNode);
-            _result->partAbbreviationDisplay = dom::presentOptional(value);
+        case Tag::PartAbbreviationDisplay: {
+            auto tree = _genericNodeHandler.result();
+            auto displayTextNode = tree->root().child("display-text");
+            if (displayTextNode) {
+                auto value = FormattedTextHandler::buildFromGenericNode(*displayTextNode);
+                _result->partAbbreviationDisplay = dom::presentOptional(value);
+            }
+            break;
         }
+        default:
+            break;
     }
 }
 
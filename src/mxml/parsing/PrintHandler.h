@@ -16,6 +16,7 @@
 #include "SystemLayoutHandler.h"
 #include "StaffLayoutHandler.h"
 #include "GenericNodeHandler.h"
+#include "Tags.h"
 
 namespace mxml {
 
@@ -26,11 +27,11 @@ public:
     void endSubElement(const lxml::QName& qname, lxml::RecursiveHandler* parser);
     
 private:
-    FormattedTextHandler _formattedTextHandler;
     PageLayoutHandler _pageLayoutHandler;
     SystemLayoutHandler _systemLayoutHandler;
     StaffLayoutHandler _staffLayoutHandler;
     parsing::GenericNodeHandler _genericNodeHandler;
+    parsing::Tag _subElementTag;
 };
 
 } // namespace mxml
@@ -0,0 +1,38 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+
+namespace mxml {
+namespace parsing {
+
+/**
+ Selects the parts of a document that the handlers turn into dom nodes. Elements that a profile doesn't need are skipped
+ along with everything inside them, without allocating any nodes.
+ */
+enum class Profile {
+    /**
+     Everything the handlers understand.
+     */
+    Full,
+
+    /**
+     What playback and EventFactory need: pitches, durations, ties, attributes, directions with their sounds and
+     barlines. Identification, credits, defaults, prints, lyrics, beams, stems, dots, note positions and all notations
+     other than ties are skipped.
+     */
+    Playback,
+
+    /**
+     What rendering needs: everything except identification. Sounds stay because ScoreProperties takes tempos, jumps and
+     repeats from them.
+     */
+    Layout
+};
+
+} // namespace parsing
+} // namespace mxml
@@ -5,30 +5,40 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "ScalingHandler.h"
+#include "Tags.h"
 
 namespace mxml {
 
+using namespace parsing;
+
 using dom::Scaling;
 using lxml::QName;
 
-static const char* kMillimetersTag = "millimeters";
-static const char* kTenthsTag = "tenths";
-
 lxml::RecursiveHandler* ScalingHandler::startSubElement(const QName& qname) {
+    _subElementTag = elementTag(qname);
     _result = Scaling{};
     
-    if (strcmp(qname.localName(), kMillimetersTag) == 0)
-        return &_doubleHandler;
-    else if (strcmp(qname.localName(), kTenthsTag) == 0)
-        return &_doubleHandler;
+    switch (_subElementTag) {
+        case Tag::Millimeters:
+        case Tag::Tenths:
+            return &_doubleHandler;
+        default:
+            break;
+    }
     return 0;
 }
 
 void ScalingHandler::endSubElement(const QName& qname, RecursiveHandler* parser) {
-    if (strcmp(qname.localName(), kMillimetersTag) == 0)
-        _result.millimeters = (float)_doubleHandler.result();
-    else if (strcmp(qname.localName(), kTenthsTag) == 0)
-        _result.tenths = (float)_doubleHandler.result();
+    switch (_subElementTag) {
+        case Tag::Millimeters:
+            _result.millimeters = (float)_doubleHandler.result();
+            break;
+        case Tag::Tenths:
+            _result.tenths = (float)_doubleHandler.result();
+            break;
+        default:
+            break;
+    }
 }
 
 } // namespace mxml
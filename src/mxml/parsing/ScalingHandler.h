@@ -6,6 +6,7 @@
 
 #pragma once
 #include <lxml/BaseRecursiveHandler.h>
+#include "Tags.h"
 #include <lxml/DoubleHandler.h>
 
 #include <mxml/dom/Scaling.h>
@@ -19,6 +20,7 @@ public:
     
 private:
     lxml::DoubleHandler _doubleHandler;
+    parsing::Tag _subElementTag;
 };
 
 } // namespace mxml
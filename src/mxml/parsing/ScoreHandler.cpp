@@ -5,7 +5,7 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "ScoreHandler.h"
-#include <cstring>
+#include "Tags.h"
 
 using namespace lxml;
 
@@ -15,42 +15,96 @@ namespace parsing {
 using dom::Score;
 using lxml::QName;
 
-static const char* kIdentificationTag = "identification";
-static const char* kDefaultsTag = "defaults";
-static const char* kCreditTag = "credit";
-static const char* kPartTag = "part";
+ScoreHandler::ScoreHandler() : _useArena(false), _scoreCurrent(false), _arena(), _previousArena(), _strings(), _previousStrings(), _partIndex(), _timewise(false), _profile(Profile::Full) {
+}
+
+ScoreHandler::~ScoreHandler() {
+    endScore();
+}
 
 void ScoreHandler::startElement(const QName& qname, const AttributeMap& attributes) {
+    endScore();
+
+    // The score itself owns the arena, so it is always allocated from the heap
     _result.reset(new Score());
     _partIndex = 0;
+    _timewise = elementTag(qname) == Tag::ScoreTimewise;
+
+    _arena.reset();
+    if (_useArena) {
+        _arena = std::make_shared<dom::Arena>();
+        _result->setArena(_arena);
+        _previousArena = dom::Arena::setCurrent(_arena.get());
+    }
+
+    _strings = std::make_shared<dom::StringTable>();
+    _result->setStrings(_strings);
+    _previousStrings = dom::StringTable::setCurrent(_strings.get());
+    _scoreCurrent = true;
+
+    _timewiseMeasureHandler.reset(_result.get());
+}
+
+void ScoreHandler::endElement(const QName& qname, const std::string& contents) {
+    endScore();
 }
 
 RecursiveHandler* ScoreHandler::startSubElement(const QName& qname) {
-    if (strcmp(qname.localName(), kIdentificationTag) == 0)
-        return &_identificationHandler;
-    else if (strcmp(qname.localName(), kDefaultsTag) == 0)
-        return &_defaultsHandler;
-    else if (strcmp(qname.localName(), kCreditTag) == 0)
-        return &_creditHandler;
-    else if (strcmp(qname.localName(), kPartTag) == 0)
-        return &_partHandler;
+    _subElementTag = elementTag(qname);
+    switch (_subElementTag) {
+        case Tag::Identification:
+            return _profile == Profile::Full ? &_identificationHandler : 0;
+        case Tag::Defaults:
+            return _profile != Profile::Playback ? &_defaultsHandler : 0;
+        case Tag::Credit:
+            return _profile != Profile::Playback ? &_creditHandler : 0;
+        case Tag::Measure:
+            return _timewise ? &_timewiseMeasureHandler : 0;
+        case Tag::Part:
+            if (_timewise)
+                return 0;
+            _partHandler.setIndex(_partIndex);
+            return &_partHandler;
+        default:
+            break;
+    }
     return 0;
 }
 
 void ScoreHandler::endSubElement(const QName& qname, RecursiveHandler* parser) {
-    if (strcmp(qname.localName(), kIdentificationTag) == 0)
-        _result->setIdentification(_identificationHandler.result());
-    else if (strcmp(qname.localName(), kDefaultsTag) == 0)
-        _result->setDefaults(_defaultsHandler.result());
-    else if (strcmp(qname.localName(), kCreditTag) == 0)
-        _result->addCredit(_creditHandler.result());
-    else if (strcmp(qname.localName(), kPartTag) == 0) {
-        auto part = _partHandler.result();
-        part->setParent(_result.get());
-        part->setIndex(_partIndex++);
-        _result->addPart(std::move(part));
+    switch (_subElementTag) {
+        case Tag::Identification:
+            _result->setIdentification(_identificationHandler.result());
+            break;
+        case Tag::Defaults:
+            _result->setDefaults(_defaultsHandler.result());
+            break;
+        case Tag::Credit:
+            _result->addCredit(_creditHandler.result());
+            break;
+        case Tag::Part: {
+            auto part = _partHandler.result();
+            part->setParent(_result.get());
+            part->setIndex(_partIndex++);
+            _result->addPart(std::move(part));
+            break;
+        }
+        default:
+            break;
     }
 }
 
+void ScoreHandler::endScore() {
+    if (!_scoreCurrent)
+        return;
+
+    if (_arena)
+        dom::Arena::setCurrent(_previousArena);
+    _previousArena = nullptr;
+    dom::StringTable::setCurrent(_previousStrings);
+    _previousStrings = nullptr;
+    _scoreCurrent = false;
+}
+
 } // namespace parsing
 } // namespace mxml
@@ -10,6 +10,9 @@
 #include "DefaultsHandler.h"
 #include "IdentificationHandler.h"
 #include "PartHandler.h"
+#include "Profile.h"
+#include "TimewiseMeasureHandler.h"
+#include "Tags.h"
 #include <mxml/dom/Score.h>
 
 #include <memory>
@@ -17,18 +20,67 @@
 namespace mxml {
 namespace parsing {
 
+/**
+ Handles the root element of both score-partwise and score-timewise documents, the resulting score is the same for
+ both layouts.
+ */
 class ScoreHandler : public lxml::BaseRecursiveHandler<std::unique_ptr<dom::Score>> {
 public:
+    ScoreHandler();
+    ~ScoreHandler();
+
+    /**
+     Allocate all the nodes of the parsed score from an arena owned by the score instead of allocating each node
+     separately. The nodes are freed all at once when the score is destroyed, so they must not outlive the score.
+     Disabled by default.
+     */
+    void setUseArena(bool useArena) {
+        _useArena = useArena;
+    }
+
+    /**
+     Report every measure to a sink as soon as it is parsed, see MeasureSink.
+     */
+    void setMeasureSink(MeasureSink sink) {
+        _partHandler.setMeasureSink(sink);
+        _timewiseMeasureHandler.setMeasureSink(std::move(sink));
+    }
+
+    /**
+     Skip the elements that a profile doesn't need, see Profile. Profile::Full by default.
+     */
+    void setProfile(Profile profile) {
+        _profile = profile;
+        _partHandler.setProfile(profile);
+        _timewiseMeasureHandler.setProfile(profile);
+    }
+
     void startElement(const lxml::QName& qname, const AttributeMap& attributes);
+    void endElement(const lxml::QName& qname, const std::string& contents);
     RecursiveHandler* startSubElement(const lxml::QName& qname);
     void endSubElement(const lxml::QName& qname, lxml::RecursiveHandler* parser);
-    
+
+protected:
+    void endScore();
+
 private:
+    // Declared before the child handlers, partially parsed nodes they hold may live in the arena and use the strings
+    bool _useArena;
+    bool _scoreCurrent;
+    std::shared_ptr<dom::Arena> _arena;
+    dom::Arena* _previousArena;
+    std::shared_ptr<dom::StringTable> _strings;
+    dom::StringTable* _previousStrings;
+
     IdentificationHandler _identificationHandler;
     CreditHandler _creditHandler;
     DefaultsHandler _defaultsHandler;
     PartHandler _partHandler;
+    TimewiseMeasureHandler _timewiseMeasureHandler;
     std::size_t _partIndex;
+    bool _timewise;
+    Profile _profile;
+    Tag _subElementTag;
 };
 
 } // namespace parsing
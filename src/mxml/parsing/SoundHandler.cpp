@@ -5,7 +5,7 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "SoundHandler.h"
-#include <lxml/DoubleHandler.h>
+#include "Numbers.h"
 #include <cstring>
 
 namespace mxml {
@@ -14,6 +14,7 @@ using lxml::QName;
 
 using namespace dom;
 using namespace lxml;
+using parsing::parseDouble;
 
 static const char* kTempoAttribute = "tempo";
 static const char* kDynamicsAttribute = "dynamics";
@@ -38,11 +39,11 @@ void SoundHandler::startElement(const QName& qname, const AttributeMap& attribut
     
     auto tempo = attributes.find(kTempoAttribute);
     if (tempo != attributes.end())
-        _result->tempo = presentOptional(static_cast<float>(DoubleHandler::parseDouble(tempo->second)));
+        _result->tempo = presentOptional(static_cast<float>(parseDouble(tempo->second)));
     
     auto dynamics = attributes.find(kDynamicsAttribute);
     if (dynamics != attributes.end())
-        _result->dynamics = presentOptional(static_cast<float>(DoubleHandler::parseDouble(dynamics->second)));
+        _result->dynamics = presentOptional(static_cast<float>(parseDouble(dynamics->second)));
 
     auto dacapo = attributes.find(kDaCapoAttribute);
     if (dacapo != attributes.end() && dacapo->second == "yes")
@@ -66,7 +67,7 @@ void SoundHandler::startElement(const QName& qname, const AttributeMap& attribut
 
     auto divisions = attributes.find(kDivisionsAttribute);
     if (divisions != attributes.end())
-        _result->divisions = presentOptional(static_cast<float>(DoubleHandler::parseDouble(divisions->second)));
+        _result->divisions = presentOptional(static_cast<float>(parseDouble(divisions->second)));
 
     auto forwardRepeat = attributes.find(kForwardRepeatAttribute);
     if (forwardRepeat != attributes.end() && forwardRepeat->second == "yes")
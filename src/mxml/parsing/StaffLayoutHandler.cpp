@@ -5,12 +5,14 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "StaffLayoutHandler.h"
+#include "Tags.h"
 #include <lxml/IntegerHandler.h>
 
 namespace mxml {
 
+using namespace parsing;
+
 static const char* kNumberAttribute = "number";
-static const char* kStaffDistanceTag = "staff-distance";
 
 void StaffLayoutHandler::startElement(const lxml::QName& qname, const lxml::RecursiveHandler::AttributeMap& attributes) {
     _result = StaffLayout{};
@@ -21,13 +23,14 @@ void StaffLayoutHandler::startElement(const lxml::QName& qname, const lxml::Recu
 }
 
 lxml::RecursiveHandler* StaffLayoutHandler::startSubElement(const lxml::QName& qname) {
-    if (strcmp(qname.localName(), kStaffDistanceTag) == 0)
+    _subElementTag = elementTag(qname);
+    if (_subElementTag == Tag::StaffDistance)
         return &_doubleHandler;
     return 0;
 }
 
 void StaffLayoutHandler::endSubElement(const lxml::QName& qname, RecursiveHandler* parser) {
-    if (strcmp(qname.localName(), kStaffDistanceTag) == 0) {
+    if (_subElementTag == Tag::StaffDistance) {
         auto value = static_cast<dom::tenths_t>(_doubleHandler.result());
         _result.staffDistance = value;
     }
@@ -5,15 +5,13 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "SystemDividersHandler.h"
+#include "Tags.h"
 #include "PositionFactory.h"
 
 namespace mxml {
 
 using namespace parsing;
 
-static const char* kLeftDividerTag = "left-divider";
-static const char* kRightDividerTag = "right-divider";
-
 void SystemDividerHandler::startElement(const lxml::QName& qname, const AttributeMap& attributes) {
     _result = dom::SystemDivider{};
 
@@ -28,16 +26,22 @@ void SystemDividersHandler::startElement(const lxml::QName& qname, const Attribu
 }
 
 lxml::RecursiveHandler* SystemDividersHandler::startSubElement(const lxml::QName& qname) {
-    if (strcmp(qname.localName(), kLeftDividerTag) == 0 || strcmp(qname.localName(), kRightDividerTag))
+    _subElementTag = elementTag(qname);
+    if (_subElementTag == Tag::LeftDivider || _subElementTag == Tag::RightDivider)
         return &_handler;
     return 0;
 }
 
 void SystemDividersHandler::endSubElement(const lxml::QName& qname, RecursiveHandler* parser) {
-    if (strcmp(qname.localName(), kLeftDividerTag) == 0) {
-        _result.leftDivider = _handler.result();
-    } else if (strcmp(qname.localName(), kRightDividerTag) == 0) {
-        _result.rightDivider = _handler.result();
+    switch (_subElementTag) {
+        case Tag::LeftDivider:
+            _result.leftDivider = _handler.result();
+            break;
+        case Tag::RightDivider:
+            _result.rightDivider = _handler.result();
+            break;
+        default:
+            break;
     }
 }
 
@@ -6,6 +6,7 @@
 
 #pragma once
 #include <lxml/BaseRecursiveHandler.h>
+#include "Tags.h"
 #include <mxml/dom/SystemLayout.h>
 
 namespace mxml {
@@ -23,6 +24,7 @@ public:
     
 private:
     SystemDividerHandler _handler;
+    parsing::Tag _subElementTag;
 };
 
 } // namespace mxml
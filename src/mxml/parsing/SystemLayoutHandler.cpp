@@ -5,43 +5,54 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "SystemLayoutHandler.h"
+#include "Tags.h"
 
 namespace mxml {
 
-static const char* kSystemMarginsTag = "system-margins";
-static const char* kSystemDistanceTag = "system-distance";
-static const char* kTopSystemDistanceTag = "top-system-distance";
-static const char* kSystemDividersTag = "system-dividers";
+using namespace parsing;
 
 void SystemLayoutHandler::startElement(const lxml::QName& qname, const AttributeMap& attributes) {
     _result = dom::SystemLayout{};
 }
 
 lxml::RecursiveHandler* SystemLayoutHandler::startSubElement(const lxml::QName& qname) {
-    if (strcmp(qname.localName(), kSystemMarginsTag) == 0)
-        return &_systemMarginsHandler;
-    else if (strcmp(qname.localName(), kSystemDistanceTag) == 0)
-        return &_doubleHandler;
-    else if (strcmp(qname.localName(), kTopSystemDistanceTag) == 0)
-        return &_doubleHandler;
-    else if (strcmp(qname.localName(), kSystemDividersTag) == 0)
-        return &_systemDividersHandler;
+    _subElementTag = elementTag(qname);
+    switch (_subElementTag) {
+        case Tag::SystemMargins:
+            return &_systemMarginsHandler;
+        case Tag::SystemDistance:
+        case Tag::TopSystemDistance:
+            return &_doubleHandler;
+        case Tag::SystemDividers:
+            return &_systemDividersHandler;
+        default:
+            break;
+    }
     return 0;
 }
 
 void SystemLayoutHandler::endSubElement(const lxml::QName& qname, RecursiveHandler* parser) {
     using dom::presentOptional;
 
-    if (strcmp(qname.localName(), kSystemMarginsTag) == 0) {
-        _result.systemMargins = _systemMarginsHandler.result();
-    } else if (strcmp(qname.localName(), kSystemDistanceTag) == 0) {
-        auto value = static_cast<dom::tenths_t>(_doubleHandler.result());
-        _result.systemDistance = presentOptional(value);
-    } else if (strcmp(qname.localName(), kTopSystemDistanceTag) == 0) {
-        auto value = static_cast<dom::tenths_t>(_doubleHandler.result());
-        _result.topSystemDistance = presentOptional(value);
-    } else if (strcmp(qname.localName(), kSystemDividersTag) == 0) {
-        _result.systemDividers = _systemDividersHandler.result();
+    switch (_subElementTag) {
+        case Tag::SystemMargins:
+            _result.systemMargins = _systemMarginsHandler.result();
+            break;
+        case Tag::SystemDistance: {
+            auto value = static_cast<dom::tenths_t>(_doubleHandler.result());
+            _result.systemDistance = presentOptional(value);
+            break;
+        }
+        case Tag::TopSystemDistance: {
+            auto value = static_cast<dom::tenths_t>(_doubleHandler.result());
+            _result.topSystemDistance = presentOptional(value);
+            break;
+        }
+        case Tag::SystemDividers:
+            _result.systemDividers = _systemDividersHandler.result();
+            break;
+        default:
+            break;
     }
 }
 
@@ -12,6 +12,7 @@
 
 #include "SystemDividersHandler.h"
 #include "SystemMarginsHandler.h"
+#include "Tags.h"
 
 
 namespace mxml {
@@ -26,6 +27,7 @@ private:
     lxml::DoubleHandler _doubleHandler;
     SystemDividersHandler _systemDividersHandler;
     SystemMarginsHandler _systemMarginsHandler;
+    parsing::Tag _subElementTag;
 };
 
 } // namespace mxml
@@ -5,29 +5,37 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "SystemMarginsHandler.h"
+#include "Tags.h"
 
 namespace mxml {
 
-static const char* kLeftMarginTag = "left-margin";
-static const char* kRightMarginTag = "right-margin";
+using namespace parsing;
 
 void SystemMarginsHandler::startElement(const lxml::QName& qname, const AttributeMap& attributes) {
     _result = dom::SystemMargins{};
 }
 
 lxml::RecursiveHandler* SystemMarginsHandler::startSubElement(const lxml::QName& qname) {
-    if (strcmp(qname.localName(), kLeftMarginTag) == 0 || strcmp(qname.localName(), kRightMarginTag) == 0)
+    _subElementTag = elementTag(qname);
+    if (_subElementTag == Tag::LeftMargin || _subElementTag == Tag::RightMargin)
         return &_doubleHandler;
     return 0;
 }
 
 void SystemMarginsHandler::endSubElement(const lxml::QName& qname, RecursiveHandler* parser) {
-    if (strcmp(qname.localName(), kLeftMarginTag) == 0) {
-        auto value = static_cast<dom::tenths_t>(_doubleHandler.result());
-        _result.left = dom::presentOptional(value);
-    } else if (strcmp(qname.localName(), kRightMarginTag) == 0) {
-        auto value = static_cast<dom::tenths_t>(_doubleHandler.result());
-        _result.right = dom::presentOptional(value);
+    switch (_subElementTag) {
+        case Tag::LeftMargin: {
+            auto value = static_cast<dom::tenths_t>(_doubleHandler.result());
+            _result.left = dom::presentOptional(value);
+            break;
+        }
+        case Tag::RightMargin: {
+            auto value = static_cast<dom::tenths_t>(_doubleHandler.result());
+            _result.right = dom::presentOptional(value);
+            break;
+        }
+        default:
+            break;
     }
 }
 
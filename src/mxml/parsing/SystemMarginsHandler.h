@@ -6,6 +6,7 @@
 
 #pragma once
 #include <lxml/BaseRecursiveHandler.h>
+#include "Tags.h"
 #include <lxml/DoubleHandler.h>
 #include <mxml/dom/SystemLayout.h>
 #include <memory>
@@ -20,6 +21,7 @@ public:
     
 private:
     lxml::DoubleHandler _doubleHandler;
+    parsing::Tag _subElementTag;
 };
 
 } // namespace mxml
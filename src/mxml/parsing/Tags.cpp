@@ -0,0 +1,215 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Tags.h"
+
+#include <array>
+#include <cstring>
+
+
+namespace mxml {
+namespace parsing {
+
+namespace {
+
+struct TagName {
+    const char* name;
+    Tag tag;
+};
+
+const TagName kTagNames[] = {
+    {"accidental", Tag::Accidental},
+    {"actual-notes", Tag::ActualNotes},
+    {"alter", Tag::Alter},
+    {"appearance", Tag::Appearance},
+    {"articulations", Tag::Articulations},
+    {"attributes", Tag::Attributes},
+    {"backup", Tag::Backup},
+    {"bar-style", Tag::BarStyle},
+    {"barline", Tag::Barline},
+    {"beam", Tag::Beam},
+    {"beat-type", Tag::BeatType},
+    {"beats", Tag::Beats},
+    {"bottom-margin", Tag::BottomMargin},
+    {"bracket", Tag::Bracket},
+    {"cancel", Tag::Cancel},
+    {"chord", Tag::Chord},
+    {"clef", Tag::Clef},
+    {"coda", Tag::Coda},
+    {"creator", Tag::Creator},
+    {"credit", Tag::Credit},
+    {"credit-words", Tag::CreditWords},
+    {"defaults", Tag::Defaults},
+    {"direction", Tag::Direction},
+    {"direction-type", Tag::DirectionType},
+    {"display-octave", Tag::DisplayOctave},
+    {"display-step", Tag::DisplayStep},
+    {"distance", Tag::Distance},
+    {"divisions", Tag::Divisions},
+    {"dot", Tag::Dot},
+    {"duration", Tag::Duration},
+    {"dynamics", Tag::Dynamics},
+    {"ending", Tag::Ending},
+    {"extend", Tag::Extend},
+    {"fermata", Tag::Fermata},
+    {"fifths", Tag::Fifths},
+    {"forward", Tag::Forward},
+    {"grace", Tag::Grace},
+    {"id", Tag::Id},
+    {"identification", Tag::Identification},
+    {"inverted-mordent", Tag::InvertedMordent},
+    {"invertedTurn", Tag::InvertedTurn},
+    {"key", Tag::Key},
+    {"left-divider", Tag::LeftDivider},
+    {"left-margin", Tag::LeftMargin},
+    {"line", Tag::Line},
+    {"line-width", Tag::LineWidth},
+    {"location", Tag::Location},
+    {"lyric", Tag::Lyric},
+    {"measure", Tag::Measure},
+    {"measure-layout", Tag::MeasureLayout},
+    {"measure-numbering", Tag::MeasureNumbering},
+    {"millimeters", Tag::Millimeters},
+    {"mode", Tag::Mode},
+    {"mordent", Tag::Mordent},
+    {"normal-notes", Tag::NormalNotes},
+    {"notations", Tag::Notations},
+    {"note", Tag::Note},
+    {"note-size", Tag::NoteSize},
+    {"octave", Tag::Octave},
+    {"octave-shift", Tag::OctaveShift},
+    {"offset", Tag::Offset},
+    {"ornaments", Tag::Ornaments},
+    {"page-height", Tag::PageHeight},
+    {"page-layout", Tag::PageLayout},
+    {"page-margins", Tag::PageMargins},
+    {"page-width", Tag::PageWidth},
+    {"part", Tag::Part},
+    {"part-abbreviation-display", Tag::PartAbbreviationDisplay},
+    {"part-name-display", Tag::PartNameDisplay},
+    {"pedal", Tag::Pedal},
+    {"pitch", Tag::Pitch},
+    {"print", Tag::Print},
+    {"repeat", Tag::Repeat},
+    {"rest", Tag::Rest},
+    {"right-divider", Tag::RightDivider},
+    {"right-margin", Tag::RightMargin},
+    {"rights", Tag::Rights},
+    {"rootfile", Tag::Rootfile},
+    {"rootfiles", Tag::Rootfiles},
+    {"scaling", Tag::Scaling},
+    {"score-partwise", Tag::ScorePartwise},
+    {"score-timewise", Tag::ScoreTimewise},
+    {"segno", Tag::Segno},
+    {"senza-misura", Tag::SenzaMisura},
+    {"sign", Tag::Sign},
+    {"slur", Tag::Slur},
+    {"sound", Tag::Sound},
+    {"source", Tag::Source},
+    {"staff", Tag::Staff},
+    {"staff-distance", Tag::StaffDistance},
+    {"staff-layout", Tag::StaffLayout},
+    {"staves", Tag::Staves},
+    {"stem", Tag::Stem},
+    {"step", Tag::Step},
+    {"syllabic", Tag::Syllabic},
+    {"system-distance", Tag::SystemDistance},
+    {"system-dividers", Tag::SystemDividers},
+    {"system-layout", Tag::SystemLayout},
+    {"system-margins", Tag::SystemMargins},
+    {"tenths", Tag::Tenths},
+    {"text", Tag::Text},
+    {"tie", Tag::Tie},
+    {"tied", Tag::Tied},
+    {"time", Tag::Time},
+    {"time-modification", Tag::TimeModification},
+    {"top-margin", Tag::TopMargin},
+    {"top-system-distance", Tag::TopSystemDistance},
+    {"trill-mark", Tag::TrillMark},
+    {"tuplet", Tag::Tuplet},
+    {"tuplet-actual", Tag::TupletActual},
+    {"tuplet-normal", Tag::TupletNormal},
+    {"turn", Tag::Turn},
+    {"type", Tag::Type},
+    {"unpitched", Tag::Unpitched},
+    {"voice", Tag::Voice},
+    {"wedge", Tag::Wedge},
+    {"words", Tag::Words},
+    {"f", Tag::DynamicsF},
+    {"ff", Tag::DynamicsFf},
+    {"fff", Tag::DynamicsFff},
+    {"ffff", Tag::DynamicsFfff},
+    {"fffff", Tag::DynamicsFffff},
+    {"ffffff", Tag::DynamicsFfffff},
+    {"fp", Tag::DynamicsFp},
+    {"fz", Tag::DynamicsFz},
+    {"mf", Tag::DynamicsMf},
+    {"mp", Tag::DynamicsMp},
+    {"p", Tag::DynamicsP},
+    {"pp", Tag::DynamicsPp},
+    {"ppp", Tag::DynamicsPpp},
+    {"pppp", Tag::DynamicsPppp},
+    {"ppppp", Tag::DynamicsPpppp},
+    {"pppppp", Tag::DynamicsPppppp},
+    {"rf", Tag::DynamicsRf},
+    {"rfz", Tag::DynamicsRfz},
+    {"sf", Tag::DynamicsSf},
+    {"sffz", Tag::DynamicsSffz},
+    {"sfp", Tag::DynamicsSfp},
+    {"sfpp", Tag::DynamicsSfpp},
+    {"sfz", Tag::DynamicsSfz}
+};
+
+const std::size_t kTableSize = 512; // Power of two, at least twice the number of names
+
+std::size_t hash(const char* name) {
+    // FNV-1a
+    std::size_t hash = 2166136261u;
+    for (; *name; ++name) {
+        hash ^= static_cast<unsigned char>(*name);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ Open addressing hash table from names to tags, built once.
+ */
+class TagTable {
+public:
+    TagTable() {
+        _entries.fill(nullptr);
+        for (auto& tagName : kTagNames) {
+            auto index = hash(tagName.name) & (kTableSize - 1);
+            while (_entries[index])
+                index = (index + 1) & (kTableSize - 1);
+            _entries[index] = &tagName;
+        }
+    }
+
+    Tag find(const char* name) const {
+        auto index = hash(name) & (kTableSize - 1);
+        while (auto entry = _entries[index]) {
+            if (std::strcmp(entry->name, name) == 0)
+                return entry->tag;
+            index = (index + 1) & (kTableSize - 1);
+        }
+        return Tag::Unknown;
+    }
+
+private:
+    std::array<const TagName*, kTableSize> _entries;
+};
+
+} // namespace
+
+Tag tagFromName(const char* name) {
+    static const TagTable table;
+    return table.find(name);
+}
+
+} // namespace parsing
+} // namespace mxml
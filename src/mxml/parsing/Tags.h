@@ -0,0 +1,188 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+#include <lxml/QName.h>
+
+#include <cstdint>
+
+
+namespace mxml {
+namespace parsing {
+
+/**
+ Dense identifiers for the MusicXML element names that the handlers dispatch on. Handlers look up the tag of an element
+ once and switch on it instead of comparing the name against every element they know.
+ */
+enum class Tag : std::uint16_t {
+    Unknown,
+
+    Accidental,
+    ActualNotes,
+    Alter,
+    Appearance,
+    Articulations,
+    Attributes,
+    Backup,
+    BarStyle,
+    Barline,
+    Beam,
+    BeatType,
+    Beats,
+    BottomMargin,
+    Bracket,
+    Cancel,
+    Chord,
+    Clef,
+    Coda,
+    Creator,
+    Credit,
+    CreditWords,
+    Defaults,
+    Direction,
+    DirectionType,
+    DisplayOctave,
+    DisplayStep,
+    Distance,
+    Divisions,
+    Dot,
+    Duration,
+    Dynamics,
+    Ending,
+    Extend,
+    Fermata,
+    Fifths,
+    Forward,
+    Grace,
+    Id,
+    Identification,
+    InvertedMordent,
+    InvertedTurn,
+    Key,
+    LeftDivider,
+    LeftMargin,
+    Line,
+    LineWidth,
+    Location,
+    Lyric,
+    Measure,
+    MeasureLayout,
+    MeasureNumbering,
+    Millimeters,
+    Mode,
+    Mordent,
+    NormalNotes,
+    Notations,
+    Note,
+    NoteSize,
+    Octave,
+    OctaveShift,
+    Offset,
+    Ornaments,
+    PageHeight,
+    PageLayout,
+    PageMargins,
+    PageWidth,
+    Part,
+    PartAbbreviationDisplay,
+    PartNameDisplay,
+    Pedal,
+    Pitch,
+    Print,
+    Repeat,
+    Rest,
+    RightDivider,
+    RightMargin,
+    Rights,
+    Rootfile,
+    Rootfiles,
+    Scaling,
+    ScorePartwise,
+    ScoreTimewise,
+    Segno,
+    SenzaMisura,
+    Sign,
+    Slur,
+    Sound,
+    Source,
+    Staff,
+    StaffDistance,
+    StaffLayout,
+    Staves,
+    Stem,
+    Step,
+    Syllabic,
+    SystemDistance,
+    SystemDividers,
+    SystemLayout,
+    SystemMargins,
+    Tenths,
+    Text,
+    Tie,
+    Tied,
+    Time,
+    TimeModification,
+    TopMargin,
+    TopSystemDistance,
+    TrillMark,
+    Tuplet,
+    TupletActual,
+    TupletNormal,
+    Turn,
+    Type,
+    Unpitched,
+    Voice,
+    Wedge,
+    Words,
+
+    // Dynamics marks
+    DynamicsF,
+    DynamicsFf,
+    DynamicsFff,
+    DynamicsFfff,
+    DynamicsFffff,
+    DynamicsFfffff,
+    DynamicsFp,
+    DynamicsFz,
+    DynamicsMf,
+    DynamicsMp,
+    DynamicsP,
+    DynamicsPp,
+    DynamicsPpp,
+    DynamicsPppp,
+    DynamicsPpppp,
+    DynamicsPppppp,
+    DynamicsRf,
+    DynamicsRfz,
+    DynamicsSf,
+    DynamicsSffz,
+    DynamicsSfp,
+    DynamicsSfpp,
+    DynamicsSfz
+};
+
+/**
+ Get the tag for an element name, Tag::Unknown if the name is not one of the known elements.
+ */
+Tag tagFromName(const char* name);
+
+/**
+ Get the tag for an element. Handlers call this once per sub element in startSubElement and keep the result for the
+ matching endSubElement call, which always comes before the next startSubElement on the same handler.
+ */
+inline Tag elementTag(const lxml::QName& qname) {
+    return tagFromName(qname.localName());
+}
+
+/**
+ Return true if the tag is one of the dynamics marks like `p` or `sfz`.
+ */
+inline bool isDynamicsMark(Tag tag) {
+    return tag >= Tag::DynamicsF && tag <= Tag::DynamicsSfz;
+}
+
+} // namespace parsing
+} // namespace mxml
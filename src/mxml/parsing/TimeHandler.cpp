@@ -5,19 +5,18 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "TimeHandler.h"
+#include "Tags.h"
 #include <mxml/dom/InvalidDataError.h>
-#include <cstring>
 
 namespace mxml {
 
+using namespace parsing;
+
 using dom::Time;
 using lxml::QName;
 
 static const char* kNumberAttribute = "number";
 static const char* kSymbolAttribute = "symbol";
-static const char* kSenzaMisuraTag = "senza-misura";
-static const char* kBeatsTag = "beats";
-static const char* kBeatTypeTag = "beat-type";
 
 void TimeHandler::startElement(const QName& qname, const AttributeMap& attributes) {
     using dom::presentOptional;
@@ -34,24 +33,35 @@ void TimeHandler::startElement(const QName& qname, const AttributeMap& attribute
 }
 
 lxml::RecursiveHandler* TimeHandler::startSubElement(const QName& qname) {
-    if (strcmp(qname.localName(), kBeatsTag) == 0)
-        return &_integerHandler;
-    else if (strcmp(qname.localName(), kBeatTypeTag) == 0)
-        return &_integerHandler;
-    else if (strcmp(qname.localName(), kSenzaMisuraTag) == 0)
-        return &_stringHandler;
+    _subElementTag = elementTag(qname);
+    switch (_subElementTag) {
+        case Tag::Beats:
+        case Tag::BeatType:
+            return &_integerHandler;
+        case Tag::SenzaMisura:
+            return &_stringHandler;
+        default:
+            break;
+    }
     return 0;
 }
 
 void TimeHandler::endSubElement(const QName& qname, RecursiveHandler* parser) {
     using dom::presentOptional;
 
-    if (strcmp(qname.localName(), kBeatsTag) == 0)
-        _result->setBeats(_integerHandler.result());
-    else if (strcmp(qname.localName(), kBeatTypeTag) == 0)
-        _result->setBeatType(_integerHandler.result());
-    else if (strcmp(qname.localName(), kSenzaMisuraTag) == 0)
-        _result->setSenzaMisura(presentOptional(_stringHandler.result()));
+    switch (_subElementTag) {
+        case Tag::Beats:
+            _result->setBeats(_integerHandler.result());
+            break;
+        case Tag::BeatType:
+            _result->setBeatType(_integerHandler.result());
+            break;
+        case Tag::SenzaMisura:
+            _result->setSenzaMisura(presentOptional(_stringHandler.result()));
+            break;
+        default:
+            break;
+    }
 }
 
 Time::Symbol TimeHandler::symbolFromString(const std::string& string) {
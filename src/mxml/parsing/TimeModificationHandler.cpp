@@ -5,29 +5,38 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "TimeModificationHandler.h"
+#include "Tags.h"
 
 namespace mxml {
 
-static const char* kActualNotesTag = "actual-notes";
-static const char* kNormalNotesTag = "normal-notes";
+using namespace parsing;
 
 void TimeModificationHandler::startElement(const lxml::QName& qname, const AttributeMap& attributes) {
     _result.reset(new dom::TimeModification{});
 }
 
 lxml::RecursiveHandler* TimeModificationHandler::startSubElement(const lxml::QName& qname) {
-    if (strcmp(qname.localName(), kActualNotesTag) == 0)
-        return &_integerHandler;
-    else if (strcmp(qname.localName(), kNormalNotesTag) == 0)
-        return &_integerHandler;
+    _subElementTag = elementTag(qname);
+    switch (_subElementTag) {
+        case Tag::ActualNotes:
+        case Tag::NormalNotes:
+            return &_integerHandler;
+        default:
+            break;
+    }
     return 0;
 }
 
 void TimeModificationHandler::endSubElement(const lxml::QName& qname, RecursiveHandler* parser) {
-    if (strcmp(qname.localName(), kActualNotesTag) == 0) {
-        _result->actualNotes = _integerHandler.result();
-    } else if (strcmp(qname.localName(), kNormalNotesTag) == 0) {
-        _result->normalNotes = _integerHandler.result();
+    switch (_subElementTag) {
+        case Tag::ActualNotes:
+            _result->actualNotes = _integerHandler.result();
+            break;
+        case Tag::NormalNotes:
+            _result->normalNotes = _integerHandler.result();
+            break;
+        default:
+            break;
     }
 }
 
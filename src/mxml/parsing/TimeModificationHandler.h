@@ -6,6 +6,7 @@
 
 #pragma once
 #include <lxml/BaseRecursiveHandler.h>
+#include "Tags.h"
 #include <lxml/IntegerHandler.h>
 #include <mxml/dom/TimeModification.h>
 #include <memory>
@@ -20,6 +21,7 @@ public:
     
 private:
     lxml::IntegerHandler _integerHandler;
+    parsing::Tag _subElementTag;
 };
 
 } // namespace mxml
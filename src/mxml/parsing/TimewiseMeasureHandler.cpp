@@ -0,0 +1,119 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "TimewiseMeasureHandler.h"
+#include "Tags.h"
+
+namespace mxml {
+namespace parsing {
+
+using lxml::QName;
+
+static const char* kIdAttribute = "id";
+static const char* kNumberAttribute = "number";
+
+void TimewisePartHandler::startElement(const QName& qname, const AttributeMap& attributes) {
+    MeasureHandler::startElement(qname, attributes);
+
+    _partId.clear();
+    auto id = attributes.find(kIdAttribute);
+    if (id != attributes.end())
+        _partId = id->second;
+}
+
+TimewiseMeasureHandler::TimewiseMeasureHandler() : _score(), _partIndices(), _partsDone(), _measureIndex(), _number(), _measureSink(), _attributes() {
+}
+
+void TimewiseMeasureHandler::reset(dom::Score* score) {
+    _score = score;
+    _partIndices.clear();
+    _partsDone.clear();
+    _measureIndex = 0;
+    _attributes.clear();
+}
+
+void TimewiseMeasureHandler::startElement(const QName& qname, const AttributeMap& attributes) {
+    _partsDone.assign(_partsDone.size(), false);
+
+    _number.clear();
+    auto number = attributes.find(kNumberAttribute);
+    if (number != attributes.end())
+        _number = number->second;
+}
+
+void TimewiseMeasureHandler::endElement(const QName& qname, const std::string& contents) {
+    for (std::size_t index = 0; index < _partsDone.size(); index += 1) {
+        if (!_partsDone[index])
+            addEmptyMeasure(index, _number, qname);
+    }
+    _measureIndex += 1;
+}
+
+lxml::RecursiveHandler* TimewiseMeasureHandler::startSubElement(const QName& qname) {
+    _subElementTag = elementTag(qname);
+    if (_subElementTag == Tag::Part)
+        return &_partHandler;
+    return 0;
+}
+
+void TimewiseMeasureHandler::endSubElement(const QName& qname, RecursiveHandler* parser) {
+    if (_subElementTag != Tag::Part)
+        return;
+
+    auto measure = _partHandler.result();
+    const auto index = partIndex(_partHandler.partId(), qname);
+    if (_partsDone[index])
+        return; // The same part twice in one measure, keep the first
+
+    addMeasure(index, std::move(measure), _number);
+    _partsDone[index] = true;
+}
+
+std::size_t TimewiseMeasureHandler::partIndex(const std::string& id, const QName& qname) {
+    auto it = _partIndices.find(id);
+    if (it != _partIndices.end())
+        return it->second;
+
+    const auto index = _score->parts().size();
+    _partIndices.emplace(id, index);
+    _partsDone.push_back(false);
+    _attributes.emplace_back();
+
+    // The measure count is only known at the end of the document, until then parts grow as measures arrive like
+    // partwise parts do. A part that starts late already needs room for the measures before it and the current one.
+    std::unique_ptr<dom::Part> part(new dom::Part(id));
+    part->setParent(_score);
+    part->setIndex(index);
+    part->reserveMeasures(_measureIndex + 1);
+    _score->addPart(std::move(part));
+
+    // A part that starts late is silent in the measures before it
+    const auto& firstPart = *_score->parts().front();
+    for (std::size_t measureIndex = 0; measureIndex < _measureIndex; measureIndex += 1)
+        addEmptyMeasure(index, firstPart.measures()[measureIndex]->number(), qname);
+    return index;
+}
+
+void TimewiseMeasureHandler::addMeasure(std::size_t partIndex, std::unique_ptr<dom::Measure> measure, const std::string& number) {
+    auto& part = *_score->parts()[partIndex];
+    measure->setNumber(number);
+    measure->setIndex(part.measures().size());
+    measure->setParent(&part);
+    part.addMeasure(std::move(measure));
+
+    if (_measureSink)
+        streamMeasure(_measureSink, partIndex, *part.measures().back(), _attributes[partIndex]);
+}
+
+void TimewiseMeasureHandler::addEmptyMeasure(std::size_t partIndex, const std::string& number, const QName& qname) {
+    // Run the part handler without contents, it fills empty measures the same way for both layouts
+    _partHandler.startElement(qname, AttributeMap());
+    _partHandler.endElement(qname, std::string());
+    addMeasure(partIndex, _partHandler.result(), number);
+}
+
+} // namespace parsing
+} // namespace mxml
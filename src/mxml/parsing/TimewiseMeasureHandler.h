@@ -0,0 +1,85 @@
+// Copyright © 2016 Venture Media Labs.
+//
+// This file is part of mxml. The full mxml copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+#include <lxml/RecursiveHandler.h>
+#include "MeasureHandler.h"
+#include "MeasureSink.h"
+#include "Tags.h"
+
+#include <mxml/dom/Score.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mxml {
+namespace parsing {
+
+/**
+ Handles the `part` elements inside a timewise measure. Their contents are the same as a partwise measure's.
+ */
+class TimewisePartHandler : public MeasureHandler {
+public:
+    void startElement(const lxml::QName& qname, const AttributeMap& attributes);
+
+    const std::string& partId() const {
+        return _partId;
+    }
+
+private:
+    std::string _partId;
+};
+
+/**
+ Handles the `measure` elements of a score-timewise document. Every part of a measure is appended directly to its part
+ in the score, so the score ends up the same as for the partwise equivalent without building an intermediate tree.
+ Parts are created in the order they first appear. A part missing from a measure gets an empty measure, like an empty
+ partwise measure, so that measure indices line up across parts.
+ */
+class TimewiseMeasureHandler : public lxml::RecursiveHandler {
+public:
+    TimewiseMeasureHandler();
+
+    /**
+     Start a new document, the parts are added to the given score.
+     */
+    void reset(dom::Score* score);
+
+    void setMeasureSink(MeasureSink sink) {
+        _measureSink = std::move(sink);
+    }
+
+    void setProfile(Profile profile) {
+        _partHandler.setProfile(profile);
+    }
+
+    void startElement(const lxml::QName& qname, const AttributeMap& attributes);
+    void endElement(const lxml::QName& qname, const std::string& contents);
+    RecursiveHandler* startSubElement(const lxml::QName& qname);
+    void endSubElement(const lxml::QName& qname, lxml::RecursiveHandler* parser);
+
+protected:
+    std::size_t partIndex(const std::string& id, const lxml::QName& qname);
+    void addMeasure(std::size_t partIndex, std::unique_ptr<dom::Measure> measure, const std::string& number);
+    void addEmptyMeasure(std::size_t partIndex, const std::string& number, const lxml::QName& qname);
+
+private:
+    TimewisePartHandler _partHandler;
+
+    dom::Score* _score;
+    std::unordered_map<std::string, std::size_t> _partIndices;
+    std::vector<bool> _partsDone;
+    std::size_t _measureIndex;
+    std::string _number;
+
+    MeasureSink _measureSink;
+    std::vector<MeasureAttributes> _attributes;
+    Tag _subElementTag;
+};
+
+} // namespace parsing
+} // namespace mxml
@@ -5,6 +5,7 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "TupletHandler.h"
+#include "Tags.h"
 
 #include "EmptyPlacementHandler.h"
 #include "TypeFactories.h"
@@ -22,8 +23,6 @@ static const char* kShowNumberAttribute = "show-number";
 static const char* kShowTypeAttribute = "show-type";
 static const char* kTypeAttribute = "type";
 
-static const char* kActualTag = "tuplet-actual";
-static const char* kNormalTag = "tuplet-normal";
 
 
 void TupletHandler::startElement(const lxml::QName& qname, const AttributeMap& attributes) {
@@ -57,30 +56,41 @@ void TupletHandler::startElement(const lxml::QName& qname, const AttributeMap& a
 }
 
 lxml::RecursiveHandler* TupletHandler::startSubElement(const lxml::QName& qname) {
-    if (strcmp(qname.localName(), kActualTag) == 0)
-        return &_genericNodeHandler;
-    else if (strcmp(qname.localName(), kNormalTag) == 0)
-        return &_genericNodeHandler;
+    _subElementTag = elementTag(qname);
+    switch (_subElementTag) {
+        case Tag::TupletActual:
+        case Tag::TupletNormal:
+            return &_genericNodeHandler;
+        default:
+            break;
+    }
     return 0;
 }
 
 void TupletHandler::endSubElement(const lxml::QName& qname, RecursiveHandler* parser) {
-    if (strcmp(qname.localName(), kActualTag) == 0) {
-        auto node = _genericNodeHandler.result();
-        auto number = node->child("tuplet-number");
-        if (number)
-            _result->actual.number = dom::presentOptional(lxml::IntegerHandler::parseInteger(number->text()));
-        auto type = node->child("tuplet-type");
-        if (type)
-            _result->actual.type = dom::presentOptional(NoteHandler::typeFromString(type->text()));
-    } else if (strcmp(qname.localName(), kNormalTag) == 0) {
-        auto node = _genericNodeHandler.result();
-        auto number = node->child("tuplet-number");
-        if (number)
-            _result->normal.number = dom::presentOptional(lxml::IntegerHandler::parseInteger(number->text()));
-        auto type = node->child("tuplet-type");
-        if (type)
-            _result->normal.type = dom::presentOptional(NoteHandler::typeFromString(type->text()));
+    switch (_subElementTag) {
+        case Tag::TupletActual: {
+            auto tree = _genericNodeHandler.result();
+            auto number = tree->root().child("tuplet-number");
+            if (number)
+                _result->actual.number = dom::presentOptional(lxml::IntegerHandler::parseInteger(number->text()));
+            auto type = tree->root().child("tuplet-type");
+            if (type)
+                _result->actual.type = dom::presentOptional(NoteHandler::typeFromString(type->text()));
+            break;
+        }
+        case Tag::TupletNormal: {
+            auto tree = _genericNodeHandler.result();
+            auto number = tree->root().child("tuplet-number");
+            if (number)
+                _result->normal.number = dom::presentOptional(lxml::IntegerHandler::parseInteger(number->text()));
+            auto type = tree->root().child("tuplet-type");
+            if (type)
+                _result->normal.type = dom::presentOptional(NoteHandler::typeFromString(type->text()));
+            break;
+        }
+        default:
+            break;
     }
 }
 
@@ -12,6 +12,7 @@
 #include <memory>
 
 #include "GenericNodeHandler.h"
+#include "Tags.h"
 
 
 namespace mxml {
@@ -30,6 +31,7 @@ private:
     lxml::IntegerHandler _integerHandler;
     lxml::StringHandler _stringHandler;
     GenericNodeHandler _genericNodeHandler;
+    Tag _subElementTag;
 };
 
 } // namespace parsing
@@ -5,8 +5,8 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "TypeFactories.h"
+#include "Numbers.h"
 
-#include <lxml/DoubleHandler.h>
 #include <mxml/dom/InvalidDataError.h>
 #include <cstring>
 
@@ -24,7 +24,7 @@ bool Factory::yesNoValue(const std::string& string) {
 }
 
 dom::tenths_t Factory::tenthsValue(const std::string& string) {
-    return static_cast<dom::tenths_t>(lxml::DoubleHandler::parseDouble(string));
+    return static_cast<dom::tenths_t>(parseDouble(string));
 }
 
 dom::Optional<dom::Justify> JustifyFactory::buildFromAttributes(const AttributeMap& attributes) {
@@ -38,7 +38,7 @@ dom::Optional<dom::Justify> JustifyFactory::buildFromAttributes(const AttributeM
 dom::Optional<dom::Justify> JustifyFactory::buildFromGenericNode(const GenericNode& node) {
     auto string = node.attribute("justify");
     if (string)
-        return value(string.value());
+        return value(string);
 
     return dom::absentOptional(dom::Justify::Left);
 }
@@ -65,7 +65,7 @@ dom::Optional<dom::HAlign> HAlignFactory::buildFromAttributes(const AttributeMap
 dom::Optional<dom::HAlign> HAlignFactory::buildFromGenericNode(const GenericNode& node) {
     auto string = node.attribute("halign");
     if (string)
-        return value(string.value());
+        return value(string);
 
     return dom::absentOptional(dom::HAlign::Left);
 }
@@ -92,7 +92,7 @@ dom::Optional<dom::VAlign> VAlignFactory::buildFromAttributes(const AttributeMap
 dom::Optional<dom::VAlign> VAlignFactory::buildFromGenericNode(const GenericNode& node) {
     auto string = node.attribute("valign");
     if (string)
-        return value(string.value());
+        return value(string);
 
     return dom::absentOptional(dom::VAlign::Top);
 }
@@ -120,7 +120,7 @@ bool PrintObjectFactory::buildFromAttributes(const AttributeMap& attributes) {
 bool PrintObjectFactory::buildFromGenericNode(const GenericNode& node) {
     auto string = node.attribute("print-object");
     if (string)
-        return yesNoValue(string.value());
+        return yesNoValue(string);
     return true;
 }
 
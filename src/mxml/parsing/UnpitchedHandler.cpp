@@ -5,34 +5,44 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "UnpitchedHandler.h"
+#include "Tags.h"
 #include "PitchHandler.h"
-#include <cstring>
 
 namespace mxml {
 
+using namespace parsing;
+
 using dom::Unpitched;
 using lxml::QName;
 
-static const char* kDisplayStepTag = "display-step";
-static const char* kDisplayOctaveTag = "display-octave";
-
 void UnpitchedHandler::startElement(const lxml::QName& qname, const AttributeMap& attributes) {
     _result.reset(new Unpitched());
 }
 
 lxml::RecursiveHandler* UnpitchedHandler::startSubElement(const QName& qname) {
-    if (strcmp(qname.localName(), kDisplayStepTag) == 0)
-        return &_stringHandler;
-    else if (strcmp(qname.localName(), kDisplayOctaveTag) == 0)
-        return &_integerHandler;
+    _subElementTag = elementTag(qname);
+    switch (_subElementTag) {
+        case Tag::DisplayStep:
+            return &_stringHandler;
+        case Tag::DisplayOctave:
+            return &_integerHandler;
+        default:
+            break;
+    }
     return 0;
 }
 
 void UnpitchedHandler::endSubElement(const QName& qname, RecursiveHandler* parser) {
-    if (strcmp(qname.localName(), kDisplayStepTag) == 0)
-        _result->setDisplayStep(PitchHandler::stepFromString(_stringHandler.result()));
-    else if (strcmp(qname.localName(), kDisplayOctaveTag) == 0)
-        _result->setDisplayOctave(_integerHandler.result());
+    switch (_subElementTag) {
+        case Tag::DisplayStep:
+            _result->setDisplayStep(PitchHandler::stepFromString(_stringHandler.result()));
+            break;
+        case Tag::DisplayOctave:
+            _result->setDisplayOctave(_integerHandler.result());
+            break;
+        default:
+            break;
+    }
 }
 
 } // namespace mxml
@@ -5,11 +5,15 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include <lxml/lxml.h>
+#include <mxml/parsing/PartScanner.h>
 #include <mxml/parsing/ScoreHandler.h>
 #include <mxml/EventFactory.h>
+#include <mxml/Parse.h>
 #include <mxml/ScoreBuilder.h>
+#include <mxml/geometry/ScrollScoreGeometry.h>
 
 #include <fstream>
+#include <sstream>
 #include <boost/test/unit_test.hpp>
 #include <unistd.h>
 
@@ -43,6 +47,314 @@ BOOST_AUTO_TEST_CASE(moonlight) {
     BOOST_CHECK_EQUAL(scoreProperties.tempo(14, 0), 160);
 }
 
+BOOST_AUTO_TEST_CASE(moonlight_arena) {
+    ScoreHandler handler;
+    handler.setUseArena(true);
+    std::ifstream is(kMoonlightFileName);
+    lxml::parse(is, kMoonlightFileName, handler);
+
+    const dom::Score& score = *handler.result();
+    BOOST_REQUIRE(score.arena());
+    BOOST_CHECK_GT(score.arena()->size(), 0);
+    BOOST_CHECK(dom::Arena::current() == nullptr);
+
+    ScoreProperties scoreProperties(score, ScoreProperties::LayoutType::Scroll);
+    EventFactory factory(score, scoreProperties);
+    auto events = factory.build();
+    BOOST_CHECK_EQUAL(events->events().size(), 3737);
+}
+
+BOOST_AUTO_TEST_CASE(moonlight_playback) {
+    ScoreHandler fullHandler;
+    std::ifstream fullStream(kMoonlightFileName);
+    lxml::parse(fullStream, kMoonlightFileName, fullHandler);
+    auto fullScore = fullHandler.result();
+
+    ScoreHandler handler;
+    handler.setProfile(Profile::Playback);
+    std::ifstream is(kMoonlightFileName);
+    lxml::parse(is, kMoonlightFileName, handler);
+    const dom::Score& score = *handler.result();
+
+    BOOST_CHECK(!score.identification());
+    BOOST_CHECK(!score.defaults());
+    BOOST_CHECK(score.credits().empty());
+    for (auto& measure : score.parts().front()->measures()) {
+        for (auto& node : measure->nodes()) {
+            BOOST_CHECK(node->kind() != dom::Node::Kind::Print);
+            if (node->kind() == dom::Node::Kind::Chord)
+                BOOST_CHECK(static_cast<const dom::Chord&>(*node).notes().front()->beams().empty());
+        }
+    }
+
+    ScoreProperties fullProperties(*fullScore, ScoreProperties::LayoutType::Scroll);
+    auto fullEvents = EventFactory(*fullScore, fullProperties).build();
+
+    ScoreProperties scoreProperties(score, ScoreProperties::LayoutType::Scroll);
+    auto events = EventFactory(score, scoreProperties).build();
+    BOOST_REQUIRE_EQUAL(events->events().size(), fullEvents->events().size());
+    for (std::size_t index = 0; index < events->events().size(); index += 1) {
+        auto& event = events->events()[index];
+        auto& fullEvent = fullEvents->events()[index];
+        BOOST_CHECK_EQUAL(event.absoluteTime(), fullEvent.absoluteTime());
+        BOOST_CHECK_EQUAL(event.onNotes().size(), fullEvent.onNotes().size());
+        BOOST_CHECK_EQUAL(event.offNotes().size(), fullEvent.offNotes().size());
+    }
+    BOOST_CHECK_CLOSE(scoreProperties.tempo(13, 240), 80, 0.01);
+}
+
+static std::size_t soundCount(const dom::Score& score) {
+    std::size_t count = 0;
+    for (auto& part : score.parts()) {
+        for (auto& measure : part->measures()) {
+            for (auto& node : measure->nodes()) {
+                if (node->kind() == dom::Node::Kind::Direction && static_cast<const dom::Direction&>(*node).sound())
+                    count += 1;
+            }
+        }
+    }
+    return count;
+}
+
+static std::unique_ptr<dom::Score> parseWithProfile(const char* fileName, Profile profile) {
+    ScoreHandler handler;
+    handler.setProfile(profile);
+    std::ifstream is(fileName);
+    lxml::parse(is, fileName, handler);
+    return handler.result();
+}
+
+BOOST_AUTO_TEST_CASE(layout_profile_properties) {
+    const char* fileNames[] = {kMoonlightFileName, kEventsDSAlCodaFileName};
+    for (auto fileName : fileNames) {
+        auto fullScore = parseWithProfile(fileName, Profile::Full);
+        auto score = parseWithProfile(fileName, Profile::Layout);
+        BOOST_CHECK(!score->identification());
+        BOOST_CHECK_GT(soundCount(*fullScore), 0);
+        BOOST_CHECK_EQUAL(soundCount(*score), soundCount(*fullScore));
+
+        ScoreProperties fullProperties(*fullScore, ScoreProperties::LayoutType::Scroll);
+        ScoreProperties properties(*score, ScoreProperties::LayoutType::Scroll);
+        BOOST_REQUIRE_EQUAL(properties.measureCount(), fullProperties.measureCount());
+        BOOST_CHECK_EQUAL(properties.loops().size(), fullProperties.loops().size());
+        BOOST_CHECK_EQUAL(properties.jumps().size(), fullProperties.jumps().size());
+        for (std::size_t measureIndex = 0; measureIndex < properties.measureCount(); measureIndex += 1)
+            BOOST_CHECK_EQUAL(properties.tempo(measureIndex, 0), fullProperties.tempo(measureIndex, 0));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(layout_profile_geometry) {
+    const char* fileNames[] = {kEventsDSAlCodaFileName, kEventsComplex2FileName};
+    for (auto fileName : fileNames) {
+        auto fullScore = parseWithProfile(fileName, Profile::Full);
+        auto score = parseWithProfile(fileName, Profile::Layout);
+
+        ScrollScoreGeometry fullGeometry(*fullScore);
+        ScrollScoreGeometry geometry(*score);
+        BOOST_CHECK_GT(fullGeometry.size().width, 0);
+        BOOST_CHECK_EQUAL(geometry.size().width, fullGeometry.size().width);
+        BOOST_CHECK_EQUAL(geometry.size().height, fullGeometry.size().height);
+        BOOST_REQUIRE_EQUAL(geometry.partGeometries().size(), fullGeometry.partGeometries().size());
+        for (std::size_t partIndex = 0; partIndex < geometry.partGeometries().size(); partIndex += 1) {
+            auto frame = geometry.partGeometries()[partIndex]->frame();
+            auto fullFrame = fullGeometry.partGeometries()[partIndex]->frame();
+            BOOST_CHECK_EQUAL(frame.origin.x, fullFrame.origin.x);
+            BOOST_CHECK_EQUAL(frame.origin.y, fullFrame.origin.y);
+            BOOST_CHECK_EQUAL(frame.size.width, fullFrame.size.width);
+            BOOST_CHECK_EQUAL(frame.size.height, fullFrame.size.height);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(sequence_builder) {
+    ScoreHandler handler;
+    std::ifstream is(kMoonlightFileName);
+    lxml::parse(is, kMoonlightFileName, handler);
+
+    const dom::Score& score = *handler.result();
+    ScoreProperties scoreProperties(score, ScoreProperties::LayoutType::Scroll);
+    EventFactory factory(score, scoreProperties);
+    auto events = factory.build();
+
+    // Split every event in two halves with the same time, plus a late event out of order
+    EventSequence::Builder builder(scoreProperties);
+    EventSequence expected(scoreProperties);
+    for (auto& event : events->events()) {
+        auto first = event;
+        first.clearOffNotes();
+        auto second = event;
+        second.clearOnNotes();
+        second.setBeatMark(false);
+        for (auto& half : {first, second}) {
+            builder.add(half);
+            expected.addEvent(half);
+        }
+    }
+    auto late = events->events().at(10);
+    builder.add(late);
+    expected.addEvent(late);
+
+    auto built = builder.finish();
+    BOOST_REQUIRE_EQUAL(built->events().size(), expected.events().size());
+    BOOST_CHECK_EQUAL(built->events().size(), events->events().size());
+    for (std::size_t i = 0; i < built->events().size(); i += 1) {
+        auto& event = built->events()[i];
+        auto& expectedEvent = expected.events()[i];
+        BOOST_CHECK_EQUAL(event.absoluteTime(), expectedEvent.absoluteTime());
+        BOOST_CHECK_EQUAL(event.measureIndex(), expectedEvent.measureIndex());
+        BOOST_CHECK_EQUAL(event.isBeatMark(), expectedEvent.isBeatMark());
+        BOOST_CHECK(event.onNotes() == expectedEvent.onNotes());
+        BOOST_CHECK(event.offNotes() == expectedEvent.offNotes());
+        BOOST_CHECK(event.notes() == built->events().front().notes());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(event_note_pools) {
+    ScoreBuilder builder;
+    auto part = builder.addPart();
+    auto measure = builder.addMeasure(part);
+    auto note1 = builder.addNote(measure, dom::Note::Type::Quarter, 0);
+    auto note2 = builder.addNote(measure, dom::Note::Type::Quarter, 1);
+    auto note3 = builder.addNote(measure, dom::Note::Type::Quarter, 2);
+    auto score = builder.build();
+
+    EventNotes notes;
+    Event first(*score);
+    first.setNotes(notes);
+    Event second(*score);
+    second.setNotes(notes);
+
+    // Adding to an event that is not at the end of the pool moves its range
+    first.addOnNote(*note1);
+    second.addOnNote(*note2);
+    first.addOnNote(*note3);
+    BOOST_REQUIRE_EQUAL(first.onNotes().size(), 2);
+    BOOST_CHECK_EQUAL(first.onNotes()[0], note1);
+    BOOST_CHECK_EQUAL(first.onNotes()[1], note3);
+    BOOST_REQUIRE_EQUAL(second.onNotes().size(), 1);
+    BOOST_CHECK_EQUAL(second.onNotes().front(), note2);
+    BOOST_CHECK(first.offNotes().empty());
+
+    // Notes may come from the same pool
+    second.addOnNotes(first.onNotes());
+    BOOST_REQUIRE_EQUAL(second.onNotes().size(), 3);
+    BOOST_CHECK_EQUAL(second.onNotes()[1], note1);
+    BOOST_CHECK_EQUAL(second.onNotes()[2], note3);
+
+    // Moving to other pools copies the notes
+    EventNotes otherNotes;
+    auto copy = second;
+    copy.setNotes(otherNotes);
+    BOOST_CHECK(copy.onNotes() == second.onNotes());
+    BOOST_CHECK_EQUAL(otherNotes.onNotes.size(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(cursor_matches_sequence) {
+    const char* fileNames[] = {kMoonlightFileName, kEventsRepeatFileName, kEventsRepeatLastMeasureFileName, kEventsDSAlCodaFileName, kEventsComplex1FileName, kEventsComplex2FileName};
+    for (auto fileName : fileNames) {
+        BOOST_TEST_MESSAGE(fileName);
+        ScoreHandler handler;
+        std::ifstream is(fileName);
+        lxml::parse(is, fileName, handler);
+
+        const dom::Score& score = *handler.result();
+        ScoreProperties scoreProperties(score, ScoreProperties::LayoutType::Scroll);
+        auto events = EventFactory(score, scoreProperties).build();
+        auto cursor = EventFactory(score, scoreProperties).buildCursor();
+
+        for (auto& expectedEvent : events->events()) {
+            BOOST_REQUIRE(!cursor->atEnd());
+            auto& event = cursor->event();
+            BOOST_CHECK_EQUAL(event.absoluteTime(), expectedEvent.absoluteTime());
+            BOOST_CHECK_EQUAL(event.measureIndex(), expectedEvent.measureIndex());
+            BOOST_CHECK_EQUAL(event.measureTime(), expectedEvent.measureTime());
+            BOOST_CHECK_EQUAL(event.isBeatMark(), expectedEvent.isBeatMark());
+            BOOST_CHECK_EQUAL(event.wallTime(), expectedEvent.wallTime());
+            BOOST_CHECK_EQUAL(event.wallTimeDuration(), expectedEvent.wallTimeDuration());
+            BOOST_CHECK(event.onNotes() == expectedEvent.onNotes());
+            BOOST_CHECK(event.offNotes() == expectedEvent.offNotes());
+            cursor->next();
+        }
+        BOOST_CHECK(cursor->atEnd());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(cursor_seek) {
+    ScoreHandler handler;
+    std::ifstream is(kEventsComplex1FileName);
+    lxml::parse(is, kEventsComplex1FileName, handler);
+
+    const dom::Score& score = *handler.result();
+    ScoreProperties scoreProperties(score, ScoreProperties::LayoutType::Scroll);
+    auto events = EventFactory(score, scoreProperties).build();
+    auto cursor = EventFactory(score, scoreProperties).buildCursor();
+    BOOST_REQUIRE_GT(events->events().size(), 4);
+
+    // Seek forward, backward and between events
+    auto& last = events->events().back();
+    cursor->seek(last.absoluteTime());
+    BOOST_REQUIRE(!cursor->atEnd());
+    BOOST_CHECK_EQUAL(cursor->event().absoluteTime(), last.absoluteTime());
+
+    auto& second = events->events().at(1);
+    auto& third = events->events().at(2);
+    cursor->seek(second.absoluteTime() + 1);
+    BOOST_REQUIRE(!cursor->atEnd());
+    BOOST_CHECK_EQUAL(cursor->event().absoluteTime(), third.absoluteTime());
+
+    cursor->seekWallTime(third.wallTime());
+    BOOST_REQUIRE(!cursor->atEnd());
+    BOOST_CHECK_EQUAL(cursor->event().wallTime(), third.wallTime());
+
+    cursor->seek(last.absoluteTime() + 1);
+    BOOST_CHECK(cursor->atEnd());
+
+    cursor->reset();
+    BOOST_REQUIRE(!cursor->atEnd());
+    BOOST_CHECK_EQUAL(cursor->event().absoluteTime(), events->events().front().absoluteTime());
+}
+
+BOOST_AUTO_TEST_CASE(parallel_build) {
+    // Ensemble score made of copies of the moonlight part, notes of different parts share events
+    std::ifstream is(kMoonlightFileName);
+    std::stringstream ss;
+    ss << is.rdbuf();
+    const auto contents = ss.str();
+    parsing::PartScanner scanner;
+    BOOST_REQUIRE(scanner.scan(contents.data(), contents.size()));
+    BOOST_REQUIRE(!scanner.parts().empty());
+
+    const auto& range = scanner.parts().front();
+    auto xml = contents.substr(0, range.begin);
+    for (int index = 0; index < 6; index += 1)
+        xml += contents.substr(range.begin, range.end - range.begin);
+    xml += contents.substr(range.end);
+
+    auto score = parseBuffer(xml.data(), xml.size(), kMoonlightFileName);
+    BOOST_REQUIRE_EQUAL(score->parts().size(), 6);
+    ScoreProperties scoreProperties(*score, ScoreProperties::LayoutType::Scroll);
+
+    EventFactory serialFactory(*score, scoreProperties);
+    auto expected = serialFactory.build();
+    EventFactory parallelFactory(*score, scoreProperties);
+    parallelFactory.setThreads(4);
+    auto events = parallelFactory.build();
+
+    BOOST_REQUIRE_EQUAL(events->events().size(), expected->events().size());
+    for (std::size_t i = 0; i < events->events().size(); i += 1) {
+        auto& event = events->events()[i];
+        auto& expectedEvent = expected->events()[i];
+        BOOST_CHECK_EQUAL(event.absoluteTime(), expectedEvent.absoluteTime());
+        BOOST_CHECK_EQUAL(event.measureIndex(), expectedEvent.measureIndex());
+        BOOST_CHECK_EQUAL(event.measureTime(), expectedEvent.measureTime());
+        BOOST_CHECK_EQUAL(event.isBeatMark(), expectedEvent.isBeatMark());
+        BOOST_CHECK_EQUAL(event.wallTime(), expectedEvent.wallTime());
+        BOOST_CHECK_EQUAL(event.wallTimeDuration(), expectedEvent.wallTimeDuration());
+        BOOST_CHECK(event.onNotes() == expectedEvent.onNotes());
+        BOOST_CHECK(event.offNotes() == expectedEvent.offNotes());
+    }
+}
+
 BOOST_AUTO_TEST_CASE(beats_short_measure) {
     ScoreBuilder builder;
     auto part = builder.addPart();
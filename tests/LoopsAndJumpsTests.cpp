@@ -8,6 +8,7 @@
 #include <mxml/EventFactory.h>
 #include <mxml/JumpFactory.h>
 #include <mxml/LoopFactory.h>
+#include <mxml/ScoreProperties.h>
 #include <mxml/parsing/ScoreHandler.h>
 
 #include <boost/test/unit_test.hpp>
@@ -66,3 +67,37 @@ BOOST_AUTO_TEST_CASE(repeats) {
     BOOST_CHECK_EQUAL(jumps[1].from, 5);
     BOOST_CHECK_EQUAL(jumps[1].to, 0);
 }
+
+BOOST_AUTO_TEST_CASE(measureTables) {
+    ScoreHandler handler;
+    std::ifstream is(kLoopsFileName);
+    lxml::parse(is, kLoopsFileName, handler);
+
+    const dom::Score& score = *handler.result();
+    ScoreProperties properties(score, ScoreProperties::LayoutType::Scroll);
+
+    BOOST_CHECK(properties.loop(0) == nullptr);
+    BOOST_CHECK(properties.loop(1) == &properties.loops()[0]);
+    BOOST_CHECK(properties.loop(2) == &properties.loops()[0]);
+    BOOST_CHECK(properties.loop(3) == &properties.loops()[1]);
+    BOOST_CHECK(properties.loop(4) == &properties.loops()[1]);
+    BOOST_CHECK(properties.loop(static_cast<std::size_t>(-1)) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(measureJumps) {
+    ScoreHandler handler;
+    std::ifstream is(kRepeatsFileName);
+    lxml::parse(is, kRepeatsFileName, handler);
+
+    const dom::Score& score = *handler.result();
+    ScoreProperties properties(score, ScoreProperties::LayoutType::Scroll);
+
+    // Jumps are taken when reaching the measure after the one they are from
+    BOOST_CHECK(properties.jumps(0).empty());
+    BOOST_CHECK(properties.jumps(2).empty());
+    BOOST_REQUIRE_EQUAL(properties.jumps(3).size(), 1);
+    BOOST_CHECK_EQUAL(properties.jumps(3).begin()->to, 4);
+    BOOST_REQUIRE_EQUAL(properties.jumps(6).size(), 1);
+    BOOST_CHECK_EQUAL(properties.jumps(6).begin()->to, 0);
+    BOOST_CHECK(properties.jumps(100).empty());
+}
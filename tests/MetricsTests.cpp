@@ -4,6 +4,7 @@
 // terms governing use, modification, and redistribution, is contained in the
 // file LICENSE at the root of the source code distribution tree.
 
+#include <mxml/PageMetrics.h>
 #include <mxml/ScoreBuilder.h>
 #include <mxml/ScrollMetrics.h>
 
@@ -102,3 +103,37 @@ BOOST_AUTO_TEST_CASE(noteY) {
     note.pitch = std::unique_ptr<Pitch>(new Pitch(Pitch::Step::F, 0, 3));
     BOOST_CHECK_EQUAL(metrics.noteY(note), Metrics::staffHeight() + 65 + 10);
 }
+
+BOOST_AUTO_TEST_CASE(pageMetricsPrintLayout) {
+    ScoreBuilder builder;
+    auto part = builder.addPart();
+    auto measure1 = builder.addMeasure(part);
+    auto attributes = builder.addAttributes(measure1);
+    attributes->setStaves(dom::presentOptional(2));
+    builder.setTrebleClef(attributes, 1);
+    builder.setBassClef(attributes, 2);
+
+    auto print1 = builder.addPrint(measure1);
+    print1->staffDistances[2] = 90;
+
+    auto measure2 = builder.addMeasure(part);
+    auto print2 = builder.addPrint(measure2, true);
+    print2->systemLayout.setPresentValue(SystemLayout{});
+    print2->systemLayout.value().systemDistance.setPresentValue(120);
+
+    builder.addMeasure(part);
+    auto score = builder.build();
+    ScoreProperties scoreProperties(*score, ScoreProperties::LayoutType::Page);
+
+    PageMetrics metrics0(*score, scoreProperties, 0, 0);
+    BOOST_CHECK_EQUAL(metrics0.staffDistance(), 90);
+    BOOST_CHECK_EQUAL(metrics0.systemDistance(), 80);
+
+    PageMetrics metrics1(*score, scoreProperties, 1, 0);
+    BOOST_CHECK_EQUAL(metrics1.staffDistance(), 65);
+    BOOST_CHECK_EQUAL(metrics1.systemDistance(), 120);
+
+    PageMetrics metrics2(*score, scoreProperties, 2, 0);
+    BOOST_CHECK_EQUAL(metrics2.staffDistance(), 65);
+    BOOST_CHECK_EQUAL(metrics2.systemDistance(), 80);
+}
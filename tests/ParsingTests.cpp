@@ -5,14 +5,123 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include <lxml/lxml.h>
+#include <mxml/Parse.h>
+#include <mxml/ScoreBuilder.h>
+#include <mxml/ScoreSnapshot.h>
+#include <mxml/ZipArchive.h>
+#include <mxml/parsing/GenericNodeHandler.h>
+#include <mxml/parsing/Numbers.h>
+#include <mxml/parsing/PartScanner.h>
 #include <mxml/parsing/ScoreHandler.h>
+#include <mxml/parsing/Tags.h>
+#include <mxml/dom/Chord.h>
+#include <mxml/dom/InvalidDataError.h>
+#include <mxml/dom/Lyric.h>
+#include <mxml/dom/Note.h>
+#include <mxml/dom/Print.h>
+#include <clocale>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <map>
 #include <sstream>
+#include <system_error>
 #include <boost/test/unit_test.hpp>
 
 
 using namespace mxml;
 using namespace mxml::parsing;
 
+namespace {
+
+std::string measureContents(std::size_t part, std::size_t measure) {
+    return
+        "      <attributes><divisions>4</divisions></attributes>\n"
+        "      <note><pitch><step>C</step><octave>" + std::to_string(part % 8) + "</octave></pitch><duration>4</duration></note>\n"
+        "      <note><rest/><duration>" + std::to_string(measure) + "</duration></note>\n";
+}
+
+/**
+ Build a partwise document where every part has as many measures as its number, or measureCount measures if given.
+ */
+std::string partwiseDocument(std::size_t partCount, std::size_t measureCount = 0) {
+    std::string xml =
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        "<score-partwise>\n"
+        "  <!-- <part id=\"P0\"> -->\n"
+        "  <part-list>\n";
+    for (std::size_t index = 1; index <= partCount; index += 1)
+        xml += "    <score-part id=\"P" + std::to_string(index) + "\"><part-name>Part > " + std::to_string(index) + "</part-name></score-part>\n";
+    xml += "  </part-list>\n";
+
+    for (std::size_t index = 1; index <= partCount; index += 1) {
+        xml += "  <part id=\"P" + std::to_string(index) + "\">\n";
+        for (std::size_t measure = 1; measure <= (measureCount ? measureCount : index); measure += 1) {
+            xml += "    <measure number=\"" + std::to_string(measure) + "\">\n";
+            xml += measureContents(index, measure);
+            xml += "    </measure>\n";
+        }
+        xml += "  </part>\n";
+    }
+    xml += "</score-partwise>\n";
+    return xml;
+}
+
+std::string timewiseDocument(std::size_t partCount, std::size_t measureCount) {
+    std::string xml = "<score-timewise>\n  <part-list/>\n";
+    for (std::size_t measure = 1; measure <= measureCount; measure += 1) {
+        xml += "  <measure number=\"" + std::to_string(measure) + "\">\n";
+        for (std::size_t index = 1; index <= partCount; index += 1) {
+            xml += "    <part id=\"P" + std::to_string(index) + "\">\n";
+            xml += measureContents(index, measure);
+            xml += "    </part>\n";
+        }
+        xml += "  </measure>\n";
+    }
+    xml += "</score-timewise>\n";
+    return xml;
+}
+
+void checkSameScore(const dom::Score& score, const dom::Score& expected) {
+    BOOST_REQUIRE_EQUAL(score.parts().size(), expected.parts().size());
+    for (std::size_t partIndex = 0; partIndex < score.parts().size(); partIndex += 1) {
+        auto& part = *score.parts()[partIndex];
+        auto& expectedPart = *expected.parts()[partIndex];
+        BOOST_CHECK_EQUAL(part.id(), expectedPart.id());
+        BOOST_CHECK_EQUAL(part.index(), partIndex);
+        BOOST_CHECK(part.parent() == &score);
+
+        BOOST_REQUIRE_EQUAL(part.measures().size(), expectedPart.measures().size());
+        for (std::size_t measureIndex = 0; measureIndex < part.measures().size(); measureIndex += 1) {
+            auto& measure = *part.measures()[measureIndex];
+            auto& expectedMeasure = *expectedPart.measures()[measureIndex];
+            BOOST_CHECK_EQUAL(measure.index(), measureIndex);
+            BOOST_CHECK(measure.parent() == &part);
+
+            BOOST_REQUIRE_EQUAL(measure.nodes().size(), expectedMeasure.nodes().size());
+            for (std::size_t nodeIndex = 0; nodeIndex < measure.nodes().size(); nodeIndex += 1) {
+                auto& node = *measure.nodes()[nodeIndex];
+                auto& expectedNode = *expectedMeasure.nodes()[nodeIndex];
+                BOOST_REQUIRE(node.kind() == expectedNode.kind());
+                if (node.kind() != dom::Node::Kind::Note)
+                    continue;
+
+                auto& note = static_cast<const dom::Note&>(node);
+                auto& expectedNote = static_cast<const dom::Note&>(expectedNode);
+                BOOST_CHECK_EQUAL(note.start(), expectedNote.start());
+                BOOST_CHECK_EQUAL(note.duration(), expectedNote.duration());
+                BOOST_REQUIRE_EQUAL(bool(note.pitch), bool(expectedNote.pitch));
+                if (note.pitch)
+                    BOOST_CHECK_EQUAL(note.pitch->octave(), expectedNote.pitch->octave());
+            }
+        }
+    }
+}
+
+} // namespace
+
 BOOST_AUTO_TEST_CASE(parseMusicXML) {
     const char musicXML[] =
         "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
@@ -94,4 +203,504 @@ BOOST_AUTO_TEST_CASE(parseMusicXML) {
     BOOST_CHECK(note.stem() == dom::Stem::Down);
     BOOST_CHECK_EQUAL(note.staff(), 1);
     BOOST_CHECK(note.dot);
-}
\ No newline at end of file
+}
+
+BOOST_AUTO_TEST_CASE(parseMappedFile) {
+    static const char* kFileName = "moonlight.xml";
+
+    ScoreHandler handler;
+    std::ifstream is(kFileName);
+    lxml::parse(is, kFileName, handler);
+    auto expected = handler.result();
+
+    auto score = parseFile(kFileName);
+    BOOST_REQUIRE(score);
+    BOOST_REQUIRE_EQUAL(score->parts().size(), expected->parts().size());
+    for (std::size_t partIndex = 0; partIndex < score->parts().size(); partIndex += 1) {
+        auto& part = *score->parts()[partIndex];
+        auto& expectedPart = *expected->parts()[partIndex];
+        BOOST_REQUIRE_EQUAL(part.measures().size(), expectedPart.measures().size());
+        for (std::size_t measureIndex = 0; measureIndex < part.measures().size(); measureIndex += 1)
+            BOOST_CHECK_EQUAL(part.measures()[measureIndex]->nodes().size(), expectedPart.measures()[measureIndex]->nodes().size());
+    }
+
+    BOOST_CHECK_THROW(parseFile("missing.xml"), std::system_error);
+}
+
+BOOST_AUTO_TEST_CASE(tagNames) {
+    BOOST_CHECK(tagFromName("note") == Tag::Note);
+    BOOST_CHECK(tagFromName("part-name-display") == Tag::PartNameDisplay);
+    BOOST_CHECK(tagFromName("octave-shift") == Tag::OctaveShift);
+    BOOST_CHECK(tagFromName("sfz") == Tag::DynamicsSfz);
+    BOOST_CHECK(tagFromName("notes") == Tag::Unknown);
+    BOOST_CHECK(tagFromName("") == Tag::Unknown);
+
+    BOOST_CHECK(isDynamicsMark(tagFromName("pppppp")));
+    BOOST_CHECK(!isDynamicsMark(tagFromName("dynamics")));
+}
+
+BOOST_AUTO_TEST_CASE(scanParts) {
+    const auto xml = partwiseDocument(3);
+
+    PartScanner scanner;
+    BOOST_REQUIRE(scanner.scan(xml.data(), xml.size()));
+    BOOST_REQUIRE_EQUAL(scanner.parts().size(), 3);
+    for (auto& range : scanner.parts()) {
+        BOOST_CHECK_EQUAL(xml.compare(range.begin, 6, "<part "), 0);
+        BOOST_CHECK_EQUAL(xml.compare(range.end - 7, 7, "</part>"), 0);
+    }
+    BOOST_CHECK_EQUAL(scanner.skeleton().find("<measure"), std::string::npos);
+
+    const std::string timewise = "<score-timewise><measure number=\"1\"><part id=\"P1\"/></measure></score-timewise>";
+    BOOST_CHECK(!scanner.scan(timewise.data(), timewise.size()));
+
+    const std::string latin1 = "<?xml version=\"1.0\" encoding=\"ISO-8859-1\"?><score-partwise/>";
+    BOOST_CHECK(!scanner.scan(latin1.data(), latin1.size()));
+
+    const std::string truncated = "<score-partwise><part id=\"P1\">";
+    BOOST_CHECK(!scanner.scan(truncated.data(), truncated.size()));
+}
+
+BOOST_AUTO_TEST_CASE(parseParallel) {
+    const auto xml = partwiseDocument(12);
+    auto expected = parseBuffer(xml.data(), xml.size(), "parallel.xml");
+
+    ParseOptions options;
+    options.threads = 4;
+    auto score = parseBuffer(xml.data(), xml.size(), "parallel.xml", options);
+    BOOST_REQUIRE(score);
+    checkSameScore(*score, *expected);
+
+    options.useArena = true;
+    auto arenaScore = parseBuffer(xml.data(), xml.size(), "parallel.xml", options);
+    BOOST_REQUIRE(arenaScore);
+    BOOST_REQUIRE(arenaScore->arena());
+    checkSameScore(*arenaScore, *expected);
+
+    // Errors inside a part are reported like in the sequential path
+    auto broken = partwiseDocument(3);
+    broken.replace(broken.rfind("<step>C</step>"), 14, "<step>H</step>");
+    options.useArena = false;
+    BOOST_CHECK_THROW(parseBuffer(broken.data(), broken.size(), "broken.xml", options), dom::InvalidDataError);
+}
+
+BOOST_AUTO_TEST_CASE(parseParallelNamespaces) {
+    // Parts using a prefix declared on the root can't be parsed on their own
+    auto xml = partwiseDocument(3);
+    xml.replace(xml.find("<score-partwise>"), 16, "<score-partwise xmlns:xlink=\"http://www.w3.org/1999/xlink\">");
+    const std::string measure = "<measure number=\"1\">\n";
+    xml.insert(xml.find(measure) + measure.size(), "      <link xlink:href=\"other.xml\"/>\n");
+
+    PartScanner scanner;
+    BOOST_CHECK(!scanner.scan(xml.data(), xml.size()));
+
+    auto expected = parseBuffer(xml.data(), xml.size(), "namespaces.xml");
+    ParseOptions options;
+    options.threads = 4;
+    auto score = parseBuffer(xml.data(), xml.size(), "namespaces.xml", options);
+    BOOST_REQUIRE(score);
+    checkSameScore(*score, *expected);
+
+    // Attributes that only start like a declaration are fine
+    const std::string attribute = "<score-partwise version=\"3.0\" xmlnsx=\"1\">";
+    auto other = partwiseDocument(2);
+    other.replace(other.find("<score-partwise>"), 16, attribute);
+    BOOST_CHECK(scanner.scan(other.data(), other.size()));
+}
+
+BOOST_AUTO_TEST_CASE(arenaNodes) {
+    dom::Arena arena;
+    auto previous = dom::Arena::setCurrent(&arena);
+    std::unique_ptr<dom::Note> arenaNote(new dom::Note());
+    dom::Arena::setCurrent(previous);
+    std::unique_ptr<dom::Note> heapNote(new dom::Note());
+
+    BOOST_CHECK(arena.contains(arenaNote.get()));
+    BOOST_CHECK(!arena.contains(heapNote.get()));
+
+    // Deleting an arena node after the arena stopped being current leaves its memory alone
+    arenaNote.reset();
+    heapNote.reset();
+    BOOST_CHECK_GT(arena.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(streamMeasures) {
+    const auto xml = partwiseDocument(3);
+
+    struct Streamed {
+        std::size_t partIndex;
+        const dom::Measure* measure;
+        std::size_t measureIndex;
+        std::size_t nodeCount;
+        int divisions;
+    };
+    std::vector<Streamed> streamed;
+
+    ParseOptions options;
+    options.threads = 4;
+    options.measureSink = [&](std::size_t partIndex, const dom::Measure& measure, const MeasureAttributes& attributes) {
+        // The measure is complete when it is reported
+        streamed.push_back(Streamed{partIndex, &measure, measure.index(), measure.nodes().size(), attributes.divisions});
+    };
+    auto score = parseBuffer(xml.data(), xml.size(), "stream.xml", options);
+    BOOST_REQUIRE(score);
+
+    std::size_t index = 0;
+    for (auto& part : score->parts()) {
+        for (auto& measure : part->measures()) {
+            BOOST_REQUIRE_LT(index, streamed.size());
+            BOOST_CHECK_EQUAL(streamed[index].partIndex, part->index());
+            BOOST_CHECK(streamed[index].measure == measure.get());
+            BOOST_CHECK_EQUAL(streamed[index].measureIndex, measure->index());
+            BOOST_CHECK_EQUAL(streamed[index].nodeCount, measure->nodes().size());
+            BOOST_CHECK_EQUAL(streamed[index].divisions, 4);
+            index += 1;
+        }
+    }
+    BOOST_CHECK_EQUAL(index, streamed.size());
+}
+
+BOOST_AUTO_TEST_CASE(streamAttributes) {
+    static const char* kFileName = "moonlight.xml";
+
+    std::vector<int> staves;
+    std::vector<const dom::Clef*> clefs;
+    ParseOptions options;
+    options.measureSink = [&](std::size_t partIndex, const dom::Measure& measure, const MeasureAttributes& attributes) {
+        staves.push_back(attributes.staves);
+        clefs.push_back(attributes.clef(2));
+    };
+    auto score = parseFile(kFileName, options);
+    BOOST_REQUIRE(score);
+    BOOST_REQUIRE_EQUAL(staves.size(), score->parts().front()->measures().size());
+
+    // The first measure declares two staves and their clefs before its first note
+    BOOST_CHECK_EQUAL(staves.front(), 2);
+    BOOST_REQUIRE(clefs.front());
+    BOOST_CHECK(clefs.front()->sign().value() == dom::Clef::Sign::F);
+}
+
+BOOST_AUTO_TEST_CASE(parseCompressedFile) {
+    auto expected = parseFile("moonlight.xml");
+    auto score = parseFile("moonlight.mxl");
+    BOOST_REQUIRE(score);
+    checkSameScore(*score, *expected);
+
+    // Streaming works the same on compressed files
+    std::size_t measures = 0;
+    ParseOptions options;
+    options.measureSink = [&](std::size_t partIndex, const dom::Measure& measure, const MeasureAttributes& attributes) {
+        measures += 1;
+    };
+    parseFile("moonlight.mxl", options);
+    BOOST_CHECK_EQUAL(measures, expected->parts().front()->measures().size());
+}
+
+BOOST_AUTO_TEST_CASE(zipArchive) {
+    std::ifstream is("moonlight.mxl", std::ios::binary);
+    std::stringstream ss;
+    ss << is.rdbuf();
+    const auto contents = ss.str();
+
+    BOOST_REQUIRE(ZipArchive::isArchive(contents.data(), contents.size()));
+    ZipArchive archive(contents.data(), contents.size());
+    BOOST_CHECK_EQUAL(archive.entries().size(), 2);
+    BOOST_REQUIRE(archive.find("META-INF/container.xml"));
+    BOOST_CHECK(!archive.find("moonlight.pdf"));
+
+    auto entry = archive.find("moonlight.xml");
+    BOOST_REQUIRE(entry);
+    auto buffer = archive.open(*entry);
+    std::istream entryStream(buffer.get());
+    std::string xml((std::istreambuf_iterator<char>(entryStream)), std::istreambuf_iterator<char>());
+    BOOST_CHECK_EQUAL(xml.size(), entry->size);
+    BOOST_CHECK_EQUAL(xml.compare(0, 5, "<?xml"), 0);
+
+    // Corrupt compressed data fails the checksum or the inflate
+    auto corrupt = contents;
+    const auto dataOffset = entry->headerOffset + 30 + entry->name.size() + 4096;
+    for (std::size_t index = 0; index < 64; index += 1)
+        corrupt[dataOffset + index] = static_cast<char>(~corrupt[dataOffset + index]);
+    BOOST_CHECK_THROW(parseBuffer(corrupt.data(), corrupt.size(), "corrupt.mxl"), dom::InvalidDataError);
+
+    const std::string truncated = contents.substr(0, contents.size() / 2);
+    BOOST_CHECK_THROW(ZipArchive(truncated.data(), truncated.size()), dom::InvalidDataError);
+}
+
+BOOST_AUTO_TEST_CASE(parseTimewise) {
+    const auto partwise = partwiseDocument(3, 4);
+    const auto timewise = timewiseDocument(3, 4);
+    auto expected = parseBuffer(partwise.data(), partwise.size(), "partwise.xml");
+    auto score = parseBuffer(timewise.data(), timewise.size(), "timewise.xml");
+    BOOST_REQUIRE(score);
+    checkSameScore(*score, *expected);
+    BOOST_CHECK_EQUAL(score->parts()[1]->measures()[2]->number(), "3");
+
+    std::size_t streamed = 0;
+    ParseOptions options;
+    options.measureSink = [&](std::size_t partIndex, const dom::Measure& measure, const MeasureAttributes& attributes) {
+        BOOST_CHECK_LT(partIndex, 3);
+        BOOST_CHECK_EQUAL(measure.index(), streamed / 3);
+        BOOST_CHECK_EQUAL(attributes.divisions, 4);
+        streamed += 1;
+    };
+    parseBuffer(timewise.data(), timewise.size(), "timewise.xml", options);
+    BOOST_CHECK_EQUAL(streamed, 12);
+}
+
+BOOST_AUTO_TEST_CASE(parseTimewiseMissingParts) {
+    // P2 only plays in the second measure
+    const std::string xml =
+        "<score-timewise>\n"
+        "  <measure number=\"1\"><part id=\"P1\">" + measureContents(1, 1) + "</part></measure>\n"
+        "  <measure number=\"2\"><part id=\"P2\">" + measureContents(2, 2) + "</part><part id=\"P1\">" + measureContents(1, 2) + "</part></measure>\n"
+        "  <measure number=\"3\"><part id=\"P1\">" + measureContents(1, 3) + "</part></measure>\n"
+        "</score-timewise>\n";
+    auto score = parseBuffer(xml.data(), xml.size(), "timewise.xml");
+    BOOST_REQUIRE(score);
+    BOOST_REQUIRE_EQUAL(score->parts().size(), 2);
+    BOOST_CHECK_EQUAL(score->parts()[0]->id(), "P1");
+    BOOST_CHECK_EQUAL(score->parts()[1]->id(), "P2");
+
+    for (auto& part : score->parts()) {
+        BOOST_REQUIRE_EQUAL(part->measures().size(), 3);
+        for (std::size_t index = 0; index < 3; index += 1) {
+            BOOST_CHECK_EQUAL(part->measures()[index]->index(), index);
+            BOOST_CHECK_EQUAL(part->measures()[index]->number(), std::to_string(index + 1));
+        }
+    }
+
+    // Measures where a part is missing get a whole rest like empty partwise measures
+    auto& silent = *score->parts()[1]->measures()[0];
+    BOOST_REQUIRE_EQUAL(silent.nodes().size(), 1);
+    BOOST_CHECK(silent.nodes().front()->kind() == dom::Node::Kind::Note);
+    BOOST_CHECK_EQUAL(score->parts()[1]->measures()[1]->nodes().size(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(genericTree) {
+    const std::string xml =
+        "<part-name-display print-object=\"yes\">\n"
+        "  <display-text default-x=\"12\" justify=\"center\">Piano</display-text>\n"
+        "  <accidental-text>flat</accidental-text>\n"
+        "  <display-text><sub>1</sub></display-text>\n"
+        "</part-name-display>\n";
+    GenericNodeHandler handler;
+    lxml::parse(xml.data(), xml.size(), "generic.xml", handler);
+    auto tree = handler.result();
+    BOOST_REQUIRE(tree);
+    BOOST_CHECK_EQUAL(tree->size(), 5);
+
+    auto& root = tree->root();
+    BOOST_CHECK_EQUAL(root.name(), "part-name-display");
+    BOOST_CHECK_EQUAL(root.attribute("print-object"), "yes");
+    BOOST_CHECK(!root.hasAttribute("default-x"));
+    BOOST_CHECK(!root.attribute("default-x"));
+    BOOST_CHECK_EQUAL(root.childCount(), 3);
+
+    auto text = root.child("display-text");
+    BOOST_REQUIRE(text);
+    BOOST_CHECK_EQUAL(text->text(), "Piano");
+    BOOST_CHECK(text->hasAttribute("justify"));
+    BOOST_CHECK_EQUAL(text->attribute("default-x"), "12");
+    BOOST_CHECK(!text->firstChild());
+
+    auto accidental = text->nextSibling();
+    BOOST_REQUIRE(accidental);
+    BOOST_CHECK_EQUAL(accidental->name(), "accidental-text");
+    BOOST_CHECK_EQUAL(accidental->text(), "flat");
+
+    auto last = accidental->nextSibling();
+    BOOST_REQUIRE(last);
+    BOOST_CHECK_EQUAL(last->child("sub")->text(), "1");
+    BOOST_CHECK(!last->nextSibling());
+    BOOST_CHECK(!root.child("sub"));
+}
+
+BOOST_AUTO_TEST_CASE(genericTreeAfterAbortedParse) {
+    GenericNodeHandler handler;
+
+    // A document that stops inside the subtree leaves its elements open, whether or not the parser throws
+    const std::string truncated = "<credit><credit-words>Piano";
+    try {
+        lxml::parse(truncated.data(), truncated.size(), "truncated.xml", handler);
+    } catch (...) {
+    }
+
+    const std::string xml = "<display-text justify=\"center\">Piano</display-text>";
+    lxml::parse(xml.data(), xml.size(), "generic.xml", handler);
+    auto tree = handler.result();
+    BOOST_REQUIRE(tree);
+    BOOST_CHECK_EQUAL(tree->size(), 1);
+    BOOST_CHECK_EQUAL(tree->root().name(), "display-text");
+    BOOST_CHECK_EQUAL(tree->root().text(), "Piano");
+}
+
+BOOST_AUTO_TEST_CASE(parsePartNameDisplay) {
+    auto xml = partwiseDocument(1, 1);
+    const std::string print =
+        "<print><part-name-display><display-text default-x=\"-4\">Violin</display-text></part-name-display></print>";
+    xml.insert(xml.find("<attributes>"), print);
+
+    auto score = parseBuffer(xml.data(), xml.size(), "print.xml");
+    BOOST_REQUIRE(score);
+    auto& node = score->parts()[0]->measures()[0]->nodes().front();
+    BOOST_REQUIRE(node->kind() == dom::Node::Kind::Print);
+    auto& display = static_cast<const dom::Print&>(*node).partNameDisplay;
+    BOOST_REQUIRE(display.isPresent());
+    BOOST_CHECK_EQUAL(display.value().string, "Violin");
+    BOOST_CHECK_EQUAL(display.value().position.defaultX.value(), -4);
+}
+
+BOOST_AUTO_TEST_CASE(internedStrings) {
+    auto score = parseFile("moonlight.xml");
+    BOOST_REQUIRE(score->strings());
+
+    // Every note in the same voice refers to the same string
+    std::map<std::string, const std::string*> voices;
+    std::size_t handles = 0;
+    for (auto& part : score->parts()) {
+        handles += 1;
+        for (auto& measure : part->measures()) {
+            handles += 1;
+            for (auto& node : measure->nodes()) {
+                if (node->kind() != dom::Node::Kind::Chord)
+                    continue;
+                for (auto& note : static_cast<const dom::Chord&>(*node).notes()) {
+                    auto& voice = note->voice();
+                    auto it = voices.emplace(voice, &voice).first;
+                    BOOST_CHECK(it->second == &voice);
+                    handles += 1;
+                }
+            }
+        }
+    }
+    BOOST_CHECK_EQUAL(score->parts()[0]->id(), "P1");
+    BOOST_CHECK_EQUAL(score->parts()[0]->measures()[1]->number(), "2");
+    BOOST_CHECK(voices.size() <= score->strings()->size());
+
+    const auto separate = handles * sizeof(std::string);
+    const auto interned = handles * sizeof(dom::InternedString) + score->strings()->size() * sizeof(std::string);
+    BOOST_TEST_MESSAGE("Interned " << handles << " strings into " << score->strings()->size() << ", saving " << separate - interned << " bytes");
+    BOOST_CHECK_LT(interned, separate);
+
+    // Strings interned by the workers of a parallel parse live as long as the score
+    ParseOptions options;
+    options.threads = 2;
+    auto parallel = parseFile("moonlight.xml", options);
+    BOOST_CHECK_GE(parallel->strings()->size(), score->strings()->size());
+    checkSameScore(*parallel, *score);
+}
+
+BOOST_AUTO_TEST_CASE(internedStringsOutsideParse) {
+    BOOST_REQUIRE(dom::StringTable::current() == nullptr);
+
+    // Without a current table the handle owns its string
+    dom::Note note;
+    note.setVoice("1");
+    dom::Lyric lyric;
+    lyric.setText("Ah");
+    BOOST_CHECK_EQUAL(note.voice(), "1");
+    BOOST_CHECK_EQUAL(lyric.text(), "Ah");
+    dom::InternedString text("Ah");
+    BOOST_CHECK(!text.interned());
+
+    // Scores made with a builder intern in their own table
+    std::unique_ptr<dom::Score> score;
+    {
+        ScoreBuilder builder;
+        auto part = builder.addPart();
+        auto measure = builder.addMeasure(part);
+        measure->setNumber("12");
+        builder.addNote(measure)->setVoice("2");
+        score = builder.build();
+    }
+    BOOST_CHECK(dom::StringTable::current() == nullptr);
+    BOOST_CHECK_EQUAL(score->strings()->size(), 2);
+    BOOST_CHECK_EQUAL(score->parts()[0]->measures()[0]->number(), "12");
+
+    // A copy doesn't depend on the table of the original
+    std::unique_ptr<dom::InternedString> copy;
+    {
+        auto table = std::make_shared<dom::StringTable>();
+        auto previous = dom::StringTable::setCurrent(table.get());
+        dom::InternedString original("Fine");
+        dom::StringTable::setCurrent(previous);
+        BOOST_CHECK(original.interned());
+        copy.reset(new dom::InternedString(original));
+    }
+    BOOST_CHECK(!copy->interned());
+    BOOST_CHECK_EQUAL(copy->str(), "Fine");
+}
+
+BOOST_AUTO_TEST_CASE(parseNumbers) {
+    BOOST_CHECK_EQUAL(parseInteger("16"), 16);
+    BOOST_CHECK_EQUAL(parseInteger("  -3"), -3);
+    BOOST_CHECK_EQUAL(parseInteger("+7 "), 7);
+    BOOST_CHECK_EQUAL(parseInteger("4.0"), 4);
+    BOOST_CHECK_EQUAL(parseInteger("x"), 0);
+    BOOST_CHECK_EQUAL(parseInteger(""), 0);
+    BOOST_CHECK_EQUAL(parseInteger("99999999999"), std::numeric_limits<int>::max());
+    BOOST_CHECK_EQUAL(parseInteger("-99999999999"), std::numeric_limits<int>::min());
+
+    const std::string range = "12.5abc";
+    BOOST_CHECK_EQUAL(parseDouble(range.data(), range.data() + 3), 12.0);
+    BOOST_CHECK_EQUAL(parseDouble(range), 12.5);
+    BOOST_CHECK_EQUAL(parseDouble("-.25"), -0.25);
+    BOOST_CHECK_EQUAL(parseDouble("1e3"), 1000.0);
+    BOOST_CHECK_EQUAL(parseDouble("2.5E-2"), 0.025);
+    BOOST_CHECK_EQUAL(parseDouble("7e"), 7.0);
+    BOOST_CHECK_EQUAL(parseDouble("."), 0.0);
+    BOOST_CHECK_EQUAL(parseDouble("12345678901234567890123"), 12345678901234567890123.0);
+    BOOST_CHECK_EQUAL(parseDouble("0.1000000000000000055511151231257827"), 0.1);
+
+    // Same results as strtod in the C locale
+    for (int i = -20000; i <= 20000; i += 7) {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%d.%02d", i / 100, std::abs(i % 100));
+        BOOST_CHECK_EQUAL(parseDouble(buffer), std::strtod(buffer, nullptr));
+    }
+
+    // A locale with a decimal comma doesn't change how MusicXML numbers are read
+    const std::string previous = std::setlocale(LC_NUMERIC, nullptr);
+    if (std::setlocale(LC_NUMERIC, "de_DE.UTF-8")) {
+        BOOST_CHECK_EQUAL(parseDouble("112.73"), 112.73);
+        std::setlocale(LC_NUMERIC, previous.c_str());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(scoreSnapshot) {
+    auto expected = parseFile("moonlight.xml");
+
+    std::ostringstream os;
+    writeSnapshot(*expected, os);
+    const auto snapshot = os.str();
+    BOOST_REQUIRE(isSnapshot(snapshot.data(), snapshot.size()));
+
+    auto score = parseBuffer(snapshot.data(), snapshot.size(), "moonlight.snapshot");
+    BOOST_REQUIRE(score);
+    checkSameScore(*score, *expected);
+    for (auto& measure : score->parts().front()->measures()) {
+        for (auto& node : measure->nodes()) {
+            if (node->kind() != dom::Node::Kind::Chord)
+                continue;
+            for (auto& note : static_cast<const dom::Chord&>(*node).notes())
+                BOOST_CHECK(note->measure() == measure.get());
+        }
+    }
+
+    // The snapshot holds every field, writing the loaded score again gives the same bytes
+    std::ostringstream reloaded;
+    writeSnapshot(*score, reloaded);
+    BOOST_CHECK(reloaded.str() == snapshot);
+
+    ParseOptions options;
+    options.useArena = true;
+    auto arenaScore = parseBuffer(snapshot.data(), snapshot.size(), "moonlight.snapshot", options);
+    BOOST_REQUIRE(arenaScore->arena());
+    checkSameScore(*arenaScore, *expected);
+
+    BOOST_CHECK_THROW(readSnapshot(snapshot.data(), snapshot.size() - 1), dom::InvalidDataError);
+    auto newer = snapshot;
+    newer[8] += 1;
+    BOOST_CHECK_THROW(readSnapshot(newer.data(), newer.size()), dom::InvalidDataError);
+}
@@ -6,6 +6,7 @@
 
 #include <mxml/ScoreBuilder.h>
 #include <mxml/dom/Chord.h>
+#include <mxml/dom/OctaveShift.h>
 #include <mxml/ScoreProperties.h>
 #include <mxml/StreamOperators.h>
 #include <boost/test/unit_test.hpp>
@@ -265,3 +266,208 @@ BOOST_AUTO_TEST_CASE(clefSignaturesOnlyFirstStaff) {
     BOOST_CHECK(proeprties.clef(0, 1, 1, 0)->sign() == dom::Clef::Sign::F);
     BOOST_CHECK(proeprties.clef(0, 1, 2, 0)->sign() == dom::Clef::Sign::F);
 }
+
+BOOST_AUTO_TEST_CASE(tempoMap) {
+    ScoreBuilder builder;
+    auto part = builder.addPart();
+
+    // Two 4/4 measures with one division per beat
+    auto measure1 = builder.addMeasure(part);
+    auto attributes1 = builder.addAttributes(measure1);
+    attributes1->setDivisions(dom::presentOptional(1));
+    auto time = builder.setTime(attributes1);
+    time->setBeats(4);
+    time->setBeatType(4);
+    auto measure2 = builder.addMeasure(part);
+
+    // 120 bpm from the start, 60 bpm from the third beat of the second measure
+    auto direction1 = builder.addDirection(measure1, 0);
+    builder.setSound(direction1)->tempo = dom::presentOptional(120.0f);
+    auto direction2 = builder.addDirection(measure2, 2);
+    builder.setSound(direction2)->tempo = dom::presentOptional(60.0f);
+
+    auto score = builder.build();
+    ScoreProperties properties(*score, ScoreProperties::LayoutType::Scroll);
+
+    BOOST_CHECK_EQUAL(properties.tempo(0, 0), 120);
+    BOOST_CHECK_EQUAL(properties.tempo(1, 1), 120);
+    BOOST_CHECK_EQUAL(properties.tempo(1, 2), 60);
+    BOOST_CHECK_EQUAL(properties.tempo(5, 0), 60);
+
+    auto& tempoMap = properties.tempoMap();
+    BOOST_CHECK_CLOSE(tempoMap.seconds(0, 0), 0.0, 0.01);
+    BOOST_CHECK_CLOSE(tempoMap.seconds(1, 0), 2.0, 0.01);
+    BOOST_CHECK_CLOSE(tempoMap.seconds(1, 2), 3.0, 0.01);
+    BOOST_CHECK_CLOSE(tempoMap.seconds(1, 3), 4.0, 0.01);
+
+    auto location = tempoMap.location(3.5);
+    BOOST_CHECK_EQUAL(location.measureIndex, 1);
+    BOOST_CHECK_EQUAL(location.division, 2);
+
+    location = tempoMap.location(1.0);
+    BOOST_CHECK_EQUAL(location.measureIndex, 0);
+    BOOST_CHECK_EQUAL(location.division, 2);
+}
+
+BOOST_AUTO_TEST_CASE(dynamicsIndex) {
+    ScoreBuilder builder;
+    auto part = builder.addPart();
+
+    auto measure1 = builder.addMeasure(part);
+    auto attributes1 = builder.addAttributes(measure1);
+    attributes1->setStaves(dom::presentOptional(2));
+    auto measure2 = builder.addMeasure(part);
+
+    // Applies to both staves
+    auto direction1 = builder.addDirection(measure1, 0);
+    builder.setSound(direction1)->dynamics = dom::presentOptional(80.0f);
+
+    // Only applies to the second staff
+    auto direction2 = builder.addDirection(measure2, 1);
+    direction2->setStaff(dom::presentOptional(2));
+    builder.setSound(direction2)->dynamics = dom::presentOptional(40.0f);
+
+    auto note1 = builder.addNote(measure1, dom::Note::Type::Quarter, 0);
+    note1->setStaff(1);
+    auto note2 = builder.addNote(measure2, dom::Note::Type::Quarter, 0);
+    note2->setStaff(2);
+    auto note3 = builder.addNote(measure2, dom::Note::Type::Quarter, 1);
+    note3->setStaff(2);
+    auto note4 = builder.addNote(measure2, dom::Note::Type::Quarter, 1);
+    note4->setStaff(1);
+
+    auto score = builder.build();
+    ScoreProperties properties(*score, ScoreProperties::LayoutType::Scroll);
+
+    BOOST_CHECK_EQUAL(properties.dynamics(*note1), 80);
+    BOOST_CHECK_EQUAL(properties.dynamics(*note2), 80);
+    BOOST_CHECK_EQUAL(properties.dynamics(*note3), 40);
+    BOOST_CHECK_EQUAL(properties.dynamics(*note4), 80);
+
+    // The batch API should agree with the single note lookups
+    std::size_t count = 0;
+    properties.dynamics(*score->parts().front(), 0, 2, [&](const dom::Note& note, float dynamics) {
+        BOOST_CHECK_EQUAL(dynamics, properties.dynamics(note));
+        count += 1;
+    });
+    BOOST_CHECK_EQUAL(count, 4);
+}
+
+BOOST_AUTO_TEST_CASE(octaveShifts) {
+    ScoreBuilder builder;
+    auto part = builder.addPart();
+
+    auto measure1 = builder.addMeasure(part);
+    auto attributes1 = builder.addAttributes(measure1);
+    attributes1->setStaves(dom::presentOptional(2));
+    auto measure2 = builder.addMeasure(part);
+
+    // 8va on the first staff from the second beat of the first measure to the second beat of the second measure
+    auto start = builder.addDirection(measure1, 1);
+    start->setStaff(dom::presentOptional(1));
+    auto startShift = std::unique_ptr<dom::OctaveShift>(new dom::OctaveShift{});
+    startShift->type = dom::OctaveShift::Type::Down;
+    startShift->size = 8;
+    start->setType(std::move(startShift));
+
+    auto stop = builder.addDirection(measure2, 1);
+    stop->setStaff(dom::presentOptional(1));
+    auto stopShift = std::unique_ptr<dom::OctaveShift>(new dom::OctaveShift{});
+    stopShift->type = dom::OctaveShift::Type::Stop;
+    stopShift->size = 8;
+    stop->setType(std::move(stopShift));
+
+    auto note1 = builder.addNote(measure2, dom::Note::Type::Quarter, 0);
+    note1->setStaff(1);
+    auto note2 = builder.addNote(measure2, dom::Note::Type::Quarter, 0);
+    note2->setStaff(2);
+    auto note3 = builder.addNote(measure2, dom::Note::Type::Quarter, 1);
+    note3->setStaff(1);
+
+    auto score = builder.build();
+    ScoreProperties properties(*score, ScoreProperties::LayoutType::Scroll);
+
+    BOOST_CHECK_EQUAL(properties.octaveShift(0, 0, 1, 0), 0);
+    BOOST_CHECK_EQUAL(properties.octaveShift(0, 0, 1, 1), -7);
+    BOOST_CHECK_EQUAL(properties.octaveShift(0, 0, 2, 1), 0);
+    BOOST_CHECK_EQUAL(properties.octaveShift(0, 1, 1, 0), -7);
+    BOOST_CHECK_EQUAL(properties.octaveShift(0, 1, 1, 1), 0);
+
+    auto shifts = properties.octaveShifts(*measure2);
+    BOOST_REQUIRE_EQUAL(shifts.size(), 3);
+    BOOST_CHECK_EQUAL(shifts[0], -7);
+    BOOST_CHECK_EQUAL(shifts[1], 0);
+    BOOST_CHECK_EQUAL(shifts[2], 0);
+}
+
+BOOST_AUTO_TEST_CASE(clefSignaturesMultiplePart) {
+    ScoreBuilder builder;
+    auto part1 = builder.addPart();
+    auto part2 = builder.addPart();
+
+    // The first part changes clef every measure, the second part never does
+    for (int measureIndex = 0; measureIndex < 4; measureIndex += 1) {
+        auto measure1 = builder.addMeasure(part1);
+        auto attributes1 = builder.addAttributes(measure1);
+        if (measureIndex % 2 == 0)
+            builder.setTrebleClef(attributes1, 1);
+        else
+            builder.setBassClef(attributes1, 1);
+
+        auto measure2 = builder.addMeasure(part2);
+        if (measureIndex == 0) {
+            auto attributes2 = builder.addAttributes(measure2);
+            attributes2->setStaves({2, true});
+            builder.setBassClef(attributes2, 2);
+        }
+    }
+
+    auto score = builder.build();
+    ScoreProperties properties(*score, ScoreProperties::LayoutType::Scroll);
+
+    BOOST_CHECK(properties.clef(0, 0, 1, 0)->sign() == dom::Clef::Sign::G);
+    BOOST_CHECK(properties.clef(0, 1, 1, 0)->sign() == dom::Clef::Sign::F);
+    BOOST_CHECK(properties.clef(0, 3, 1, 0)->sign() == dom::Clef::Sign::F);
+
+    // The second part only has a clef for its second staff
+    BOOST_CHECK(properties.clef(1, 3, 1, 0) == nullptr);
+    BOOST_CHECK(properties.clef(1, 3, 2, 0)->sign() == dom::Clef::Sign::F);
+    BOOST_CHECK(properties.clef(1, 3, 3, 0) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(altersSeparateLines) {
+    ScoreBuilder builder;
+    auto part = builder.addPart();
+    auto measure = builder.addMeasure(part);
+    auto attributes = builder.addAttributes(measure);
+    attributes->setStaves({2, true});
+    builder.setTrebleClef(attributes, 1);
+    builder.setBassClef(attributes, 2);
+    builder.setKey(attributes, 1);
+
+    // C#4 on the first staff
+    auto sharp = builder.addNote(measure, dom::Note::Type::Eighth, 0);
+    sharp->setStaff(1);
+    builder.setPitch(sharp, dom::Pitch::Step::C, 4, 1);
+
+    // Later Cs in other octaves or staves are not affected by the sharp
+    auto otherOctave = builder.addNote(measure, dom::Note::Type::Eighth, 1);
+    otherOctave->setStaff(1);
+    builder.setPitch(otherOctave, dom::Pitch::Step::C, 5);
+
+    auto otherStaff = builder.addNote(measure, dom::Note::Type::Eighth, 1);
+    otherStaff->setStaff(2);
+    builder.setPitch(otherStaff, dom::Pitch::Step::C, 4);
+
+    auto sameLine = builder.addNote(measure, dom::Note::Type::Eighth, 2);
+    sameLine->setStaff(1);
+    builder.setPitch(sameLine, dom::Pitch::Step::C, 4, 1);
+
+    auto score = builder.build();
+    ScoreProperties properties(*score, ScoreProperties::LayoutType::Scroll);
+
+    BOOST_CHECK_EQUAL(properties.alter(*sharp), 0);
+    BOOST_CHECK_EQUAL(properties.alter(*otherOctave), 0);
+    BOOST_CHECK_EQUAL(properties.alter(*otherStaff), 0);
+    BOOST_CHECK_EQUAL(properties.alter(*sameLine), 1);
+}